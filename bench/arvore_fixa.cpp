@@ -0,0 +1,187 @@
+// Módulos C++
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+// Nossos módulos
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisFixa.hpp"
+
+/**
+ * @brief Benchmark bench_arvore_fixa: BPlusTree (ordem em tempo de execução) x BPlusTreeFixa.
+ *
+ * Para páginas de 4K, 8K e 16K constrói uma BPlusTree<int> com N IDs em ordem aleatória,
+ * e mede buscas pontuais aleatórias e uma varredura completa pelo cursor com as duas
+ * variantes sobre o mesmo arquivo (em cache do S.O.), conferindo que os resultados são iguais.
+ *
+ * Uso: bench_arvore_fixa [N] [--consultas Q] [--dir D]
+ */
+
+using Relogio = std::chrono::steady_clock;
+
+struct Medida {
+
+    double ns_busca;
+    double ns_chave_varredura;
+    long soma;
+
+};
+
+template <typename Arvore>
+static Medida medir(Arvore& arvore, const std::vector<int>& consultas) {
+
+    Medida m;
+    m.soma = 0;
+
+    auto inicio = Relogio::now();
+
+    for (int chave : consultas) {
+
+        std::vector<long> r = arvore.search(chave);
+        m.soma += r.empty() ? -1 : r[0];
+
+    }
+
+    m.ns_busca = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count() / consultas.size();
+
+    long chaves = 0;
+    inicio = Relogio::now();
+
+    for (auto cursor = arvore.lowerBound(0); cursor.valido(); cursor.next()) {
+
+        m.soma += cursor.apontador();
+        chaves++;
+
+    }
+
+    m.ns_chave_varredura = std::chrono::duration<double, std::nano>(Relogio::now() - inicio).count() / std::max<long>(chaves, 1);
+
+    return m;
+
+}
+
+template <size_t TamanhoPagina>
+static void executar(const std::string& diretorio, const std::vector<int>& chaves, const std::vector<int>& consultas) {
+
+    const std::string caminho = diretorio + "/bench_arvore_fixa_" + std::to_string(getpid()) + "_" + std::to_string(TamanhoPagina) + ".idx";
+    std::remove(caminho.c_str());
+
+    {
+
+        BPlusTree<int> construcao(caminho, TamanhoPagina);
+
+        for (int chave : chaves) {
+
+            construcao.insert(chave, chave);
+
+        }
+
+        construcao.flush();
+
+    }
+
+    BPlusTree<int> dinamica(caminho, TamanhoPagina);
+    BPlusTreeFixa<int, TamanhoPagina> fixa(caminho);
+
+    // Uma passada de aquecimento para trazer o arquivo ao cache do S.O.
+    medir(fixa, consultas);
+
+    Medida md = medir(dinamica, consultas);
+    Medida mf = medir(fixa, consultas);
+
+    if (md.soma != mf.soma) {
+
+        std::cerr << "Erro: resultados diferentes entre as variantes (pagina " << TamanhoPagina << ")" << std::endl;
+        std::exit(1);
+
+    }
+
+    std::cout << std::setw(8) << TamanhoPagina << std::setw(8) << fixa.getOrdem()
+              << std::fixed << std::setprecision(1)
+              << std::setw(14) << md.ns_busca << std::setw(14) << mf.ns_busca
+              << std::setw(10) << (md.ns_busca / mf.ns_busca) << "x"
+              << std::setw(14) << md.ns_chave_varredura << std::setw(14) << mf.ns_chave_varredura
+              << std::setw(10) << (md.ns_chave_varredura / mf.ns_chave_varredura) << "x" << std::endl;
+
+    std::remove(caminho.c_str());
+
+}
+
+int main(int argc, char* argv[]) {
+
+    long n = 1000000;
+    long q = 200000;
+    std::string diretorio = "/tmp";
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg == "--consultas" && i + 1 < argc) {
+
+            q = std::atol(argv[++i]);
+
+        }
+
+        else if (arg == "--dir" && i + 1 < argc) {
+
+            diretorio = argv[++i];
+
+        }
+
+        else {
+
+            n = std::atol(argv[i]);
+
+        }
+
+    }
+
+    if (n <= 0 || q <= 0) {
+
+        std::cerr << "Uso: " << argv[0] << " [N] [--consultas Q] [--dir D]" << std::endl;
+        return 1;
+
+    }
+
+    std::mt19937 gerador(42);
+
+    std::vector<int> chaves(n);
+
+    for (long i = 0; i < n; ++i) {
+
+        chaves[i] = static_cast<int>(i + 1);
+
+    }
+
+    std::shuffle(chaves.begin(), chaves.end(), gerador);
+
+    // Consultas uniformes sobre [1, 2N]: metade encontra a chave, metade não
+    std::uniform_int_distribution<int> distribuicao(1, static_cast<int>(2 * n));
+    std::vector<int> consultas(q);
+
+    for (long i = 0; i < q; ++i) {
+
+        consultas[i] = distribuicao(gerador);
+
+    }
+
+    std::cout << "BPlusTree<int> x BPlusTreeFixa<int, P>: " << n << " chaves, " << q << " buscas" << std::endl;
+    std::cout << std::setw(8) << "pagina" << std::setw(8) << "ordem"
+              << std::setw(14) << "busca din(ns)" << std::setw(14) << "busca fixa" << std::setw(11) << "ganho"
+              << std::setw(14) << "varr din(ns)" << std::setw(14) << "varr fixa" << std::setw(11) << "ganho" << std::endl;
+
+    executar<4096>(diretorio, chaves, consultas);
+    executar<8192>(diretorio, chaves, consultas);
+    executar<16384>(diretorio, chaves, consultas);
+
+    return 0;
+
+}
@@ -0,0 +1,502 @@
+// Módulos C++
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+
+// Sistema
+#include <fcntl.h>
+#include <unistd.h>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "config.hpp"
+#include "Parser.hpp"
+#include "OSInfo.hpp"
+#include "BlocoDeDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "ArquivoHashEstatico.hpp"
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisFixa.hpp"
+#include "IndiceTitulo.hpp"
+#include "Consultas.hpp"
+#include "Lote.hpp"
+#include "GeradorCSV.hpp"
+
+/**
+ * @brief Benchmark bench_carga: carga completa e buscas pontuais pelos três caminhos.
+ *
+ * 1. Lê o CSV para a memória (até N linhas) e mede a carga como o upload faz: parse de
+ *    cada linha, inserção no hash, no índice primário e no índice de títulos (modo compacto),
+ *    com os mesmos checkpoints. Relata linhas/s e MB/s de CSV (a alocação inicial dos
+ *    buckets primários é medida à parte).
+ * 2. Reabre o banco e mede Q buscas pontuais de IDs e títulos sorteados do próprio CSV
+ *    pelo hash (findrec), pelo índice primário (seek1) e pelo índice de títulos (seek2),
+ *    com o cache "frio" (páginas dos arquivos descartadas com posix_fadvise DONTNEED antes
+ *    de reabrir; só funciona para páginas limpas, então é um frio aproximado) e "quente"
+ *    (logo depois de uma passada completa). Relata média, p50, p95, p99 e máximo por busca.
+ *
+ * Com --gerar N o CSV não é lido do disco: N linhas sintéticas saem do GeradorCSV (IDs em
+ * ordem embaralhada, semente --seed), o que permite medir escalas maiores que o conjunto real.
+ *
+ * O resultado sai em JSON (na saída padrão ou em --json arquivo), para comparar versões.
+ *
+ * Uso: bench_carga <arquivo.csv | --gerar N> [--linhas N] [--consultas Q] [--seed S] [--dir D] [--json arquivo]
+ */
+
+using Relogio = std::chrono::steady_clock;
+
+struct EstatisticaBuscas {
+
+    std::string caminho;
+    std::string cache;
+    long consultas = 0;
+    long encontradas = 0;
+    double blocos_por_consulta = 0.0;
+    double media_ns = 0.0;
+    long p50_ns = 0;
+    long p95_ns = 0;
+    long p99_ns = 0;
+    long max_ns = 0;
+
+};
+
+// Executa consulta(i) para i em [0, total), medindo cada chamada.
+static EstatisticaBuscas medirBuscas(const std::string& caminho, const std::string& cache, size_t total, const std::function<ResultadoConsulta(size_t)>& consulta) {
+
+    EstatisticaBuscas e;
+    e.caminho = caminho;
+    e.cache = cache;
+    e.consultas = static_cast<long>(total);
+
+    std::vector<long> latencias(total);
+    long blocos = 0;
+    double soma = 0.0;
+
+    for (size_t i = 0; i < total; ++i) {
+
+        auto t0 = Relogio::now();
+
+        ResultadoConsulta r = consulta(i);
+
+        latencias[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(Relogio::now() - t0).count();
+
+        soma += latencias[i];
+        blocos += r.blocos_indice + r.blocos_dados;
+        e.encontradas += r.registros.empty() ? 0 : 1;
+
+    }
+
+    std::sort(latencias.begin(), latencias.end());
+
+    e.media_ns = total ? soma / total : 0.0;
+    e.blocos_por_consulta = total ? static_cast<double>(blocos) / total : 0.0;
+    e.p50_ns = percentil(latencias, 50);
+    e.p95_ns = percentil(latencias, 95);
+    e.p99_ns = percentil(latencias, 99);
+    e.max_ns = latencias.empty() ? 0 : latencias.back();
+
+    return e;
+
+}
+
+// Descarta do page cache as páginas (limpas) de um arquivo.
+static void descartarCache(const std::string& caminho) {
+
+    int fd = open(caminho.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+
+        return;
+
+    }
+
+    fdatasync(fd);
+    posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+
+}
+
+// Escreve uma string JSON simples (os nomes usados aqui não precisam de escape).
+static std::string textoJSON(const std::string& texto) {
+
+    return "\"" + texto + "\"";
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+    log_redirect_stderr();
+
+    std::string caminho_csv;
+    long max_linhas = 0;
+    long gerar = 0;
+    long q = 100000;
+    unsigned semente = 42;
+    std::string diretorio = "/tmp/bench_carga";
+    std::string caminho_json;
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg == "--linhas" && i + 1 < argc) {
+
+            max_linhas = std::atol(argv[++i]);
+
+        }
+
+        else if (arg == "--gerar" && i + 1 < argc) {
+
+            gerar = std::atol(argv[++i]);
+
+        }
+
+        else if (arg == "--consultas" && i + 1 < argc) {
+
+            q = std::atol(argv[++i]);
+
+        }
+
+        else if (arg == "--seed" && i + 1 < argc) {
+
+            semente = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+
+        }
+
+        else if (arg == "--dir" && i + 1 < argc) {
+
+            diretorio = argv[++i];
+
+        }
+
+        else if (arg == "--json" && i + 1 < argc) {
+
+            caminho_json = argv[++i];
+
+        }
+
+        else if (caminho_csv.empty() && arg.rfind("--", 0) != 0) {
+
+            caminho_csv = arg;
+
+        }
+
+        else {
+
+            caminho_csv.clear();
+            gerar = 0;
+            break;
+
+        }
+
+    }
+
+    if (caminho_csv.empty() == (gerar <= 0) || q <= 0 || max_linhas < 0) {
+
+        std::cerr << "Uso: " << argv[0] << " <arquivo.csv | --gerar N> [--linhas N] [--consultas Q] [--seed S] [--dir D] [--json arquivo]" << std::endl;
+        return 1;
+
+    }
+
+    //#################################################################
+    // 1. Conjunto de dados em memória
+    //#################################################################
+
+    std::vector<std::string> linhas;
+    long bytes_csv = 0;
+
+    if (gerar > 0) {
+
+        ConfiguracaoGerador config;
+        config.linhas = (max_linhas > 0) ? std::min(gerar, max_linhas) : gerar;
+        config.semente = semente;
+        config.ordem = OrdemIds::EMBARALHADA;
+
+        GeradorCSV gerador(config);
+        std::string linha;
+
+        linhas.reserve(static_cast<size_t>(config.linhas));
+
+        while (gerador.proximaLinha(linha)) {
+
+            bytes_csv += static_cast<long>(linha.size()) + 1;
+            linhas.push_back(linha);
+
+        }
+
+        caminho_csv = "(gerado: " + std::to_string(config.linhas) + " linhas, semente " + std::to_string(semente) + ")";
+
+    }
+
+    else {
+
+        std::ifstream entrada(caminho_csv);
+
+        if (!entrada.is_open()) {
+
+            std::cerr << "Não foi possível abrir " << caminho_csv << std::endl;
+            return 1;
+
+        }
+
+        std::string linha;
+
+        while ((max_linhas == 0 || static_cast<long>(linhas.size()) < max_linhas) && std::getline(entrada, linha)) {
+
+            if (!linha.empty()) {
+
+                bytes_csv += static_cast<long>(linha.size()) + 1;
+                linhas.push_back(std::move(linha));
+
+            }
+
+        }
+
+    }
+
+    std::filesystem::create_directories(diretorio);
+
+    const std::string caminho_dados = diretorio + "/artigos.dat";
+    const std::string caminho_id = diretorio + "/btree_id.idx";
+    const std::string caminho_titulo = diretorio + "/btree_titulo.idx";
+
+    std::remove(caminho_dados.c_str());
+    std::remove(caminho_id.c_str());
+    std::remove(caminho_titulo.c_str());
+
+    int tamanho_bloco_os = obter_tamanho_bloco_fs(diretorio.c_str());
+
+    if (tamanho_bloco_os <= 0) {
+
+        tamanho_bloco_os = 4096;
+
+    }
+
+    const size_t TAMANHO_BLOCO_DADOS = calcular_bloco_logico(sizeof(BlocoDeDados), tamanho_bloco_os);
+    const size_t TAMANHO_BLOCO_BTREE = static_cast<size_t>(tamanho_bloco_os);
+
+    //#################################################################
+    // 2. Carga (mesmo caminho do upload)
+    //#################################################################
+
+    std::vector<int> ids;
+    std::vector<std::string> titulos;
+    long inseridas = 0;
+    long ignoradas = 0;
+    double segundos_inicializacao = 0.0;
+    double segundos_carga = 0.0;
+
+    std::cerr << "Carregando " << linhas.size() << " linhas de " << caminho_csv << " em " << diretorio << "..." << std::endl;
+
+    try {
+
+        GerenciadorArquivoDados dados(caminho_dados, TAMANHO_BLOCO_DADOS);
+        ArquivoHashEstatico arquivo_hash(dados, NUM_BUCKETS_PRIMARIOS);
+        BPlusTree<int> btree_id(caminho_id, TAMANHO_BLOCO_BTREE);
+        IndiceTitulo btree_titulo(caminho_titulo, TAMANHO_BLOCO_BTREE, ModoIndiceTitulo::COMPACTO);
+
+        // A alocação dos buckets primários não depende do número de linhas: medida à parte
+        auto inicio = Relogio::now();
+
+        arquivo_hash.inicializar();
+
+        segundos_inicializacao = std::chrono::duration<double>(Relogio::now() - inicio).count();
+        inicio = Relogio::now();
+
+        for (const std::string& linha : linhas) {
+
+            Artigo artigo;
+
+            if (!parseCSVLinha(linha, artigo)) {
+
+                ignoradas++;
+                continue;
+
+            }
+
+            size_t bloco = arquivo_hash.inserir(artigo);
+            btree_id.insert(artigo.id, bloco);
+            btree_titulo.insert(std::string(artigo.titulo), bloco);
+
+            ids.push_back(artigo.id);
+            titulos.emplace_back(artigo.titulo);
+
+            if (++inseridas % checkpoint_intervalo == 0) {
+
+                dados.flushCheckpoint();
+                btree_id.flush();
+                btree_titulo.flush();
+
+            }
+
+        }
+
+        dados.flushCheckpoint();
+        btree_id.flush();
+        btree_titulo.flush();
+
+        segundos_carga = std::chrono::duration<double>(Relogio::now() - inicio).count();
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro na carga: " << e.what() << std::endl;
+        return 1;
+
+    }
+
+    if (ids.empty()) {
+
+        std::cerr << "Nenhuma linha válida em " << caminho_csv << std::endl;
+        return 1;
+
+    }
+
+    //#################################################################
+    // 3. Buscas pontuais, frio e quente
+    //#################################################################
+
+    std::mt19937 gerador(semente);
+    std::uniform_int_distribution<size_t> sorteio(0, ids.size() - 1);
+    std::vector<int> ids_busca(q);
+    std::vector<std::string> titulos_busca(q);
+
+    for (long i = 0; i < q; ++i) {
+
+        ids_busca[i] = ids[sorteio(gerador)];
+        titulos_busca[i] = titulos[sorteio(gerador)];
+
+    }
+
+    std::vector<EstatisticaBuscas> medidas;
+
+    // Cada caminho roda com os arquivos reabertos: frio (cache descartado) e depois quente
+    auto medirCaminho = [&](const std::string& caminho, const std::vector<std::string>& arquivos, const std::function<void(const std::string&)>& rodada) {
+
+        for (const std::string& arquivo : arquivos) {
+
+            descartarCache(arquivo);
+
+        }
+
+        rodada("frio");
+        rodada("quente");
+
+        std::cerr << "  " << caminho << ": ok" << std::endl;
+
+    };
+
+    try {
+
+        medirCaminho("hash", {caminho_dados}, [&](const std::string& cache) {
+
+            GerenciadorArquivoDados dados(caminho_dados, TAMANHO_BLOCO_DADOS);
+            ArquivoHashEstatico arquivo_hash(dados, NUM_BUCKETS_PRIMARIOS);
+
+            medidas.push_back(medirBuscas("hash", cache, ids_busca.size(), [&](size_t i) { return consultarPorHash(arquivo_hash, ids_busca[i]); }));
+
+        });
+
+        medirCaminho("arvore_id", {caminho_dados, caminho_id}, [&](const std::string& cache) {
+
+            GerenciadorArquivoDados dados(caminho_dados, TAMANHO_BLOCO_DADOS);
+
+            abrirArvoreLeitura<int>(caminho_id, TAMANHO_BLOCO_BTREE, [&](auto& btree_id) {
+
+                medidas.push_back(medirBuscas("arvore_id", cache, ids_busca.size(), [&](size_t i) { return consultarPorId(btree_id, dados, ids_busca[i]); }));
+
+            });
+
+        });
+
+        medirCaminho("arvore_titulo", {caminho_dados, caminho_titulo}, [&](const std::string& cache) {
+
+            GerenciadorArquivoDados dados(caminho_dados, TAMANHO_BLOCO_DADOS);
+            IndiceTitulo btree_titulo(caminho_titulo, TAMANHO_BLOCO_BTREE, ModoIndiceTitulo::COMPACTO);
+
+            medidas.push_back(medirBuscas("arvore_titulo", cache, titulos_busca.size(), [&](size_t i) { return consultarPorTitulo(btree_titulo, dados, titulos_busca[i]); }));
+
+        });
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro nas buscas: " << e.what() << std::endl;
+        return 1;
+
+    }
+
+    //#################################################################
+    // 4. Relatório JSON
+    //#################################################################
+
+    std::ostringstream json;
+    char numero[64];
+
+    auto real = [&](double valor, int casas = 1) {
+
+        std::snprintf(numero, sizeof(numero), "%.*f", casas, valor);
+
+        return std::string(numero);
+
+    };
+
+    json << "{\n";
+    json << "  \"csv\": " << textoJSON(caminho_csv) << ",\n";
+    json << "  \"seed\": " << semente << ",\n";
+    json << "  \"tamanho_bloco_dados\": " << TAMANHO_BLOCO_DADOS << ",\n";
+    json << "  \"tamanho_bloco_btree\": " << TAMANHO_BLOCO_BTREE << ",\n";
+    json << "  \"carga\": {\"linhas\": " << linhas.size() << ", \"inseridas\": " << inseridas << ", \"ignoradas\": " << ignoradas
+         << ", \"bytes_csv\": " << bytes_csv << ", \"segundos_inicializacao\": " << real(segundos_inicializacao, 3) << ", \"segundos\": " << real(segundos_carga, 3)
+         << ", \"linhas_por_s\": " << real(segundos_carga > 0 ? linhas.size() / segundos_carga : 0.0)
+         << ", \"mb_por_s\": " << real(segundos_carga > 0 ? bytes_csv / 1e6 / segundos_carga : 0.0) << "},\n";
+    json << "  \"buscas\": [\n";
+
+    for (size_t i = 0; i < medidas.size(); ++i) {
+
+        const EstatisticaBuscas& m = medidas[i];
+
+        json << "    {\"caminho\": " << textoJSON(m.caminho) << ", \"cache\": " << textoJSON(m.cache)
+             << ", \"consultas\": " << m.consultas << ", \"encontradas\": " << m.encontradas
+             << ", \"blocos_por_consulta\": " << real(m.blocos_por_consulta)
+             << ", \"media_ns\": " << real(m.media_ns) << ", \"p50_ns\": " << m.p50_ns << ", \"p95_ns\": " << m.p95_ns
+             << ", \"p99_ns\": " << m.p99_ns << ", \"max_ns\": " << m.max_ns << "}" << (i + 1 < medidas.size() ? "," : "") << "\n";
+
+    }
+
+    json << "  ]\n}\n";
+
+    if (caminho_json.empty()) {
+
+        std::cout << json.str();
+
+    }
+
+    else {
+
+        std::ofstream saida(caminho_json);
+        saida << json.str();
+
+        std::cerr << "Resultado gravado em " << caminho_json << std::endl;
+
+    }
+
+    std::remove(caminho_dados.c_str());
+    std::remove(caminho_id.c_str());
+    std::remove(caminho_titulo.c_str());
+
+    return 0;
+
+}
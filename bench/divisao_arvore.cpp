@@ -0,0 +1,178 @@
+// Módulos C++
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <unistd.h>
+
+// Nossos módulos
+#include "ArvoreBMais.hpp"
+
+/**
+ * @brief Benchmark bench_divisao: ocupação e altura da BPlusTree<int> por política de divisão.
+ *
+ * Insere os IDs 1..N em ordem crescente (como nos CSVs) e em ordem aleatória, com a
+ * divisão ao meio (fator 0.5) e com a divisão à direita (fator informado), e reporta
+ * blocos do arquivo, folhas, ocupação média das folhas e altura de cada combinação.
+ *
+ * Uso: bench_divisao [N] [--bloco B] [--fator F] [--dir D]
+ */
+
+struct ResultadoBench {
+
+    std::string ordem;
+    double fator;
+    long totalBlocos;
+    EstatisticasArvore est;
+    long duracao_ms;
+
+};
+
+static ResultadoBench executar(const std::string& caminho, size_t tamanhoBloco, const std::vector<int>& chaves, const std::string& ordem, double fator) {
+
+    std::remove(caminho.c_str());
+
+    ResultadoBench r;
+    r.ordem = ordem;
+    r.fator = fator;
+
+    {
+
+        BPlusTree<int> arvore(caminho, tamanhoBloco);
+        arvore.setFatorDivisaoDireita(fator);
+
+        auto inicio = std::chrono::steady_clock::now();
+
+        for (int chave : chaves) {
+
+            arvore.insert(chave, chave);
+
+        }
+
+        arvore.flush();
+
+        r.duracao_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - inicio).count();
+        r.totalBlocos = arvore.getIndexTotalBlocos();
+        r.est = arvore.calcularEstatisticas();
+
+        // Confere que a política não afeta o conteúdo: todas as chaves continuam encontráveis
+        for (size_t i = 0; i < chaves.size(); i += std::max<size_t>(1, chaves.size() / 1000)) {
+
+            if (arvore.search(chaves[i]).size() != 1) {
+
+                std::cerr << "Erro: chave " << chaves[i] << " nao encontrada (" << ordem << ", fator " << fator << ")" << std::endl;
+                std::exit(1);
+
+            }
+
+        }
+
+    }
+
+    std::remove(caminho.c_str());
+
+    return r;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    long n = 1000000;
+    size_t tamanhoBloco = 4096;
+    double fator = FATOR_DIVISAO_DIREITA_PADRAO;
+    std::string diretorio = "/tmp";
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg == "--bloco" && i + 1 < argc) {
+
+            tamanhoBloco = std::strtoul(argv[++i], nullptr, 10);
+
+        }
+
+        else if (arg == "--fator" && i + 1 < argc) {
+
+            fator = std::atof(argv[++i]);
+
+        }
+
+        else if (arg == "--dir" && i + 1 < argc) {
+
+            diretorio = argv[++i];
+
+        }
+
+        else {
+
+            n = std::atol(argv[i]);
+
+        }
+
+    }
+
+    if (n <= 0 || fator < 0.5 || fator > 1.0) {
+
+        std::cerr << "Uso: " << argv[0] << " [N] [--bloco B] [--fator F (0.5 a 1.0)] [--dir D]" << std::endl;
+        return 1;
+
+    }
+
+    std::vector<int> sequencial(n);
+
+    for (long i = 0; i < n; ++i) {
+
+        sequencial[i] = static_cast<int>(i + 1);
+
+    }
+
+    std::vector<int> aleatoria = sequencial;
+    std::shuffle(aleatoria.begin(), aleatoria.end(), std::mt19937(42));
+
+    const std::string caminho = diretorio + "/bench_divisao_" + std::to_string(getpid()) + ".idx";
+
+    std::vector<ResultadoBench> resultados;
+
+    try {
+
+        std::filesystem::create_directories(diretorio);
+
+        resultados.push_back(executar(caminho, tamanhoBloco, sequencial, "sequencial", 0.5));
+        resultados.push_back(executar(caminho, tamanhoBloco, sequencial, "sequencial", fator));
+        resultados.push_back(executar(caminho, tamanhoBloco, aleatoria, "aleatoria", 0.5));
+        resultados.push_back(executar(caminho, tamanhoBloco, aleatoria, "aleatoria", fator));
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro no benchmark: " << e.what() << std::endl;
+        std::remove(caminho.c_str());
+        return 1;
+
+    }
+
+    std::cout << "BPlusTree<int>: " << n << " chaves, bloco de " << tamanhoBloco << " bytes" << std::endl;
+    std::cout << std::left << std::setw(12) << "ordem" << std::setw(8) << "fator"
+              << std::right << std::setw(10) << "blocos" << std::setw(10) << "folhas"
+              << std::setw(12) << "ocupacao" << std::setw(8) << "altura" << std::setw(12) << "tempo(ms)" << std::endl;
+
+    for (const ResultadoBench& r : resultados) {
+
+        std::cout << std::left << std::setw(12) << r.ordem << std::setw(8) << std::fixed << std::setprecision(2) << r.fator
+                  << std::right << std::setw(10) << r.totalBlocos << std::setw(10) << r.est.numFolhas
+                  << std::setw(11) << std::setprecision(1) << (100.0 * r.est.ocupacaoFolhas) << "%"
+                  << std::setw(8) << r.est.altura << std::setw(12) << r.duracao_ms << std::endl;
+
+    }
+
+    return 0;
+
+}
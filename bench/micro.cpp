@@ -0,0 +1,846 @@
+// Módulos C++
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "config.hpp"
+#include "Parser.hpp"
+#include "OSInfo.hpp"
+#include "BlocoDeDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "ArquivoHashEstatico.hpp"
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisTitulo.hpp"
+#include "GeradorCSV.hpp"
+
+/**
+ * @brief Benchmark bench_micro: laços internos medidos isoladamente.
+ *
+ * Mede divideCSVLinha e parseCSVLinha sobre linhas do GeradorCSV, serializaNo e
+ * deserializaNo de folhas cheias de BPlusTree<int> e de páginas cheias (folha e nó
+ * interno) de BPlusTreeTitulo, ArquivoHashEstatico::inserir em um arquivo em tmpfs
+ * (/dev/shm, sem disco) e as comparações das chaves de título: std::string (as chaves
+ * de BPlusTreeTitulo, inclusive a busca binária dentro de uma folha) e
+ * ChaveTituloNormalizada (modo hash).
+ *
+ * Os casos de ChaveTitulo (chave fixa de 300 bytes, que nenhum índice usa mais) ficam
+ * como referência e são marcados com "[referencia]" no nome.
+ *
+ * Cada caso roda W repetições de aquecimento e R repetições medidas; relata a mediana e
+ * o mínimo de ns/op e, quando o kernel permite perf_event_open, a mediana de ciclos/op
+ * (ciclos de usuário e kernel, ou só de usuário se perf_event_paranoid proibir o kernel).
+ *
+ * --salvar-base grava "nome<TAB>ns/op<TAB>ciclos/op" de cada caso; --base lê um arquivo
+ * nesse formato e mostra a variação de cada caso em relação a ele.
+ *
+ * Uso: bench_micro [--repeticoes R] [--aquecimento W] [--filtro texto] [--dir D] [--base arquivo] [--salvar-base arquivo]
+ */
+
+using Relogio = std::chrono::steady_clock;
+
+// Impede que o compilador descarte o valor calculado pelo caso medido
+template <typename T>
+static inline void naoOtimizar(const T& valor) {
+
+    asm volatile("" : : "r,m"(valor) : "memory");
+
+}
+
+/**
+ * @class ContadorCiclos
+ * @brief Contador de ciclos de CPU da thread via perf_event_open (indisponível em VMs sem PMU
+ * ou com perf_event_paranoid alto; nesse caso os ciclos não são relatados).
+ */
+class ContadorCiclos {
+
+    private:
+        int fd;
+        bool incluiKernel;
+
+        static int abrir(bool excluirKernel) {
+
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = PERF_COUNT_HW_CPU_CYCLES;
+            attr.disabled = 1;
+            attr.exclude_kernel = excluirKernel ? 1 : 0;
+            attr.exclude_hv = 1;
+
+            return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+
+        }
+
+    public:
+        ContadorCiclos() : fd(abrir(false)), incluiKernel(true) {
+
+            if (fd < 0) {
+
+                fd = abrir(true);
+                incluiKernel = false;
+
+            }
+
+        }
+
+        ~ContadorCiclos() {
+
+            if (fd >= 0) {
+
+                close(fd);
+
+            }
+
+        }
+
+        bool disponivel() const { return fd >= 0; }
+        bool contaKernel() const { return incluiKernel; }
+
+        void iniciar() {
+
+            if (fd >= 0) {
+
+                ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+
+            }
+
+        }
+
+        long long parar() {
+
+            long long ciclos = -1;
+
+            if (fd >= 0) {
+
+                ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+                if (read(fd, &ciclos, sizeof(ciclos)) != sizeof(ciclos)) {
+
+                    ciclos = -1;
+
+                }
+
+            }
+
+            return ciclos;
+
+        }
+
+};
+
+struct OpcoesMicro {
+
+    int repeticoes = 15;
+    int aquecimento = 3;
+    std::string filtro;
+
+};
+
+struct ResultadoMicro {
+
+    std::string nome;
+    long ops = 0;             // operações por repetição
+    double ns_por_op = 0.0;   // mediana das repetições
+    double ns_min = 0.0;
+    double ciclos_por_op = -1.0;
+
+};
+
+static double mediana(std::vector<double> valores) {
+
+    std::sort(valores.begin(), valores.end());
+
+    size_t n = valores.size();
+
+    return (n % 2 == 1) ? valores[n / 2] : 0.5 * (valores[n / 2 - 1] + valores[n / 2]);
+
+}
+
+/**
+ * @brief Mede um caso: preparar() roda fora da medição antes de cada repetição e
+ * executar() faz as 'ops' operações medidas.
+ */
+template <typename Preparar, typename Executar>
+static void medir(std::vector<ResultadoMicro>& resultados, const std::string& nome, long ops, const OpcoesMicro& opcoes,
+                  ContadorCiclos& contador, Preparar preparar, Executar executar) {
+
+    if (!opcoes.filtro.empty() && nome.find(opcoes.filtro) == std::string::npos) {
+
+        return;
+
+    }
+
+    for (int i = 0; i < opcoes.aquecimento; ++i) {
+
+        preparar();
+        executar();
+
+    }
+
+    std::vector<double> ns;
+    std::vector<double> ciclos;
+
+    for (int i = 0; i < opcoes.repeticoes; ++i) {
+
+        preparar();
+
+        contador.iniciar();
+        auto inicio = Relogio::now();
+
+        executar();
+
+        auto fim = Relogio::now();
+        long long c = contador.parar();
+
+        ns.push_back(std::chrono::duration<double, std::nano>(fim - inicio).count() / ops);
+
+        if (c >= 0) {
+
+            ciclos.push_back(static_cast<double>(c) / ops);
+
+        }
+
+    }
+
+    ResultadoMicro r;
+    r.nome = nome;
+    r.ops = ops;
+    r.ns_por_op = mediana(ns);
+    r.ns_min = *std::min_element(ns.begin(), ns.end());
+    r.ciclos_por_op = ciclos.empty() ? -1.0 : mediana(ciclos);
+
+    std::cerr << "  " << nome << ": " << std::fixed << std::setprecision(1) << r.ns_por_op << " ns/op" << std::endl;
+
+    resultados.push_back(r);
+
+}
+
+static void semPreparo() {}
+
+// Folha cheia de um bloco de 'tamanhoBloco' bytes, com a mesma ordem calculada por BPlusTree
+template <typename KeyType, typename GerarChave>
+static No<KeyType> folhaCheia(size_t tamanhoBloco, GerarChave gerar) {
+
+    const size_t tamMetadados = sizeof(bool) + sizeof(int) + sizeof(long);
+    const int m = static_cast<int>((tamanhoBloco - tamMetadados) / (sizeof(KeyType) + sizeof(long)));
+
+    No<KeyType> folha(true);
+    folha.numChaves = m;
+    folha.proximo = 7;
+
+    for (int i = 0; i < m; ++i) {
+
+        folha.vetorChaves.push_back(gerar(i));
+        folha.vetorApontadores.push_back(1000 + i);
+
+    }
+
+    return folha;
+
+}
+
+template <typename KeyType>
+static void medirSerializacao(std::vector<ResultadoMicro>& resultados, const std::string& tipo, const No<KeyType>& folha,
+                              size_t tamanhoBloco, const OpcoesMicro& opcoes, ContadorCiclos& contador, const std::string& rotulo = "") {
+
+    const long ops = 20000;
+    std::vector<char> buffer(tamanhoBloco, 0);
+    No<KeyType> destino;
+
+    medir(resultados, "serializaNo<" + tipo + "> folha cheia" + rotulo, ops, opcoes, contador, semPreparo, [&]() {
+
+        for (long i = 0; i < ops; ++i) {
+
+            serializaNo(folha, buffer.data());
+            naoOtimizar(buffer[0]);
+
+        }
+
+    });
+
+    serializaNo(folha, buffer.data());
+
+    medir(resultados, "deserializaNo<" + tipo + "> folha cheia" + rotulo, ops, opcoes, contador, semPreparo, [&]() {
+
+        for (long i = 0; i < ops; ++i) {
+
+            deserializaNo(buffer.data(), destino);
+            naoOtimizar(destino.numChaves);
+
+        }
+
+    });
+
+}
+
+// Página de BPlusTreeTitulo com as chaves ordenadas 'chaves' até encher o bloco: folhas com
+// uma postagem por chave, nós internos com numChaves + 1 apontadores.
+static NoTitulo paginaTituloCheia(const BPlusTreeTitulo& arvore, const std::vector<std::string>& chaves, bool ehFolha, size_t tamanhoBloco) {
+
+    NoTitulo no(ehFolha);
+    no.proximo = ehFolha ? 7 : -1;
+
+    if (!ehFolha) {
+
+        no.vetorApontadores.push_back(1000);
+
+    }
+
+    for (size_t i = 0; i < chaves.size(); ++i) {
+
+        no.vetorChaves.push_back(chaves[i]);
+
+        if (ehFolha) {
+
+            ListaPostagem lista;
+            lista.total = 1;
+            lista.apontadores.push_back(static_cast<long>(1000 + i));
+            no.postagens.push_back(lista);
+
+        }
+
+        else {
+
+            no.vetorApontadores.push_back(static_cast<long>(1001 + i));
+
+        }
+
+        if (arvore.tamanhoSerializado(no) > tamanhoBloco) {
+
+            no.vetorChaves.pop_back();
+            (ehFolha ? no.postagens.pop_back() : no.vetorApontadores.pop_back());
+
+            break;
+
+        }
+
+    }
+
+    return no;
+
+}
+
+static void medirSerializacaoTitulo(std::vector<ResultadoMicro>& resultados, const BPlusTreeTitulo& arvore, const NoTitulo& no,
+                                    size_t tamanhoBloco, const OpcoesMicro& opcoes, ContadorCiclos& contador) {
+
+    const long ops = 20000;
+    const std::string pagina = std::string(no.ehFolha ? "folha" : "interno") + " (" + std::to_string(no.vetorChaves.size()) + " chaves)";
+    std::vector<char> buffer(tamanhoBloco, 0);
+    NoTitulo destino;
+
+    medir(resultados, "BPlusTreeTitulo::serializaNo " + pagina, ops, opcoes, contador, semPreparo, [&]() {
+
+        for (long i = 0; i < ops; ++i) {
+
+            arvore.serializaNo(no, buffer.data());
+            naoOtimizar(buffer[0]);
+
+        }
+
+    });
+
+    arvore.serializaNo(no, buffer.data());
+
+    medir(resultados, "BPlusTreeTitulo::deserializaNo " + pagina, ops, opcoes, contador, semPreparo, [&]() {
+
+        for (long i = 0; i < ops; ++i) {
+
+            arvore.deserializaNo(buffer.data(), destino);
+            naoOtimizar(destino.vetorChaves.size());
+
+        }
+
+    });
+
+}
+
+static std::map<std::string, std::pair<double, double>> lerBase(const std::string& caminho) {
+
+    std::map<std::string, std::pair<double, double>> base;
+    std::ifstream entrada(caminho);
+
+    if (!entrada.is_open()) {
+
+        throw std::runtime_error("Não foi possível abrir a base " + caminho);
+
+    }
+
+    std::string linha;
+
+    while (std::getline(entrada, linha)) {
+
+        size_t t1 = linha.find('\t');
+        size_t t2 = (t1 == std::string::npos) ? t1 : linha.find('\t', t1 + 1);
+
+        if (linha.empty() || linha[0] == '#' || t2 == std::string::npos) {
+
+            continue;
+
+        }
+
+        base[linha.substr(0, t1)] = {std::atof(linha.substr(t1 + 1, t2 - t1 - 1).c_str()), std::atof(linha.substr(t2 + 1).c_str())};
+
+    }
+
+    return base;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+    log_redirect_stderr();
+
+    OpcoesMicro opcoes;
+    std::string diretorio = std::filesystem::is_directory("/dev/shm") ? "/dev/shm" : "/tmp";
+    std::string caminho_base;
+    std::string caminho_salvar;
+    bool argumentos_validos = true;
+
+    for (int i = 1; i < argc && argumentos_validos; ++i) {
+
+        std::string arg = argv[i];
+
+        if (i + 1 >= argc) {
+
+            argumentos_validos = false;
+
+        }
+
+        else if (arg == "--repeticoes") {
+
+            opcoes.repeticoes = std::atoi(argv[++i]);
+
+        }
+
+        else if (arg == "--aquecimento") {
+
+            opcoes.aquecimento = std::atoi(argv[++i]);
+
+        }
+
+        else if (arg == "--filtro") {
+
+            opcoes.filtro = argv[++i];
+
+        }
+
+        else if (arg == "--dir") {
+
+            diretorio = argv[++i];
+
+        }
+
+        else if (arg == "--base") {
+
+            caminho_base = argv[++i];
+
+        }
+
+        else if (arg == "--salvar-base") {
+
+            caminho_salvar = argv[++i];
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (!argumentos_validos || opcoes.repeticoes <= 0 || opcoes.aquecimento < 0) {
+
+        std::cerr << "Uso: " << argv[0] << " [--repeticoes R] [--aquecimento W] [--filtro texto] [--dir D] [--base arquivo] [--salvar-base arquivo]" << std::endl;
+        return 1;
+
+    }
+
+    //#################################################################
+    // 1. Dados de entrada (determinísticos)
+    //#################################################################
+
+    ConfiguracaoGerador config;
+    config.linhas = 4000;
+    config.ordem = OrdemIds::EMBARALHADA;
+
+    GeradorCSV gerador(config);
+    std::vector<std::string> linhas;
+    std::string linha;
+
+    while (gerador.proximaLinha(linha)) {
+
+        linhas.push_back(linha);
+
+    }
+
+    std::vector<Artigo> artigos(linhas.size());
+
+    for (size_t i = 0; i < linhas.size(); ++i) {
+
+        parseCSVLinha(linhas[i], artigos[i]);
+
+    }
+
+    std::vector<ChaveTitulo> chaves_titulo;
+    std::vector<std::string> titulos;
+
+    for (const Artigo& artigo : artigos) {
+
+        chaves_titulo.emplace_back(artigo.titulo);
+        titulos.emplace_back(artigo.titulo);
+
+    }
+
+    ContadorCiclos contador;
+    std::vector<ResultadoMicro> resultados;
+
+    std::cerr << "bench_micro: " << opcoes.repeticoes << " repetições (+" << opcoes.aquecimento << " de aquecimento), ciclos "
+              << (contador.disponivel() ? (contador.contaKernel() ? "com kernel" : "só de usuário") : "indisponíveis") << std::endl;
+
+    //#################################################################
+    // 2. Parser
+    //#################################################################
+
+    medir(resultados, "divideCSVLinha", static_cast<long>(linhas.size()), opcoes, contador, semPreparo, [&]() {
+
+        for (const std::string& l : linhas) {
+
+            std::vector<std::string> campos = divideCSVLinha(l);
+            naoOtimizar(campos.size());
+
+        }
+
+    });
+
+    medir(resultados, "parseCSVLinha", static_cast<long>(linhas.size()), opcoes, contador, semPreparo, [&]() {
+
+        Artigo artigo;
+
+        for (const std::string& l : linhas) {
+
+            bool ok = parseCSVLinha(l, artigo);
+            naoOtimizar(ok);
+
+        }
+
+    });
+
+    //#################################################################
+    // 3. (De)serialização de nós da BPlusTree (bloco de 4096 bytes)
+    //#################################################################
+
+    const size_t TAMANHO_BLOCO_BTREE = 4096;
+
+    medirSerializacao(resultados, "int", folhaCheia<int>(TAMANHO_BLOCO_BTREE, [](int i) { return 10 * i; }),
+                      TAMANHO_BLOCO_BTREE, opcoes, contador);
+    medirSerializacao(resultados, "ChaveTitulo", folhaCheia<ChaveTitulo>(TAMANHO_BLOCO_BTREE, [&](int i) { return chaves_titulo[i]; }),
+                      TAMANHO_BLOCO_BTREE, opcoes, contador, " [referencia]");
+
+    // Páginas de BPlusTreeTitulo com títulos distintos em ordem (chaves de tamanho variável com prefixo comum)
+    std::vector<std::string> titulos_ordenados(titulos);
+    std::sort(titulos_ordenados.begin(), titulos_ordenados.end());
+    titulos_ordenados.erase(std::unique(titulos_ordenados.begin(), titulos_ordenados.end()), titulos_ordenados.end());
+
+    const std::string caminho_titulo = diretorio + "/bench_micro_titulo_" + std::to_string(getpid()) + ".idx";
+    NoTitulo folha_titulo;
+
+    try {
+
+        std::remove(caminho_titulo.c_str());
+
+        BPlusTreeTitulo arvore_titulo(caminho_titulo, TAMANHO_BLOCO_BTREE);
+
+        folha_titulo = paginaTituloCheia(arvore_titulo, titulos_ordenados, true, TAMANHO_BLOCO_BTREE);
+
+        medirSerializacaoTitulo(resultados, arvore_titulo, folha_titulo, TAMANHO_BLOCO_BTREE, opcoes, contador);
+        medirSerializacaoTitulo(resultados, arvore_titulo, paginaTituloCheia(arvore_titulo, titulos_ordenados, false, TAMANHO_BLOCO_BTREE),
+                                TAMANHO_BLOCO_BTREE, opcoes, contador);
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro: " << e.what() << std::endl;
+        std::remove(caminho_titulo.c_str());
+
+        return 1;
+
+    }
+
+    std::remove(caminho_titulo.c_str());
+
+    //#################################################################
+    // 4. ArquivoHashEstatico::inserir em tmpfs
+    //#################################################################
+
+    {
+
+        // Poucos buckets (o arquivo inteiro cabe em memória), ~1,2 registro por bucket
+        const int NUM_BUCKETS_MICRO = 4096;
+        const size_t TAMANHO_BLOCO_DADOS = calcular_bloco_logico(sizeof(BlocoDeDados), 4096);
+        const std::string caminho = diretorio + "/bench_micro_" + std::to_string(getpid()) + ".dat";
+
+        std::unique_ptr<ArquivoHashEstatico> hash;
+        std::unique_ptr<GerenciadorArquivoDados> dados;
+
+        // Arquivo novo a cada repetição; a alocação dos buckets primários fica fora da medição
+        auto recriar = [&]() {
+
+            hash.reset();
+            dados.reset();
+            std::remove(caminho.c_str());
+
+            dados = std::make_unique<GerenciadorArquivoDados>(caminho, TAMANHO_BLOCO_DADOS);
+            hash = std::make_unique<ArquivoHashEstatico>(*dados, NUM_BUCKETS_MICRO);
+            hash->inicializar();
+
+        };
+
+        medir(resultados, "ArquivoHashEstatico::inserir (tmpfs)", static_cast<long>(artigos.size()), opcoes, contador, recriar, [&]() {
+
+            for (const Artigo& artigo : artigos) {
+
+                size_t bloco = hash->inserir(artigo);
+                naoOtimizar(bloco);
+
+            }
+
+        });
+
+        hash.reset();
+        dados.reset();
+        std::remove(caminho.c_str());
+
+    }
+
+    //#################################################################
+    // 5. Comparações de chaves de título
+    //#################################################################
+
+    const long COMPARACOES = 200000;
+    std::vector<std::pair<size_t, size_t>> pares(COMPARACOES);
+    std::mt19937 aleatorio(42);
+
+    for (auto& par : pares) {
+
+        par = {aleatorio() % chaves_titulo.size(), aleatorio() % chaves_titulo.size()};
+
+    }
+
+    // Chaves de BPlusTreeTitulo: std::string comparada por memcmp até a primeira diferença
+    medir(resultados, "std::string operator< (titulos, pares aleatorios)", COMPARACOES, opcoes, contador, semPreparo, [&]() {
+
+        long menores = 0;
+
+        for (const auto& par : pares) {
+
+            menores += titulos[par.first] < titulos[par.second];
+
+        }
+
+        naoOtimizar(menores);
+
+    });
+
+    // Pior caso: títulos iguais, comparados até o fim
+    std::vector<std::string> copias_titulos(titulos);
+
+    medir(resultados, "std::string operator== (titulos iguais)", COMPARACOES, opcoes, contador, semPreparo, [&]() {
+
+        long iguais = 0;
+
+        for (const auto& par : pares) {
+
+            iguais += titulos[par.first] == copias_titulos[par.first];
+
+        }
+
+        naoOtimizar(iguais);
+
+    });
+
+    // Passo de uma busca em BPlusTreeTitulo: busca binária do título na folha cheia
+    medir(resultados, "BPlusTreeTitulo lower_bound na folha (" + std::to_string(folha_titulo.vetorChaves.size()) + " chaves)", COMPARACOES, opcoes, contador,
+          semPreparo, [&]() {
+
+        size_t soma = 0;
+
+        for (const auto& par : pares) {
+
+            soma += std::lower_bound(folha_titulo.vetorChaves.begin(), folha_titulo.vetorChaves.end(), titulos[par.first]) - folha_titulo.vetorChaves.begin();
+
+        }
+
+        naoOtimizar(soma);
+
+    });
+
+    medir(resultados, "ChaveTitulo::operator< (pares aleatorios) [referencia]", COMPARACOES, opcoes, contador, semPreparo, [&]() {
+
+        long menores = 0;
+
+        for (const auto& par : pares) {
+
+            menores += chaves_titulo[par.first] < chaves_titulo[par.second];
+
+        }
+
+        naoOtimizar(menores);
+
+    });
+
+    std::vector<ChaveTitulo> copias(chaves_titulo);
+
+    medir(resultados, "ChaveTitulo::operator== (titulos iguais) [referencia]", COMPARACOES, opcoes, contador, semPreparo, [&]() {
+
+        long iguais = 0;
+
+        for (const auto& par : pares) {
+
+            iguais += chaves_titulo[par.first] == copias[par.first];
+
+        }
+
+        naoOtimizar(iguais);
+
+    });
+
+    std::vector<ChaveTituloNormalizada> normalizadas(titulos.begin(), titulos.end());
+
+    medir(resultados, "ChaveTituloNormalizada(titulo)", static_cast<long>(titulos.size()), opcoes, contador, semPreparo, [&]() {
+
+        for (const std::string& titulo : titulos) {
+
+            ChaveTituloNormalizada chave(titulo);
+            naoOtimizar(chave.hash);
+
+        }
+
+    });
+
+    medir(resultados, "ChaveTituloNormalizada::operator< (pares aleatorios)", COMPARACOES, opcoes, contador, semPreparo, [&]() {
+
+        long menores = 0;
+
+        for (const auto& par : pares) {
+
+            menores += normalizadas[par.first] < normalizadas[par.second];
+
+        }
+
+        naoOtimizar(menores);
+
+    });
+
+    //#################################################################
+    // 6. Relatório e base de comparação
+    //#################################################################
+
+    std::map<std::string, std::pair<double, double>> base;
+
+    try {
+
+        if (!caminho_base.empty()) {
+
+            base = lerBase(caminho_base);
+
+        }
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << e.what() << std::endl;
+        return 1;
+
+    }
+
+    std::cout << std::left << std::setw(54) << "caso" << std::right << std::setw(12) << "ns/op" << std::setw(12) << "min ns/op"
+              << std::setw(12) << "ciclos/op";
+
+    if (!base.empty()) {
+
+        std::cout << std::setw(12) << "base ns/op" << std::setw(10) << "variacao";
+
+    }
+
+    std::cout << std::endl;
+
+    for (const ResultadoMicro& r : resultados) {
+
+        std::cout << std::left << std::setw(54) << r.nome << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(12) << r.ns_por_op << std::setw(12) << r.ns_min;
+
+        if (r.ciclos_por_op >= 0) {
+
+            std::cout << std::setw(12) << r.ciclos_por_op;
+
+        }
+
+        else {
+
+            std::cout << std::setw(12) << "-";
+
+        }
+
+        auto it = base.find(r.nome);
+
+        if (it != base.end() && it->second.first > 0) {
+
+            std::cout << std::setw(12) << it->second.first << std::setw(9) << std::showpos
+                      << 100.0 * (r.ns_por_op / it->second.first - 1.0) << "%" << std::noshowpos;
+
+        }
+
+        std::cout << std::endl;
+
+    }
+
+    if (!caminho_salvar.empty()) {
+
+        std::ofstream saida(caminho_salvar);
+
+        if (!saida.is_open()) {
+
+            std::cerr << "Não foi possível gravar a base em " << caminho_salvar << std::endl;
+            return 1;
+
+        }
+
+        saida << "# bench_micro: nome\tns/op (mediana)\tciclos/op (-1: indisponível)\n";
+
+        for (const ResultadoMicro& r : resultados) {
+
+            saida << r.nome << '\t' << std::fixed << std::setprecision(2) << r.ns_por_op << '\t' << r.ciclos_por_op << '\n';
+
+        }
+
+    }
+
+    return 0;
+
+}
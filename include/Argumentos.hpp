@@ -0,0 +1,19 @@
+#ifndef ARGUMENTOS_HPP
+#define ARGUMENTOS_HPP
+
+#include <string>
+
+/**
+ * @brief Converte um argumento da linha de comando para um inteiro entre minimo e maximo.
+ * O texto precisa ser consumido por inteiro ("12a" é inválido).
+ * @param descricao Nome do argumento na mensagem de erro (ex.: "Ano").
+ * @return 'false' (com o erro registrado) se o texto for inválido ou estiver fora da faixa.
+ */
+bool lerInteiroArgumento(const char* texto, const std::string& descricao, long long minimo, long long maximo, long long& valor);
+
+/**
+ * @brief Igual à anterior, para um int sem faixa além da do próprio tipo.
+ */
+bool lerInteiroArgumento(const char* texto, const std::string& descricao, int& valor);
+
+#endif // ARGUMENTOS_HPP
@@ -2,11 +2,14 @@
 #define HASH_ESTATICO_HPP
 
 #include <optional>
+#include <vector>
 #include <cstddef>
 
 #include "GerenciadorArquivoDados.hpp"
 #include "BlocoDeDados.hpp"
 #include "Artigo.hpp"
+#include "ArtigoView.hpp"
+#include "SondagemIntercalada.hpp"
 
 /**
  * @class ArquivoHashEstatico
@@ -48,16 +51,48 @@ class ArquivoHashEstatico {
         /**
          * @brief Insere um artigo, tratando colisões por encadeamento de overflow e alocando novos blocos se necessário.
          * @param a O Artigo a ser inserido.
+         * @param posicao Se não for nulo, recebe a posição do artigo dentro do bloco (0 a CAPACIDADE_BUCKET - 1).
          * @return O ID do bloco onde o artigo foi inserido.
          */
-        size_t inserir(const Artigo& a); 
+        size_t inserir(const Artigo& a, size_t* posicao = nullptr);
         
         /**
          * @brief Busca um artigo pelo ID, percorrendo o bucket primário e sua cadeia de overflow.
+         * Somente leitura: pode ser chamada por várias threads ao mesmo tempo (sem inserções concorrentes).
          * @param id O ID a ser buscado.
-         * @return O Artigo encontrado (ou vazio, se não encontrado).
+         * @param blocosLidos Se informado, recebe a soma dos blocos lidos por esta consulta.
+         * @return Uma visão do artigo dentro do bucket mapeado (ver ArtigoView), ou vazio se não encontrado.
          */
-        std::optional<Artigo> buscar(int id);
+        std::optional<ArtigoView> buscar(int id, long* blocosLidos = nullptr);
+
+        /**
+         * @brief Busca um lote de IDs agrupando-os por bucket.
+         *
+         * Os buckets primários do lote são calculados e ordenados, faixas contíguas são sugeridas
+         * ao S.O. (madvise WILLNEED) e cada cadeia de overflow é percorrida uma única vez para
+         * todos os IDs que caem nela. Somente leitura, como buscar().
+         * @param ids Os IDs buscados.
+         * @param blocosPorChave Se informado, recebe os blocos lidos por ID; cada bloco é contado
+         * no primeiro ID (em ordem de bucket) que precisou dele.
+         * @return Os artigos encontrados, na ordem de 'ids'.
+         */
+        std::vector<std::optional<ArtigoView>> buscarLote(const std::vector<int>& ids, std::vector<long>* blocosPorChave = nullptr);
+
+        /**
+         * @brief Corrotina de buscar(): antes de ler cada bucket da cadeia, antecipa o bloco
+         * (GerenciadorArquivoDados::anteciparBloco) e suspende. Ver SondagemIntercalada.hpp.
+         * @param resultado Recebe o artigo, se encontrado.
+         * @param blocosLidos Recebe a soma dos blocos lidos pela sondagem.
+         */
+        Sondagem sondar(int id, std::optional<ArtigoView>& resultado, long& blocosLidos);
+
+        /**
+         * @brief Busca um lote de IDs com até 'largura' sondagens intercaladas em andamento.
+         * Cada ID percorre a sua própria cadeia, como em buscar(), então os blocos lidos
+         * por chave são os mesmos da busca individual. Somente leitura, como buscar().
+         * @return Os artigos encontrados, na ordem de 'ids'.
+         */
+        std::vector<std::optional<ArtigoView>> buscarIntercalado(const std::vector<int>& ids, size_t largura, std::vector<long>* blocosPorChave = nullptr);
         
 };
 
@@ -0,0 +1,85 @@
+#ifndef ARTIGO_VIEW_HPP
+#define ARTIGO_VIEW_HPP
+
+#include <string_view>
+#include <algorithm>
+#include <cstring>
+
+#include "Artigo.hpp"
+
+/**
+ * @struct ArtigoView
+ * @brief Visão somente leitura de um Artigo, sem copiar os 1504 bytes do registro.
+ *
+ * Os campos de texto são std::string_view que apontam para dentro do registro de origem
+ * (normalmente o bucket mapeado por GerenciadorArquivoDados), já sem o preenchimento de
+ * '\0' dos campos fixos.
+ *
+ * Tempo de vida: uma ArtigoView obtida de artigos.dat vale enquanto o
+ * GerenciadorArquivoDados que mapeou o bloco existir e nenhum bloco novo for alocado
+ * nele (alocarNovoBloco pode mover o mapeamento com mremap). Nos caminhos de leitura
+ * (findrec, seek1, seek2, servidor) o arquivo fica mapeado até o fim do programa. Para
+ * guardar o registro além disso, use copiar().
+ */
+struct ArtigoView {
+
+    int id = 0;
+    std::string_view titulo;
+    int ano = 0;
+    std::string_view autores;
+    int citacoes = 0;
+    std::string_view atualizacao;
+    std::string_view snippet;
+
+    ArtigoView() = default;
+
+    // Conversão implícita, como de std::string para std::string_view
+    ArtigoView(const Artigo& artigo)
+        : id(artigo.id),
+          titulo(campo(artigo.titulo, sizeof(artigo.titulo))),
+          ano(artigo.ano),
+          autores(campo(artigo.autores, sizeof(artigo.autores))),
+          citacoes(artigo.citacoes),
+          atualizacao(campo(artigo.atualizacao, sizeof(artigo.atualizacao))),
+          snippet(campo(artigo.snippet, sizeof(artigo.snippet))) {}
+
+    /**
+     * @brief Copia a visão para um Artigo independente do arquivo mapeado.
+     */
+    Artigo copiar() const {
+
+        Artigo artigo;
+        std::memset(&artigo, 0, sizeof(Artigo));
+
+        artigo.id = id;
+        artigo.ano = ano;
+        artigo.citacoes = citacoes;
+        copiarCampo(artigo.titulo, sizeof(artigo.titulo), titulo);
+        copiarCampo(artigo.autores, sizeof(artigo.autores), autores);
+        copiarCampo(artigo.atualizacao, sizeof(artigo.atualizacao), atualizacao);
+        copiarCampo(artigo.snippet, sizeof(artigo.snippet), snippet);
+
+        return artigo;
+
+    }
+
+    private:
+        // Texto de um campo fixo até o primeiro '\0' (ou o campo inteiro, se não houver)
+        static std::string_view campo(const char* texto, size_t tamanho) {
+
+            return std::string_view(texto, strnlen(texto, tamanho));
+
+        }
+
+        static void copiarCampo(char* destino, size_t tamanho, std::string_view texto) {
+
+            size_t n = std::min(texto.size(), tamanho - 1);
+
+            std::memcpy(destino, texto.data(), n);
+            destino[n] = '\0';
+
+        }
+
+};
+
+#endif // ARTIGO_VIEW_HPP
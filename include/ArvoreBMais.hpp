@@ -7,7 +7,12 @@
 #include <stdexcept>
 #include <math.h>
 #include <cmath> 
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
 #include "GerenciadorIndice.hpp"
+#include "Instrumentacao.hpp"
+#include "config.hpp"
 
 // --- Structs Comuns ---
 
@@ -42,6 +47,76 @@ struct ChaveTitulo {
 
 #pragma pack(pop)
 
+// Chave normalizada de largura fixa para o modo "hash" do índice de títulos:
+// hash FNV-1a de 64 bits do título e os 8 primeiros bytes em big-endian.
+// Comparada só com inteiros; colisões são resolvidas conferindo o título no bucket.
+struct ChaveTituloNormalizada {
+
+    uint64_t hash;
+    uint64_t prefixo;
+
+    bool operator<(const ChaveTituloNormalizada& other) const { return hash < other.hash || (hash == other.hash && prefixo < other.prefixo); }
+    bool operator>(const ChaveTituloNormalizada& other) const { return other < *this; }
+    bool operator==(const ChaveTituloNormalizada& other) const { return hash == other.hash && prefixo == other.prefixo; }
+    bool operator>=(const ChaveTituloNormalizada& other) const { return !(*this < other); }
+
+    ChaveTituloNormalizada() : hash(0), prefixo(0) {}
+    ChaveTituloNormalizada(const std::string& str) : hash(14695981039346656037ULL), prefixo(0) {
+        size_t tamanho = std::min<size_t>(str.size(), 299);
+        for (size_t i = 0; i < tamanho; i++) {
+            hash ^= static_cast<unsigned char>(str[i]);
+            hash *= 1099511628211ULL;
+        }
+        for (size_t i = 0; i < 8; i++) {
+            prefixo <<= 8;
+            if (i < tamanho) prefixo |= static_cast<unsigned char>(str[i]);
+        }
+    }
+
+};
+
+// Chave composta (ano, citacoes DESC, id) do índice por ano.
+// Dentro de um ano as chaves ficam em ordem decrescente de citações, então os K
+// artigos mais citados de um ano são as K primeiras chaves da faixa do ano.
+// O id desempata e torna a chave única.
+#pragma pack(push, 1)
+
+struct ChaveAnoCitacoes {
+
+    int32_t ano;
+    int32_t citacoes;
+    int32_t id;
+
+    bool operator<(const ChaveAnoCitacoes& other) const {
+        if (ano != other.ano) return ano < other.ano;
+        if (citacoes != other.citacoes) return citacoes > other.citacoes;
+        return id < other.id;
+    }
+    bool operator>(const ChaveAnoCitacoes& other) const { return other < *this; }
+    bool operator==(const ChaveAnoCitacoes& other) const { return ano == other.ano && citacoes == other.citacoes && id == other.id; }
+    bool operator>=(const ChaveAnoCitacoes& other) const { return !(*this < other); }
+
+    ChaveAnoCitacoes() : ano(0), citacoes(0), id(0) {}
+    ChaveAnoCitacoes(int32_t ano, int32_t citacoes, int32_t id) : ano(ano), citacoes(citacoes), id(id) {}
+
+    // Menor chave possível do ano (mais citações, menor id)
+    static ChaveAnoCitacoes inicioDoAno(int32_t ano) { return ChaveAnoCitacoes(ano, INT32_MAX, INT32_MIN); }
+
+};
+
+#pragma pack(pop)
+
+// Estatísticas de ocupação obtidas percorrendo a árvore inteira
+struct EstatisticasArvore {
+
+    int altura = 0;            // níveis, contando a raiz e as folhas
+    long numFolhas = 0;
+    long numNosInternos = 0;
+    long chavesFolhas = 0;
+    double ocupacaoFolhas = 0; // chavesFolhas / (numFolhas * capacidade da folha)
+
+};
+
 // --- Nó com Template ---
 template <typename KeyType>
 
@@ -56,11 +131,160 @@ struct No {
     
     No(bool ehFolha = false) : ehFolha(ehFolha), numChaves(0), proximo(-1), selfId(-1) {}
 
+    const KeyType* chavesNo() const { return vetorChaves.data(); }
+    const long* apontadoresNo() const { return vetorApontadores.data(); }
+
 };
 
+// --- Busca de Várias Chaves ---
+
+// Primeira posição p em [0, n) com chaves[p] >= key (mesma regra da descida de BPlusTree::lowerBound).
+template <typename KeyType>
+int primeiraPosicaoNaoMenor(const KeyType* chaves, int n, const KeyType& key) {
+    int inicio = 0, fim = n;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (key > chaves[meio]) inicio = meio + 1;
+        else fim = meio;
+    }
+    return inicio;
+}
+
+// Busca um lote de chaves com uma descida compartilhada: as chaves são ordenadas e cada nó
+// é lido uma única vez para todas as chaves que passam por ele, que são repartidas entre os
+// filhos. Chaves que passam do fim de uma folha (igual ao separador ou repetidas na folha
+// seguinte) formam um sufixo do grupo e continuam juntas em 'proximo'.
+// Devolve os apontadores de cada chave na ordem original (os mesmos de search(chave)).
+// Cada bloco lido é contado em blocosPorChave na primeira chave (em ordem) que precisou dele.
+// NoT precisa de ehFolha, numChaves, proximo, chavesNo() e apontadoresNo().
+template <typename KeyType, typename NoT, typename LerNo>
+std::vector<std::vector<long>> buscarVariasChaves(long idRaiz, const std::vector<KeyType>& chaves, LerNo lerNo, std::vector<long> *blocosPorChave) {
+    const size_t n = chaves.size();
+    std::vector<std::vector<long>> resultados(n);
+    if (blocosPorChave) blocosPorChave->assign(n, 0);
+    if (idRaiz == -1 || n == 0) return resultados;
+
+    std::vector<size_t> ordem(n);
+    for (size_t i = 0; i < n; ++i) ordem[i] = i;
+    std::stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) { return chaves[b] > chaves[a]; });
+
+    // Tarefa: ler 'idBloco' para as chaves ordem[inicio, fim)
+    struct Tarefa { long idBloco; size_t inicio; size_t fim; };
+    std::vector<Tarefa> pilha(1, Tarefa{idRaiz, 0, n});
+    std::vector<Tarefa> filhos;
+    NoT no;
+
+    while (!pilha.empty()) {
+        Tarefa t = pilha.back();
+        pilha.pop_back();
+
+        lerNo(t.idBloco, no);
+        if (blocosPorChave) (*blocosPorChave)[ordem[t.inicio]]++;
+
+        const KeyType *ch = no.chavesNo();
+        const long *ap = no.apontadoresNo();
+
+        if (!no.ehFolha) {
+            // Chaves ordenadas: cada filho recebe uma faixa contígua
+            filhos.clear();
+            for (size_t i = t.inicio; i < t.fim;) {
+                int filho = primeiraPosicaoNaoMenor(ch, no.numChaves, chaves[ordem[i]]);
+                size_t j = i + 1;
+                while (j < t.fim && (filho == no.numChaves || !(chaves[ordem[j]] > ch[filho]))) j++;
+                filhos.push_back(Tarefa{ap[filho], i, j});
+                i = j;
+            }
+            // Empilhados ao contrário para ler os filhos da esquerda para a direita
+            pilha.insert(pilha.end(), filhos.rbegin(), filhos.rend());
+            continue;
+        }
+
+        size_t transbordo = t.fim;
+        for (size_t i = t.inicio; i < t.fim; ++i) {
+            const KeyType &key = chaves[ordem[i]];
+            int pos = primeiraPosicaoNaoMenor(ch, no.numChaves, key);
+            while (pos < no.numChaves && ch[pos] == key) {
+                resultados[ordem[i]].push_back(ap[pos]);
+                pos++;
+            }
+            if (pos == no.numChaves && transbordo == t.fim) transbordo = i;
+        }
+        if (transbordo < t.fim && no.proximo != -1) {
+            pilha.push_back(Tarefa{no.proximo, transbordo, t.fim});
+        }
+    }
+    return resultados;
+}
+
+// Um passo de search(key) a partir de um nó já lido. Em um nó interno devolve o filho a
+// seguir (à esquerda na igualdade, como lowerBound). Em uma folha acrescenta a 'resultados'
+// os apontadores da chave e devolve a folha seguinte se a chave ainda pode aparecer nela,
+// ou -1 quando a busca terminou. Usado pelas sondagens intercaladas (SondagemIntercalada.hpp).
+template <typename KeyType, typename NoT>
+long passoDescida(const NoT &no, const KeyType& key, std::vector<long> &resultados) {
+    const KeyType *ch = no.chavesNo();
+    const long *ap = no.apontadoresNo();
+    int pos = primeiraPosicaoNaoMenor(ch, no.numChaves, key);
+    if (!no.ehFolha) return ap[pos];
+    while (pos < no.numChaves && ch[pos] == key) resultados.push_back(ap[pos++]);
+    return pos == no.numChaves ? no.proximo : -1;
+}
+
+// --- Formato do Nó no Bloco ---
+// ehFolha, numChaves, proximo, as chaves e os apontadores (numChaves + 1 em nós internos).
+// Funções livres para que os microbenchmarks (bench/micro.cpp) meçam só a (de)serialização.
+
+// Serializa um nó
+template <typename KeyType>
+void serializaNo(const No<KeyType> &no, char *buffer) {
+    char *ptr = buffer;
+    memcpy(ptr, &no.ehFolha, sizeof(bool));
+    ptr += sizeof(bool);
+    memcpy(ptr, &no.numChaves, sizeof(int));
+    ptr += sizeof(int);
+    memcpy(ptr, &no.proximo, sizeof(long));
+    ptr += sizeof(long);
+
+    memcpy(ptr, no.vetorChaves.data(), no.numChaves * sizeof(KeyType));
+    ptr += no.numChaves * sizeof(KeyType); 
+
+    if (no.ehFolha) {
+        memcpy(ptr, no.vetorApontadores.data(), no.numChaves * sizeof(long));
+    } else {
+        memcpy(ptr, no.vetorApontadores.data(), (no.numChaves + 1) * sizeof(long));
+    }
+}
+
+// Deserializa um nó
+template <typename KeyType>
+void deserializaNo(const char *buffer, No<KeyType> &no) {
+    const char *ptr = buffer;
+    memcpy(&no.ehFolha, ptr, sizeof(bool));
+    ptr += sizeof(bool);
+    memcpy(&no.numChaves, ptr, sizeof(int));
+    ptr += sizeof(int);
+    memcpy(&no.proximo, ptr, sizeof(long));
+    ptr += sizeof(long);
+
+    no.vetorChaves.resize(no.numChaves);
+    memcpy(no.vetorChaves.data(), ptr, no.numChaves * sizeof(KeyType));
+    ptr += no.numChaves * sizeof(KeyType);
+
+    if (no.ehFolha) {
+        no.vetorApontadores.resize(no.numChaves);
+        memcpy(no.vetorApontadores.data(), ptr, no.numChaves * sizeof(long));
+    } else {
+        no.vetorApontadores.resize(no.numChaves + 1);
+        memcpy(no.vetorApontadores.data(), ptr, (no.numChaves + 1) * sizeof(long));
+    }
+}
+
 // --- Classe BPlusTree com Template ---
+// KeyType é gravado byte a byte (memcpy) e precisa dos operadores <, >, == e >=.
 template <typename KeyType>
 class BPlusTree {
+    static_assert(std::is_trivially_copyable<KeyType>::value, "KeyType precisa ser copiavel byte a byte");
+
 private:
     // --- Atributos ---
     int tamanhoBloco;
@@ -69,6 +293,10 @@ private:
     GerenciadorIndice gerenciador;
     long idRaiz;
     long totalBlocos;
+    bool cabecalhoAlterado; // idRaiz ou totalBlocos mudaram desde a última gravação do bloco 0
+    double fatorDivisaoDireita; // fração mantida no nó antigo quando a inserção é na borda direita
+    KeyType maiorChave;         // maior chave da árvore, válida se maiorChaveConhecida
+    bool maiorChaveConhecida;
 
     // --- Métodos Privados de I/O e Nó ---
 
@@ -84,6 +312,7 @@ private:
         memcpy(buffer, &hdr, sizeof(CabecalhoIndice));
         gerenciador.escreveBloco(0, buffer);
         delete[] buffer;
+        cabecalhoAlterado = false;
     }
 
     // Lê o cabeçalho do disco
@@ -99,49 +328,6 @@ private:
         this->totalBlocos = hdr.numBlocos;
     }
 
-    // Serializa um nó
-    void serializaNo(const No<KeyType> &no, char *buffer) {
-        char *ptr = buffer;
-        memcpy(ptr, &no.ehFolha, sizeof(bool));
-        ptr += sizeof(bool);
-        memcpy(ptr, &no.numChaves, sizeof(int));
-        ptr += sizeof(int);
-        memcpy(ptr, &no.proximo, sizeof(long));
-        ptr += sizeof(long);
-
-        memcpy(ptr, no.vetorChaves.data(), no.numChaves * sizeof(KeyType));
-        ptr += no.numChaves * sizeof(KeyType); 
-
-        if (no.ehFolha) {
-            memcpy(ptr, no.vetorApontadores.data(), no.numChaves * sizeof(long));
-        } else {
-            memcpy(ptr, no.vetorApontadores.data(), (no.numChaves + 1) * sizeof(long));
-        }
-    }
-    
-    // Deserializa um nó
-    void deserializaNo(const char *buffer, No<KeyType> &no) {
-        const char *ptr = buffer;
-        memcpy(&no.ehFolha, ptr, sizeof(bool));
-        ptr += sizeof(bool);
-        memcpy(&no.numChaves, ptr, sizeof(int));
-        ptr += sizeof(int);
-        memcpy(&no.proximo, ptr, sizeof(long));
-        ptr += sizeof(long);
-
-        no.vetorChaves.resize(no.numChaves);
-        memcpy(no.vetorChaves.data(), ptr, no.numChaves * sizeof(KeyType));
-        ptr += no.numChaves * sizeof(KeyType);
-
-        if (no.ehFolha) {
-            no.vetorApontadores.resize(no.numChaves);
-            memcpy(no.vetorApontadores.data(), ptr, no.numChaves * sizeof(long));
-        } else {
-            no.vetorApontadores.resize(no.numChaves + 1);
-            memcpy(no.vetorApontadores.data(), ptr, (no.numChaves + 1) * sizeof(long));
-        }
-    }
-
     // Escreve um nó no disco
     void escreverNo(No<KeyType> *no) {
         char *buffer = new char[tamanhoBloco];
@@ -161,15 +347,35 @@ private:
     }
 
     // Retorna um novo ID para um nó
+#if defined(INSTRUMENTACAO) && INSTRUMENTACAO
+    // Nós criados por uma inserção (divisões em cascata, nova raiz), registrados ao sair
+    // de insert() com a chave como contexto quando ela é inteira.
+    struct RegistroDivisoes {
+        long contexto;
+        const long &totalBlocos;
+        long inicial;
+        RegistroDivisoes(const KeyType &key, const long &totalBlocos) : contexto(-1), totalBlocos(totalBlocos), inicial(totalBlocos) {
+            if constexpr (std::is_integral_v<KeyType>) contexto = static_cast<long>(key);
+        }
+        ~RegistroDivisoes() { INSTR_REGISTRAR("btree.insert.nos_criados", "nos", totalBlocos - inicial, contexto); }
+    };
+#endif
+
     long getNovoId() {
         long id = this->totalBlocos;
         this->totalBlocos++;
+        this->cabecalhoAlterado = true;
         return id;
     }
 
     // --- Métodos Privados de Inserção ---
 
-    void splitChild(No<KeyType> *parent, int irmaoIndex) {
+    // Divide o filho cheio parent->vetorApontadores[irmaoIndex].
+    // Se divisaoDireita for verdadeiro (inserção após a maior chave da árvore, como IDs
+    // crescentes), o nó antigo fica com a fração 'fatorDivisaoDireita' das chaves em vez
+    // da metade; com o padrão 1.0 ele fica cheio e só o restante passa ao novo irmão.
+    // O novo irmão sempre recebe ao menos uma chave (folha) ou uma chave e dois filhos (interno).
+    void splitChild(No<KeyType> *parent, int irmaoIndex, bool divisaoDireita = false) {
         No<KeyType> *novoIrmao = new No<KeyType>();
         novoIrmao->selfId = this->getNovoId();
 
@@ -184,6 +390,9 @@ private:
 
         if (irmao->ehFolha) {
             indiceMeio = m / 2;
+            if (divisaoDireita) {
+                indiceMeio = std::max(indiceMeio, std::min(static_cast<int>(std::ceil(fatorDivisaoDireita * m)), m - 1));
+            }
             chavePromovida = irmao->vetorChaves[indiceMeio];
 
             novoIrmao->vetorChaves.assign(irmao->vetorChaves.begin() + indiceMeio, irmao->vetorChaves.end());
@@ -199,6 +408,9 @@ private:
             irmao->proximo = novoIrmao->selfId;
         } else {
             indiceMeio = (m - 1) / 2;
+            if (divisaoDireita) {
+                indiceMeio = std::max(indiceMeio, std::min(static_cast<int>(std::ceil(fatorDivisaoDireita * (m - 1))), m - 3));
+            }
             chavePromovida = irmao->vetorChaves[indiceMeio];
 
             novoIrmao->vetorChaves.assign(irmao->vetorChaves.begin() + indiceMeio + 1, irmao->vetorChaves.end());
@@ -223,7 +435,9 @@ private:
         delete novoIrmao;
     }
 
-    void insertNonFull(No<KeyType> *noAtual, const KeyType& key, long dataPointer) {
+    // naBordaDireita indica que a chave não é menor que a maior chave da árvore (ver
+    // insercaoAposMaior) e que noAtual é o último nó do seu nível.
+    void insertNonFull(No<KeyType> *noAtual, const KeyType& key, long dataPointer, bool naBordaDireita) {
         if (noAtual->ehFolha) {
             int i = 0;
             while (i < noAtual->numChaves && key >= noAtual->vetorChaves[i]) {
@@ -252,86 +466,154 @@ private:
             }
 
             if (irmaoIsFull) {
-                splitChild(noAtual, i);
+                splitChild(noAtual, i, naBordaDireita && i == noAtual->numChaves);
                 if (key > noAtual->vetorChaves[i]) {
                     i++;
                 }
                 idFilho = noAtual->vetorApontadores[i];
                 lerNo(idFilho, irmaoNo);
             }
-            insertNonFull(irmaoNo, key, dataPointer);
+            insertNonFull(irmaoNo, key, dataPointer, naBordaDireita && i == noAtual->numChaves);
             delete irmaoNo;
         }
     }
 
+    // A chave não é menor que a maior chave da árvore (inserção no fim, como IDs crescentes).
+    // Os separadores dos nós internos não servem para isso: uma chave depois do último
+    // separador ainda pode cair no meio da folha mais à direita. Depois de abrir um arquivo
+    // existente, a maior chave é lida uma vez descendo pelos últimos filhos.
+    bool insercaoAposMaior(const KeyType& key) {
+        if (!maiorChaveConhecida) {
+            No<KeyType> no;
+            lerNo(this->idRaiz, &no);
+            while (!no.ehFolha) {
+                lerNo(no.vetorApontadores.back(), &no);
+            }
+            if (no.numChaves == 0) return true;
+            maiorChave = no.vetorChaves.back();
+            maiorChaveConhecida = true;
+        }
+        return !(key < maiorChave);
+    }
+
     // --- Método Privado de Busca ---
 
-    std::vector<long> search_internal(const KeyType& key) {
+    std::vector<long> search_internal(const KeyType& key, long *blocosLidos) {
         std::vector<long> resultados;
+        Cursor cursor = lowerBound(key);
+        for (; cursor.valido() && cursor.chave() == key; cursor.next()) {
+            resultados.push_back(cursor.apontador());
+        }
+        if (blocosLidos) *blocosLidos += cursor.getBlocosLidos();
+        return resultados; 
+    }
+
+public:
+    // --- Cursor de Varredura ---
+
+    // Percorre as folhas em ordem crescente de chave seguindo 'proximo'.
+    // Com leituraAntecipada > 0, ao entrar em uma folha avisa o S.O. que os
+    // próximos blocos a partir do irmão serão lidos (melhor esforço: só ajuda
+    // quando as folhas foram alocadas em sequência).
+    // Cada cursor conta os blocos que leu, o que permite estatísticas por
+    // consulta mesmo com várias threads lendo a mesma árvore.
+    class Cursor {
+    private:
+        BPlusTree *arvore;
+        No<KeyType> folha;
+        int posicao;
+        int leituraAntecipada;
+        bool ativo;
+        long blocosLidos;
+
+        void carregarNo(long idBloco) {
+            arvore->lerNo(idBloco, &folha);
+            blocosLidos++;
+        }
+
+        // Avança para a próxima folha enquanto a posição estiver além da última chave
+        void ajustar() {
+            while (ativo && posicao >= folha.numChaves) {
+                if (folha.proximo == -1) {
+                    ativo = false;
+                    return;
+                }
+                carregarNo(folha.proximo);
+                posicao = 0;
+                antecipar();
+            }
+        }
+
+        void antecipar() {
+            if (leituraAntecipada > 0 && folha.proximo != -1) {
+                arvore->gerenciador.sugerirLeitura(folha.proximo, leituraAntecipada);
+            }
+        }
+
+        friend class BPlusTree;
+
+    public:
+        Cursor(BPlusTree *arvore, int leituraAntecipada)
+            : arvore(arvore), folha(true), posicao(0), leituraAntecipada(leituraAntecipada), ativo(false), blocosLidos(0) {}
+
+        bool valido() const { return ativo; }
+        long getBlocosLidos() const { return blocosLidos; }
+        const KeyType& chave() const { return folha.vetorChaves[posicao]; }
+        long apontador() const { return folha.vetorApontadores[posicao]; }
+
+        void next() {
+            if (!ativo) return;
+            posicao++;
+            ajustar();
+        }
+    };
+
+    // Posiciona um cursor na primeira chave >= key.
+    Cursor lowerBound(const KeyType& key, int leituraAntecipada = 0) {
+        Cursor cursor(this, leituraAntecipada);
         if (idRaiz == -1) {
-            return resultados; 
+            return cursor;
         }
 
-        No<KeyType> *noAtual = new No<KeyType>();
-        lerNo(idRaiz, noAtual);
+        No<KeyType> *noAtual = &cursor.folha;
+        cursor.carregarNo(idRaiz);
 
-        // 1. Desce até a folha
+        // 1. Desce até a folha. Em caso de igualdade com o separador desce pela esquerda:
+        // uma sequência de chaves repetidas pode ter sido dividida entre duas folhas,
+        // e o cursor segue 'proximo' até a primeira ocorrência à direita.
         while (!noAtual->ehFolha) {
             int i = 0;
-            while (i < noAtual->numChaves && key >= noAtual->vetorChaves[i]) {
-                 if (key == noAtual->vetorChaves[i]) {
-                     i++; 
-                     break; 
-                 }
-                 if (key > noAtual->vetorChaves[i]) {
-                      i++;
-                 } else {
-                     break; 
-                 }
+            while (i < noAtual->numChaves && key > noAtual->vetorChaves[i]) {
+                i++;
             }
             long filhoId = noAtual->vetorApontadores[i]; 
-            lerNo(filhoId, noAtual); 
+            cursor.carregarNo(filhoId); 
         }
 
-        // 2. Varre a(s) folha(s)
+        // 2. Primeira chave >= key na folha (ou nas seguintes)
         int i = 0;
         while (i < noAtual->numChaves && key > noAtual->vetorChaves[i]) {
             i++;
         }
 
-        bool continuarVarrendo = true;
-        while (continuarVarrendo) {
-            while (i < noAtual->numChaves) {
-                if (noAtual->vetorChaves[i] == key) {
-                    resultados.push_back(noAtual->vetorApontadores[i]);
-                    i++; 
-                } else {
-                    continuarVarrendo = false; 
-                    break; 
-                }
-            }
-
-            if (!continuarVarrendo) break;
-
-            if (noAtual->proximo != -1) {
-                lerNo(noAtual->proximo, noAtual);
-                i = 0; 
-            } else {
-                continuarVarrendo = false;
-            }
-        }
-        delete noAtual;
-        return resultados; 
+        cursor.posicao = i;
+        cursor.ativo = true;
+        cursor.antecipar();
+        cursor.ajustar();
+        return cursor;
     }
 
-public:
     // --- Construtor Público ---
     BPlusTree(const std::string &nomeArquivo, const size_t tamanhoBloco_arg)
         : tamanhoBloco(static_cast<int>(tamanhoBloco_arg)), 
           nomeArquivo(nomeArquivo),
           gerenciador(nomeArquivo, tamanhoBloco_arg),
           idRaiz(-1),
-          totalBlocos(0) {
+          totalBlocos(0),
+          cabecalhoAlterado(false),
+          fatorDivisaoDireita(FATOR_DIVISAO_DIREITA_PADRAO),
+          maiorChave(),
+          maiorChaveConhecida(false) {
         try {
             if (gerenciador.getTamanhoArquivo() > 0) {
                 lerCabecalho();
@@ -353,12 +635,21 @@ public:
     }
 
     // --- Destrutor ---
-    ~BPlusTree() {}
+    ~BPlusTree() {
+        try {
+            // Só regrava o cabeçalho se houve inserção: abrir para consulta não altera o arquivo
+            if (cabecalhoAlterado) escreverCabecalho();
+        } catch (const std::exception &e) {
+            // Destrutor não pode propagar exceções.
+        }
+    }
 
     // --- Métodos Públicos de Interface ---
 
     // Inserção
     void insert(const KeyType& key, long dataPointer) {
+        INSTR_TEMPORIZAR("btree.insert");
+        INSTR_SO_INSTRUMENTADO(RegistroDivisoes registroDivisoes(key, totalBlocos);)
         if (idRaiz == -1) {
             No<KeyType> *primeiraRaiz = new No<KeyType>(true);
             primeiraRaiz->selfId = this->getNovoId();
@@ -369,8 +660,11 @@ public:
             escreverNo(primeiraRaiz);
             escreverCabecalho();
             delete primeiraRaiz; 
+            this->maiorChave = key;
+            this->maiorChaveConhecida = true;
             return;
         } else {
+            bool aposMaior = insercaoAposMaior(key);
             No<KeyType> *raizInicial = new No<KeyType>();
             lerNo(this->idRaiz, raizInicial);
 
@@ -387,27 +681,109 @@ public:
                 novaRaiz->vetorApontadores.push_back(this->idRaiz);
                 this->idRaiz = novaRaiz->selfId;
                 escreverCabecalho();
-                splitChild(novaRaiz, 0);
-                insertNonFull(novaRaiz, key, dataPointer);
+                splitChild(novaRaiz, 0, aposMaior);
+                insertNonFull(novaRaiz, key, dataPointer, aposMaior);
                 delete novaRaiz;
             } else {
-                insertNonFull(raizInicial, key, dataPointer);
+                insertNonFull(raizInicial, key, dataPointer, aposMaior);
             }
             delete raizInicial;
+            if (aposMaior) this->maiorChave = key;
         }
     }
 
-    // Busca
-    std::vector<long> search(const KeyType& key) {
-        return search_internal(key);
+    // Busca. Se blocosLidos for informado, soma a ele os blocos lidos por esta consulta.
+    // Somente leitura: pode ser chamada por várias threads ao mesmo tempo (sem inserções concorrentes).
+    std::vector<long> search(const KeyType& key, long *blocosLidos = nullptr) {
+        INSTR_TEMPORIZAR("btree.search");
+        return search_internal(key, blocosLidos);
+    }
+
+    // Busca de um lote de chaves com descida compartilhada (ver buscarVariasChaves).
+    // Somente leitura, como search().
+    std::vector<std::vector<long>> searchLote(const std::vector<KeyType>& chaves, std::vector<long> *blocosPorChave = nullptr) {
+        return buscarVariasChaves<KeyType, No<KeyType>>(idRaiz, chaves, [this](long id, No<KeyType> &no) { lerNo(id, &no); }, blocosPorChave);
+    }
+
+    // Busca passo a passo, para quem intercala várias buscas: comece em getRaiz() e chame
+    // passoBusca() até devolver -1. Cada passo lê um nó. Somente leitura, como search().
+    long getRaiz() const { return idRaiz; }
+    long passoBusca(long idBloco, const KeyType& key, std::vector<long> &resultados) {
+        No<KeyType> no;
+        lerNo(idBloco, &no);
+        return passoDescida(no, key, resultados);
     }
+    // Pede ao S.O. o nó que o próximo passo vai ler (posix_fadvise WILLNEED).
+    void sugerirLeituraNo(long idBloco) const { gerenciador.sugerirLeitura(idBloco, 1); }
 
     // Getters de estatísticas
     long getIndexBlocosLidos() const { return gerenciador.getBlocosLidos(); }
     long getIndexBlocosEscritos() const { return gerenciador.getBlocosEscritos(); }
     long getIndexTotalBlocos() const { return totalBlocos; }
+    int getOrdem() const { return m; }
+
+    // Fração das chaves que fica no nó antigo quando a divisão é na borda direita.
+    // 1.0 (padrão) deixa o nó antigo cheio; 0.5 equivale à divisão ao meio de sempre.
+    void setFatorDivisaoDireita(double fator) {
+        if (fator < 0.5 || fator > 1.0) {
+            throw std::invalid_argument("Erro: O fator de divisao a direita deve estar entre 0.5 e 1.0.");
+        }
+        this->fatorDivisaoDireita = fator;
+    }
+    double getFatorDivisaoDireita() const { return fatorDivisaoDireita; }
+
+    // Percorre a árvore nível a nível contando nós e chaves (lê todos os blocos)
+    EstatisticasArvore calcularEstatisticas() {
+        EstatisticasArvore est;
+        if (idRaiz == -1) return est;
+
+        std::vector<long> nivel(1, idRaiz);
+        No<KeyType> no;
+        while (!nivel.empty()) {
+            std::vector<long> proximoNivel;
+            est.altura++;
+            for (long id : nivel) {
+                lerNo(id, &no);
+                if (no.ehFolha) {
+                    est.numFolhas++;
+                    est.chavesFolhas += no.numChaves;
+                } else {
+                    est.numNosInternos++;
+                    proximoNivel.insert(proximoNivel.end(), no.vetorApontadores.begin(), no.vetorApontadores.end());
+                }
+            }
+            nivel.swap(proximoNivel);
+        }
+        if (est.numFolhas > 0) {
+            est.ocupacaoFolhas = static_cast<double>(est.chavesFolhas) / (static_cast<double>(est.numFolhas) * m);
+        }
+        return est;
+    }
+
+    // Fixa em memória os nós internos dos 'niveis' primeiros níveis (a raiz é o nível 1).
+    // Folhas não são fixadas. Para processos longos, antes de leituras concorrentes.
+    long fixarNiveisSuperiores(int niveis) {
+        long fixados = 0;
+        if (idRaiz == -1) return fixados;
+
+        std::vector<long> nivel(1, idRaiz);
+        No<KeyType> no;
+        for (int n = 0; n < niveis && !nivel.empty(); ++n) {
+            std::vector<long> proximoNivel;
+            for (long id : nivel) {
+                lerNo(id, &no);
+                if (no.ehFolha) continue;
+                gerenciador.fixarBloco(id);
+                fixados++;
+                proximoNivel.insert(proximoNivel.end(), no.vetorApontadores.begin(), no.vetorApontadores.end());
+            }
+            nivel.swap(proximoNivel);
+        }
+        return fixados;
+    }
 
     void flush() {
+        if (cabecalhoAlterado) escreverCabecalho();
         gerenciador.flush();
     }
 };
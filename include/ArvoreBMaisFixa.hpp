@@ -0,0 +1,265 @@
+#ifndef ARVOREBMAIS_FIXA_HPP
+#define ARVOREBMAIS_FIXA_HPP
+
+#include <string>
+#include <vector>
+#include <array>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <algorithm>
+#include <type_traits>
+#include "GerenciadorIndice.hpp"
+#include "ArvoreBMais.hpp"
+
+// --- Variante da BPlusTree com tamanho de página conhecido em compilação ---
+//
+// Lê o mesmo formato de arquivo gravado por BPlusTree<KeyType> (cabeçalho no bloco 0,
+// nós com [ehFolha][numChaves][proximo], chaves e apontadores), mas com a ordem
+// calculada como constexpr a partir de TamanhoPagina. Os nós usam std::array, ficam
+// na pilha e a busca dentro do nó tem limite fixo, sem alocações por bloco lido.
+// É somente leitura: a construção dos índices continua com BPlusTree.
+
+template <typename KeyType, size_t TamanhoPagina>
+struct NoFixo {
+
+    static constexpr size_t TAM_CABECALHO = sizeof(bool) + sizeof(int) + sizeof(long);
+    static constexpr int ORDEM = static_cast<int>((TamanhoPagina - TAM_CABECALHO) / (sizeof(KeyType) + sizeof(long)));
+
+    // Mesmo layout gravado por serializaNo (ArvoreBMais.hpp) (folha com ORDEM chaves e ORDEM apontadores)
+    static_assert(std::is_trivially_copyable<KeyType>::value, "KeyType precisa ser copiavel byte a byte");
+    static_assert(ORDEM >= 3, "Pagina pequena demais para a chave");
+    static_assert(TAM_CABECALHO + ORDEM * (sizeof(KeyType) + sizeof(long)) <= TamanhoPagina, "Folha cheia nao cabe na pagina");
+    static_assert(TAM_CABECALHO + (ORDEM - 1) * sizeof(KeyType) + ORDEM * sizeof(long) <= TamanhoPagina, "No interno cheio nao cabe na pagina");
+    static_assert(sizeof(CabecalhoIndice) <= TamanhoPagina, "Cabecalho nao cabe na pagina");
+
+    bool ehFolha;
+    int numChaves;
+    long proximo;
+    std::array<KeyType, ORDEM> chaves;
+    std::array<long, ORDEM + 1> apontadores;
+
+    NoFixo() : ehFolha(true), numChaves(0), proximo(-1) {}
+
+    const KeyType* chavesNo() const { return chaves.data(); }
+    const long* apontadoresNo() const { return apontadores.data(); }
+
+    // Primeira posição com chave >= key (descida pela esquerda em caso de igualdade)
+    int limiteInferior(const KeyType& key) const {
+        return static_cast<int>(std::lower_bound(chaves.begin(), chaves.begin() + numChaves, key) - chaves.begin());
+    }
+
+};
+
+template <typename KeyType, size_t TamanhoPagina>
+class BPlusTreeFixa {
+private:
+    using NoT = NoFixo<KeyType, TamanhoPagina>;
+
+    std::string nomeArquivo;
+    GerenciadorIndice gerenciador;
+    long idRaiz;
+    long totalBlocos;
+
+    // Lê e decodifica um nó. O buffer da página fica na pilha.
+    void lerNo(long idBloco, NoT &no) const {
+        alignas(8) char buffer[TamanhoPagina];
+        gerenciador.lerBloco(idBloco, buffer);
+
+        const char *ptr = buffer;
+        memcpy(&no.ehFolha, ptr, sizeof(bool));
+        ptr += sizeof(bool);
+        memcpy(&no.numChaves, ptr, sizeof(int));
+        ptr += sizeof(int);
+        memcpy(&no.proximo, ptr, sizeof(long));
+        ptr += sizeof(long);
+
+        int maxChaves = no.ehFolha ? NoT::ORDEM : NoT::ORDEM - 1;
+        if (no.numChaves < 0 || no.numChaves > maxChaves) {
+            throw std::runtime_error("Erro: No corrompido no bloco " + std::to_string(idBloco) + " de " + nomeArquivo);
+        }
+
+        memcpy(no.chaves.data(), ptr, no.numChaves * sizeof(KeyType));
+        ptr += no.numChaves * sizeof(KeyType);
+        memcpy(no.apontadores.data(), ptr, (no.ehFolha ? no.numChaves : no.numChaves + 1) * sizeof(long));
+    }
+
+public:
+    static constexpr int ORDEM = NoT::ORDEM;
+    static constexpr size_t TAMANHO_PAGINA = TamanhoPagina;
+
+    // --- Cursor de Varredura (mesma interface de BPlusTree::Cursor) ---
+    class Cursor {
+    private:
+        const BPlusTreeFixa *arvore;
+        NoT folha;
+        int posicao;
+        int leituraAntecipada;
+        bool ativo;
+        long blocosLidos;
+
+        void carregarNo(long idBloco) {
+            arvore->lerNo(idBloco, folha);
+            blocosLidos++;
+        }
+
+        void ajustar() {
+            while (ativo && posicao >= folha.numChaves) {
+                if (folha.proximo == -1) {
+                    ativo = false;
+                    return;
+                }
+                carregarNo(folha.proximo);
+                posicao = 0;
+                antecipar();
+            }
+        }
+
+        void antecipar() {
+            if (leituraAntecipada > 0 && folha.proximo != -1) {
+                arvore->gerenciador.sugerirLeitura(folha.proximo, leituraAntecipada);
+            }
+        }
+
+        friend class BPlusTreeFixa;
+
+    public:
+        Cursor(const BPlusTreeFixa *arvore, int leituraAntecipada)
+            : arvore(arvore), posicao(0), leituraAntecipada(leituraAntecipada), ativo(false), blocosLidos(0) {}
+
+        bool valido() const { return ativo; }
+        long getBlocosLidos() const { return blocosLidos; }
+        const KeyType& chave() const { return folha.chaves[posicao]; }
+        long apontador() const { return folha.apontadores[posicao]; }
+
+        void next() {
+            if (!ativo) return;
+            posicao++;
+            ajustar();
+        }
+    };
+
+    // --- Construtor Público ---
+    explicit BPlusTreeFixa(const std::string &nomeArquivo)
+        : nomeArquivo(nomeArquivo),
+          gerenciador(nomeArquivo, TamanhoPagina),
+          idRaiz(-1),
+          totalBlocos(0) {
+        if (gerenciador.getTamanhoArquivo() <= 0) {
+            throw std::runtime_error("Erro: Indice vazio ou inexistente: " + nomeArquivo);
+        }
+
+        alignas(8) char buffer[TamanhoPagina];
+        gerenciador.lerBloco(0, buffer);
+        CabecalhoIndice hdr;
+        memcpy(&hdr, buffer, sizeof(CabecalhoIndice));
+
+        if (hdr.tamanhoBloco != static_cast<long>(TamanhoPagina)) {
+            throw std::runtime_error("Erro: O tamanho do bloco fornecido é inconsistente com o do arquivo!");
+        }
+
+        this->idRaiz = hdr.idRaiz;
+        this->totalBlocos = hdr.numBlocos;
+    }
+
+    // Posiciona um cursor na primeira chave >= key.
+    Cursor lowerBound(const KeyType& key, int leituraAntecipada = 0) const {
+        Cursor cursor(this, leituraAntecipada);
+        if (idRaiz == -1) {
+            return cursor;
+        }
+
+        cursor.carregarNo(idRaiz);
+
+        // Desce pela esquerda em caso de igualdade, como em BPlusTree::lowerBound
+        while (!cursor.folha.ehFolha) {
+            cursor.carregarNo(cursor.folha.apontadores[cursor.folha.limiteInferior(key)]);
+        }
+
+        cursor.posicao = cursor.folha.limiteInferior(key);
+        cursor.ativo = true;
+        cursor.antecipar();
+        cursor.ajustar();
+        return cursor;
+    }
+
+    // Busca. Se blocosLidos for informado, soma a ele os blocos lidos por esta consulta.
+    // Somente leitura: pode ser chamada por várias threads ao mesmo tempo.
+    std::vector<long> search(const KeyType& key, long *blocosLidos = nullptr) const {
+        std::vector<long> resultados;
+        Cursor cursor = lowerBound(key);
+        for (; cursor.valido() && cursor.chave() == key; cursor.next()) {
+            resultados.push_back(cursor.apontador());
+        }
+        if (blocosLidos) *blocosLidos += cursor.getBlocosLidos();
+        return resultados;
+    }
+
+    // Busca de um lote de chaves com descida compartilhada (ver buscarVariasChaves).
+    std::vector<std::vector<long>> searchLote(const std::vector<KeyType>& chaves, std::vector<long> *blocosPorChave = nullptr) const {
+        return buscarVariasChaves<KeyType, NoT>(idRaiz, chaves, [this](long id, NoT &no) { lerNo(id, no); }, blocosPorChave);
+    }
+
+    // Busca passo a passo, como BPlusTree::passoBusca.
+    long getRaiz() const { return idRaiz; }
+    long passoBusca(long idBloco, const KeyType& key, std::vector<long> &resultados) const {
+        NoT no;
+        lerNo(idBloco, no);
+        return passoDescida(no, key, resultados);
+    }
+    void sugerirLeituraNo(long idBloco) const { gerenciador.sugerirLeitura(idBloco, 1); }
+
+    // Fixa em memória os nós internos dos 'niveis' primeiros níveis, como BPlusTree::fixarNiveisSuperiores.
+    long fixarNiveisSuperiores(int niveis) {
+        long fixados = 0;
+        if (idRaiz == -1) return fixados;
+
+        std::vector<long> nivel(1, idRaiz);
+        NoT no;
+        for (int n = 0; n < niveis && !nivel.empty(); ++n) {
+            std::vector<long> proximoNivel;
+            for (long id : nivel) {
+                lerNo(id, no);
+                if (no.ehFolha) continue;
+                gerenciador.fixarBloco(id);
+                fixados++;
+                proximoNivel.insert(proximoNivel.end(), no.apontadores.begin(), no.apontadores.begin() + no.numChaves + 1);
+            }
+            nivel.swap(proximoNivel);
+        }
+        return fixados;
+    }
+
+    // Getters de estatísticas
+    long getIndexBlocosLidos() const { return gerenciador.getBlocosLidos(); }
+    long getIndexBlocosEscritos() const { return gerenciador.getBlocosEscritos(); }
+    long getIndexTotalBlocos() const { return totalBlocos; }
+    int getOrdem() const { return ORDEM; }
+};
+
+// Abre o índice para leitura com a variante de página fixa correspondente ao tamanho
+// de bloco (4K, 8K ou 16K) e chama funcao(arvore). Outros tamanhos usam a BPlusTree
+// de ordem calculada em tempo de execução. A escolha é feita uma única vez, na abertura.
+template <typename KeyType, typename Funcao>
+auto abrirArvoreLeitura(const std::string &nomeArquivo, size_t tamanhoBloco, Funcao funcao) {
+    switch (tamanhoBloco) {
+        case 4096: {
+            BPlusTreeFixa<KeyType, 4096> arvore(nomeArquivo);
+            return funcao(arvore);
+        }
+        case 8192: {
+            BPlusTreeFixa<KeyType, 8192> arvore(nomeArquivo);
+            return funcao(arvore);
+        }
+        case 16384: {
+            BPlusTreeFixa<KeyType, 16384> arvore(nomeArquivo);
+            return funcao(arvore);
+        }
+        default: {
+            BPlusTree<KeyType> arvore(nomeArquivo, tamanhoBloco);
+            return funcao(arvore);
+        }
+    }
+}
+
+#endif // ARVOREBMAIS_FIXA_HPP
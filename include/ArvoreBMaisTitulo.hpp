@@ -0,0 +1,293 @@
+#ifndef ARVOREBMAIS_TITULO_HPP
+#define ARVOREBMAIS_TITULO_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "GerenciadorIndice.hpp"
+
+/**
+ * @struct CamposIncluidos
+ * @brief Colunas copiadas para a folha do índice de títulos (índice de cobertura).
+ *
+ * Com elas o seek2 responde consultas que só pedem id, ano e citações sem ler artigos.dat.
+ */
+#pragma pack(push, 1)
+struct CamposIncluidos {
+
+    int id;
+    int ano;
+    int citacoes;
+
+};
+#pragma pack(pop)
+
+/**
+ * @struct ListaPostagem
+ * @brief Apontadores (IDs de bucket) de uma chave da folha.
+ *
+ * Cada título aparece uma única vez na folha. Até LIMITE_INLINE apontadores ficam
+ * na própria folha; acima disso ficam em uma cadeia de páginas de excedente e a
+ * folha guarda apenas o total e a primeira página da cadeia.
+ */
+struct ListaPostagem {
+
+    static const int LIMITE_INLINE = 16;
+
+    int total;                     // quantidade de apontadores da chave
+    std::vector<long> apontadores; // apontadores na folha (vazio quando há excedente)
+    std::vector<CamposIncluidos> campos; // paralelo a 'apontadores' quando a árvore inclui campos
+    long paginaExcedente;          // primeira página da cadeia de excedente, ou -1
+
+    ListaPostagem() : total(0), paginaExcedente(-1) {}
+
+};
+
+/**
+ * @struct NoTitulo
+ * @brief Nó da árvore B+ de títulos mantido em memória com as chaves completas.
+ *
+ * No disco as chaves têm tamanho variável: o prefixo comum a todas as chaves do
+ * nó é gravado uma única vez e cada chave guarda apenas o seu sufixo.
+ * Nas folhas as chaves são únicas e cada uma tem a sua lista de postagem;
+ * 'vetorApontadores' é usado apenas pelos nós internos.
+ */
+struct NoTitulo {
+
+    bool ehFolha;
+    long proximo;
+    long selfId;
+    std::vector<std::string> vetorChaves;
+    std::vector<long> vetorApontadores;
+    std::vector<ListaPostagem> postagens;
+
+    NoTitulo(bool ehFolha = false) : ehFolha(ehFolha), proximo(-1), selfId(-1) {}
+
+};
+
+/**
+ * @class BPlusTreeTitulo
+ * @brief Árvore B+ do índice secundário de títulos com chaves de tamanho variável.
+ *
+ * Bloco 0: CabecalhoIndice seguido de [assinatura "TITULOVL":8][versao:4][camposIncluidos:1].
+ * Arquivos sem a assinatura (versões anteriores) são recusados na abertura.
+ *
+ * Formato da página (mesmo cabeçalho de 13 bytes de No<KeyType>):
+ *   [ehFolha:1][numChaves:4][proximo:8][tamPrefixo:2][prefixo]
+ *   numChaves x [tamSufixo:2][sufixo]
+ *   nós internos: numChaves + 1 apontadores
+ *   folhas: numChaves x [total:4] seguido de 'total' entradas (total <= LIMITE_INLINE)
+ *           ou da primeira página de excedente:8
+ *
+ * Cada entrada é o apontador:8, seguido de [id:4][ano:4][citacoes:4] quando a árvore
+ * foi criada com campos incluídos (índice de cobertura).
+ *
+ * Página de excedente: [numApontadores:4][proxima:8] e as entradas. Novas páginas
+ * entram no início da cadeia, então inserir em uma lista grande custa uma leitura e
+ * uma escrita de página, e ler a lista é uma sequência de páginas cheias.
+ *
+ * Os separadores promovidos de folhas são truncados para o menor prefixo que
+ * ainda distingue as duas folhas. Como os nós enchem por bytes e não por número
+ * de chaves, a inserção é feita de baixo para cima: o nó é dividido somente
+ * quando a versão serializada deixa de caber no bloco.
+ */
+class BPlusTreeTitulo {
+
+    private:
+        size_t tamanhoBloco;
+        bool incluirCampos;
+        size_t tamanhoEntrada; // bytes de uma entrada da lista de postagem
+        std::string nomeArquivo;
+        GerenciadorIndice gerenciador;
+        long idRaiz;
+        long totalBlocos;
+        bool cabecalhoAlterado; // idRaiz ou totalBlocos mudaram desde a última gravação do bloco 0
+
+        void escreverCabecalho();
+        void lerCabecalho();
+
+        void escreverNo(const NoTitulo& no);
+        void lerNo(long idBloco, NoTitulo& no) const;
+
+        /**
+         * @brief Acrescenta um apontador à lista, movendo-a para páginas de excedente quando passa de LIMITE_INLINE.
+         * @param campos Colunas incluídas do registro (obrigatório quando a árvore inclui campos).
+         */
+        void adicionarPostagem(ListaPostagem& lista, long dataPointer, const CamposIncluidos* campos);
+
+        /**
+         * @brief Copia todos os apontadores da lista (inline ou da cadeia de excedente) para 'destino'.
+         * @param campos Se informado (e a árvore incluir campos), recebe as colunas incluídas de cada entrada.
+         * @return O número de páginas de excedente lidas.
+         */
+        long lerPostagem(const ListaPostagem& lista, std::vector<long>& destino, std::vector<CamposIncluidos>* campos = nullptr) const;
+
+        long getNovoId();
+
+        /**
+         * @brief Bytes que a lista de postagem ocupa na folha.
+         */
+        size_t tamanhoPostagem(const ListaPostagem& lista) const;
+
+        /**
+         * @brief Escolhe o ponto de divisão de um nó cheio equilibrando os bytes das duas metades.
+         */
+        size_t escolherPontoDivisao(const NoTitulo& no) const;
+
+        /**
+         * @brief Divide um nó que não cabe mais no bloco.
+         * @param no O nó cheio (fica com a metade esquerda).
+         * @param separador Recebe a chave que deve subir para o pai.
+         * @param idNovoIrmao Recebe o ID do novo nó (metade direita).
+         */
+        void dividirNo(NoTitulo& no, std::string& separador, long& idNovoIrmao);
+
+        /**
+         * @brief Insere recursivamente a partir do nó informado.
+         * @return 'true' se o nó foi dividido; nesse caso separador e idNovoIrmao são preenchidos.
+         */
+        bool insertRecursivo(long idNo, const std::string& chave, long dataPointer, const CamposIncluidos* campos, std::string& separador, long& idNovoIrmao);
+
+    public:
+        /**
+         * @class Cursor
+         * @brief Percorre as folhas em ordem crescente de título seguindo 'proximo'.
+         *
+         * Visita cada apontador de cada chave: chave() se repete enquanto a lista de
+         * postagem da chave não termina. Com leituraAntecipada > 0, ao entrar em uma folha
+         * avisa o S.O. que os próximos blocos a partir do irmão serão lidos (melhor esforço).
+         * Cada cursor conta os blocos que leu (folhas e excedentes), permitindo
+         * estatísticas por consulta com várias threads.
+         */
+        class Cursor {
+
+            private:
+                const BPlusTreeTitulo* arvore;
+                NoTitulo folha;
+                size_t posicao;
+                std::vector<long> postagem;
+                std::vector<CamposIncluidos> campos;
+                size_t posicaoPostagem;
+                int leituraAntecipada;
+                bool ativo;
+                long blocosLidos;
+
+                void carregarNo(long idBloco);
+                void carregarPostagem();
+                void ajustar();
+                void antecipar();
+
+                friend class BPlusTreeTitulo;
+
+            public:
+                Cursor(const BPlusTreeTitulo* arvore, int leituraAntecipada)
+                    : arvore(arvore), folha(true), posicao(0), posicaoPostagem(0), leituraAntecipada(leituraAntecipada), ativo(false), blocosLidos(0) {}
+
+                bool valido() const { return ativo; }
+                long getBlocosLidos() const { return blocosLidos; }
+                const std::string& chave() const { return folha.vetorChaves[posicao]; }
+                long apontador() const { return postagem[posicaoPostagem]; }
+
+                /**
+                 * @brief Todos os apontadores da chave atual.
+                 */
+                const std::vector<long>& postagens() const { return postagem; }
+
+                /**
+                 * @brief Colunas incluídas do apontador atual / de todos os apontadores da chave atual.
+                 * Disponíveis apenas quando a árvore inclui campos.
+                 */
+                const CamposIncluidos& camposIncluidos() const { return campos[posicaoPostagem]; }
+                const std::vector<CamposIncluidos>& postagensIncluidas() const { return campos; }
+
+                void next();
+
+                /**
+                 * @brief Pula os apontadores restantes da chave atual e vai para a próxima chave.
+                 */
+                void proximaChave();
+
+        };
+
+        /**
+         * @brief Tamanho máximo de uma chave (mesmo limite do campo Artigo::titulo).
+         */
+        static const size_t TAMANHO_MAX_CHAVE = 299;
+
+        /**
+         * @brief Construtor. Abre o arquivo de índice existente ou cria um novo.
+         * @param nomeArquivo O caminho para o arquivo de índice.
+         * @param tamanhoBloco O tamanho do bloco (página) em bytes.
+         * @param incluirCampos Se as folhas guardam CamposIncluidos junto de cada apontador (gravado em db.meta).
+         * @throws std::runtime_error Se o bloco for pequeno demais, inconsistente com o arquivo, ou se o
+         * arquivo não tiver a assinatura e a versão atuais (gravado por uma versão anterior).
+         */
+        BPlusTreeTitulo(const std::string& nomeArquivo, size_t tamanhoBloco, bool incluirCampos = false);
+
+        /**
+         * @brief Destrutor. Persiste o cabeçalho com o total de blocos atualizado, se a árvore foi alterada.
+         */
+        ~BPlusTreeTitulo();
+
+        /**
+         * @brief Calcula quantos bytes o nó ocupa depois de serializado.
+         */
+        size_t tamanhoSerializado(const NoTitulo& no) const;
+
+        /**
+         * @brief Codifica e decodifica uma página no formato descrito acima (usados por
+         * escreverNo/lerNo; públicos para o bench_micro medir o custo de cada página).
+         */
+        void serializaNo(const NoTitulo& no, char* buffer) const;
+        void deserializaNo(const char* buffer, NoTitulo& no) const;
+
+        /**
+         * @brief Insere uma chave (truncada em TAMANHO_MAX_CHAVE bytes) apontando para um bucket de dados.
+         * @param campos Colunas incluídas do registro; obrigatório quando a árvore inclui campos.
+         * @throws std::invalid_argument Se a árvore inclui campos e 'campos' não foi informado.
+         */
+        void insert(const std::string& chave, long dataPointer, const CamposIncluidos* campos = nullptr);
+
+        /**
+         * @brief Busca todas as ocorrências exatas de uma chave: uma descida e a leitura da lista de postagem.
+         * Somente leitura: pode ser chamada por várias threads ao mesmo tempo (sem inserções concorrentes).
+         * @param chave O título buscado.
+         * @param blocosLidos Se informado, recebe a soma dos blocos lidos por esta consulta.
+         * @return Os apontadores (IDs de bucket) associados à chave.
+         */
+        std::vector<long> search(const std::string& chave, long* blocosLidos = nullptr) const;
+
+        /**
+         * @brief Busca as colunas incluídas de todos os registros com a chave, sem consultar o arquivo de dados.
+         * @throws std::runtime_error Se a árvore não foi criada com campos incluídos.
+         */
+        std::vector<CamposIncluidos> searchIncluidos(const std::string& chave, long* blocosLidos = nullptr) const;
+
+        bool temCamposIncluidos() const { return incluirCampos; }
+
+        /**
+         * @brief Posiciona um cursor no primeiro título >= chave.
+         * @param chave O título (ou prefixo) inicial.
+         * @param leituraAntecipada Quantos blocos a partir da próxima folha sugerir ao S.O.
+         */
+        Cursor lowerBound(const std::string& chave, int leituraAntecipada = 0) const;
+
+        /**
+         * @brief Fixa em memória os nós internos dos 'niveis' primeiros níveis (a raiz é o nível 1).
+         * Não é thread-safe: deve ser chamado antes das leituras concorrentes.
+         * @return A quantidade de blocos fixados.
+         */
+        long fixarNiveisSuperiores(int niveis);
+
+        // Getters de estatísticas
+        long getIndexBlocosLidos() const { return gerenciador.getBlocosLidos(); }
+        long getIndexBlocosEscritos() const { return gerenciador.getBlocosEscritos(); }
+        long getIndexTotalBlocos() const { return totalBlocos; }
+
+        void flush();
+
+};
+
+#endif // ARVOREBMAIS_TITULO_HPP
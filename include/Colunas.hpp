@@ -0,0 +1,215 @@
+#ifndef COLUNAS_HPP
+#define COLUNAS_HPP
+
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+#include "Artigo.hpp"
+
+/**
+ * Arquivos colunares gravados pelo upload com --colunas (em /data/db/colunas/): um vetor
+ * denso por campo "quente" (id, ano, citacoes e o bucket de artigos.dat onde o registro
+ * está, e opcionalmente a atualizacao em segundos desde 1970), todos na ordem de inserção.
+ * A linha i de cada coluna é o mesmo registro.
+ *
+ * Uma agregação como "citações por ano" lê 6 bytes por registro (ano e citacoes) em vez dos 4 KiB do
+ * bucket, e os laços de filtro sobre vetores contíguos são vetorizados pelo compilador.
+ */
+
+/**
+ * @enum Coluna
+ * @brief Colunas do arquivo colunar. Cada uma fica em <diretorio>/<nome>.col.
+ */
+enum class Coluna {
+
+    ID = 0,       // int32_t
+    ANO,          // int16_t
+    CITACOES,     // int32_t
+    BUCKET,       // uint32_t: bloco de artigos.dat (primário ou de overflow)
+    ATUALIZACAO,  // int64_t: segundos desde 1970-01-01 (UTC); 0 se vazia (opcional)
+
+    NUM_COLUNAS
+
+};
+
+const size_t NUM_COLUNAS = static_cast<size_t>(Coluna::NUM_COLUNAS);
+
+/**
+ * @brief Nome da coluna ("id", "ano", ...), também usado no nome do arquivo.
+ */
+const char* nomeColuna(Coluna coluna);
+
+/**
+ * @brief Bytes por valor da coluna.
+ */
+size_t larguraColuna(Coluna coluna);
+
+/**
+ * @struct CabecalhoColuna
+ * @brief Primeiros 64 bytes de cada arquivo .col; os valores começam logo depois, alinhados
+ * a 64 bytes no mapeamento. 'linhas' é atualizado a cada checkpoint e no fim do upload.
+ */
+#pragma pack(push, 1)
+struct CabecalhoColuna {
+
+    char assinatura[8];  // "COLUNA01"
+    uint32_t versao;
+    uint32_t largura;    // bytes por valor
+    uint64_t linhas;
+    char nome[16];
+    uint8_t reservado[24];
+
+};
+#pragma pack(pop)
+
+static_assert(sizeof(CabecalhoColuna) == 64, "CabecalhoColuna deve ter 64 bytes");
+
+/**
+ * @brief Converte "AAAA-MM-DD hh:mm:ss" (ou só "AAAA-MM-DD") em segundos desde 1970-01-01 UTC.
+ * @return 'false' se o texto não estiver nesse formato.
+ */
+bool epochDeData(std::string_view texto, int64_t& segundos);
+
+/**
+ * @class EscritorColunas
+ * @brief Acrescenta uma linha por registro inserido pelo upload às colunas.
+ */
+class EscritorColunas {
+
+    private:
+        std::string diretorio;
+        bool com_atualizacao;
+        uint64_t linhas;
+        std::ofstream arquivos[NUM_COLUNAS];
+        std::unique_ptr<char[]> buffers[NUM_COLUNAS];
+
+        void escreverValor(Coluna coluna, const void* valor);
+
+    public:
+        /**
+         * @brief Cria o diretório (se preciso) e as colunas vazias, apagando as anteriores.
+         * @param com_atualizacao Grava também a coluna ATUALIZACAO.
+         * @throws std::runtime_error se algum arquivo não puder ser criado.
+         */
+        EscritorColunas(const std::string& diretorio, bool com_atualizacao);
+
+        /**
+         * @brief Destrutor. Sincroniza as colunas (como sincronizar()).
+         */
+        ~EscritorColunas();
+
+        EscritorColunas(const EscritorColunas&) = delete;
+        EscritorColunas& operator=(const EscritorColunas&) = delete;
+
+        void acrescentar(const Artigo& artigo, size_t bucket);
+
+        /**
+         * @brief Descarrega os buffers e grava o número de linhas nos cabeçalhos (checkpoint).
+         */
+        void sincronizar();
+
+        uint64_t getLinhas() const { return linhas; }
+
+        /**
+         * @brief Total de bytes das colunas (cabeçalhos incluídos).
+         */
+        uint64_t getBytes() const;
+
+};
+
+/**
+ * @class LeitorColunas
+ * @brief Mapeia (somente leitura) as colunas gravadas por EscritorColunas.
+ *
+ * Os ponteiros devolvidos valem enquanto o leitor existir. As colunas ID, ANO, CITACOES
+ * e BUCKET são obrigatórias; ATUALIZACAO só existe se o upload usou --colunas-atualizacao.
+ */
+class LeitorColunas {
+
+    private:
+        const char* mapas[NUM_COLUNAS];
+        size_t tamanhos[NUM_COLUNAS];
+        uint64_t linhas;
+
+        void liberar();
+
+    public:
+        /**
+         * @throws std::runtime_error se uma coluna obrigatória faltar ou estiver corrompida.
+         */
+        explicit LeitorColunas(const std::string& diretorio);
+        ~LeitorColunas();
+
+        LeitorColunas(const LeitorColunas&) = delete;
+        LeitorColunas& operator=(const LeitorColunas&) = delete;
+
+        uint64_t getLinhas() const { return linhas; }
+
+        bool temColuna(Coluna coluna) const { return mapas[static_cast<size_t>(coluna)] != nullptr; }
+
+        const int32_t* ids() const { return valores<int32_t>(Coluna::ID); }
+        const int16_t* anos() const { return valores<int16_t>(Coluna::ANO); }
+        const int32_t* citacoes() const { return valores<int32_t>(Coluna::CITACOES); }
+        const uint32_t* buckets() const { return valores<uint32_t>(Coluna::BUCKET); }
+        const int64_t* atualizacoes() const { return valores<int64_t>(Coluna::ATUALIZACAO); }
+
+        /**
+         * @brief Sugere ao S.O. leitura sequencial e antecipada da coluna (madvise).
+         */
+        void aconselharSequencial(Coluna coluna) const;
+
+        template <typename T>
+        const T* valores(Coluna coluna) const {
+
+            const char* mapa = mapas[static_cast<size_t>(coluna)];
+
+            return mapa == nullptr ? nullptr : reinterpret_cast<const T*>(mapa + sizeof(CabecalhoColuna));
+
+        }
+
+};
+
+/**
+ * @struct FiltroColunas
+ * @brief Predicados aplicados a cada linha pela agregação (todos devem valer).
+ */
+struct FiltroColunas {
+
+    int16_t ano_min = INT16_MIN;
+    int16_t ano_max = INT16_MAX;
+    int32_t citacoes_min = INT32_MIN;
+    int64_t atualizado_desde = INT64_MIN; // exige a coluna ATUALIZACAO se for usado
+
+    bool usaAtualizacao() const { return atualizado_desde != INT64_MIN; }
+
+};
+
+/**
+ * @struct AgregadoAno
+ * @brief Acumuladores de um ano: linhas aceitas, soma e máximo de citações.
+ */
+struct AgregadoAno {
+
+    uint64_t registros = 0;
+    int64_t soma_citacoes = 0;
+    int32_t max_citacoes = INT32_MIN;
+
+};
+
+// Um acumulador por valor possível de int16_t; o ano a fica em [a - INT16_MIN]
+const size_t NUM_ANOS_AGREGADOS = 65536;
+
+/**
+ * @brief Filtra as linhas [de, ate) e soma cada linha aceita ao acumulador do seu ano.
+ * @param por_ano Vetor de NUM_ANOS_AGREGADOS acumuladores (um por thread).
+ * @param linhas_aceitas Se não for nulo, recebe os índices das linhas aceitas, em ordem.
+ */
+void agregarColunas(const LeitorColunas& colunas, const FiltroColunas& filtro, uint64_t de, uint64_t ate,
+                    AgregadoAno* por_ano, std::vector<uint64_t>* linhas_aceitas = nullptr);
+
+#endif // COLUNAS_HPP
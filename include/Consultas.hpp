@@ -0,0 +1,299 @@
+#ifndef CONSULTAS_HPP
+#define CONSULTAS_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <utility>
+#include <algorithm>
+
+#include "Artigo.hpp"
+#include "ArtigoView.hpp"
+#include "ArquivoHashEstatico.hpp"
+#include "ArvoreBMais.hpp"
+#include "IndiceTitulo.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "BlocoDeDados.hpp"
+#include "SondagemIntercalada.hpp"
+
+/**
+ * @struct ResultadoConsulta
+ * @brief Registros encontrados por uma consulta e os blocos lidos somente por ela.
+ *
+ * Os contadores são por consulta (e não os totais dos gerenciadores), então continuam
+ * corretos quando várias consultas rodam em paralelo no ExecutorConsultas.
+ *
+ * Os registros são visões dos buckets mapeados (ArtigoView), sem cópia: valem enquanto o
+ * GerenciadorArquivoDados da consulta existir.
+ */
+struct ResultadoConsulta {
+
+    std::vector<ArtigoView> registros;
+    long blocos_indice = 0;
+    long blocos_dados = 0;
+
+};
+
+/**
+ * @brief Consulta do findrec: percorre o bucket do ID e a sua cadeia de overflow em artigos.dat.
+ * Somente leitura e thread-safe.
+ */
+inline ResultadoConsulta consultarPorHash(ArquivoHashEstatico& arquivo_hash, int id) {
+
+    ResultadoConsulta resultado;
+
+    std::optional<ArtigoView> artigo = arquivo_hash.buscar(id, &resultado.blocos_dados);
+
+    if (artigo) {
+
+        resultado.registros.push_back(*artigo);
+
+    }
+
+    return resultado;
+
+}
+
+/**
+ * @brief Consulta do seek1: busca o ID no índice primário e lê o registro no bucket apontado.
+ * Somente leitura e thread-safe.
+ * @tparam ArvoreId BPlusTree<int> ou BPlusTreeFixa<int, N> (ver abrirArvoreLeitura).
+ */
+template <typename ArvoreId>
+ResultadoConsulta consultarPorId(ArvoreId& btree_id, GerenciadorArquivoDados& dados, int id) {
+
+    ResultadoConsulta resultado;
+
+    // 1. Busca no índice a localização (bucket ID) do registro
+    std::vector<long> ids_bucket = btree_id.search(id, &resultado.blocos_indice);
+
+    if (ids_bucket.empty()) {
+
+        return resultado;
+
+    }
+
+    // 2. Busca o bucket no arquivo de DADOS e procura o registro
+    BlocoDeDados* bucket = static_cast<BlocoDeDados*>(dados.getPonteiroBloco(ids_bucket[0]));
+    resultado.blocos_dados++;
+
+    for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+        if (bucket->registros[i].id == id) {
+
+            resultado.registros.push_back(bucket->registros[i]);
+
+            break;
+
+        }
+
+    }
+
+    return resultado;
+
+}
+
+/**
+ * @brief Lote de consultas do findrec agrupadas por bucket (ArquivoHashEstatico::buscarLote).
+ * Os resultados saem na ordem de 'ids'; cada bloco lido é contado em uma única consulta.
+ */
+inline std::vector<ResultadoConsulta> consultarPorHashLote(ArquivoHashEstatico& arquivo_hash, const std::vector<int>& ids) {
+
+    std::vector<long> blocos;
+    std::vector<std::optional<ArtigoView>> artigos = arquivo_hash.buscarLote(ids, &blocos);
+    std::vector<ResultadoConsulta> resultados(ids.size());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+
+        resultados[i].blocos_dados = blocos[i];
+
+        if (artigos[i]) {
+
+            resultados[i].registros.push_back(*artigos[i]);
+
+        }
+
+    }
+
+    return resultados;
+
+}
+
+/**
+ * @brief Lote de consultas do seek1: uma descida compartilhada no índice primário (searchLote)
+ * e leitura dos buckets em ordem, cada bucket distinto uma única vez, com madvise das faixas
+ * contíguas. Os resultados saem na ordem de 'ids'; cada bloco lido é contado em uma única consulta.
+ */
+template <typename ArvoreId>
+std::vector<ResultadoConsulta> consultarPorIdLote(ArvoreId& btree_id, GerenciadorArquivoDados& dados, const std::vector<int>& ids) {
+
+    std::vector<long> blocos_indice;
+    std::vector<std::vector<long>> ids_bucket = btree_id.searchLote(ids, &blocos_indice);
+    std::vector<ResultadoConsulta> resultados(ids.size());
+
+    // (bucket, consulta) das consultas encontradas no índice, em ordem de bucket
+    std::vector<std::pair<long, size_t>> ordem;
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+
+        resultados[i].blocos_indice = blocos_indice[i];
+
+        if (!ids_bucket[i].empty()) {
+
+            ordem.emplace_back(ids_bucket[i][0], i);
+
+        }
+
+    }
+
+    std::sort(ordem.begin(), ordem.end());
+
+    for (size_t i = 0; i < ordem.size();) {
+
+        size_t j = i + 1;
+
+        while (j < ordem.size() && ordem[j].first <= ordem[j - 1].first + 1) {
+
+            j++;
+
+        }
+
+        dados.sugerirLeitura(ordem[i].first, ordem[j - 1].first - ordem[i].first + 1);
+        i = j;
+
+    }
+
+    BlocoDeDados* bucket = nullptr;
+
+    for (size_t k = 0; k < ordem.size(); ++k) {
+
+        const size_t i = ordem[k].second;
+
+        if (k == 0 || ordem[k].first != ordem[k - 1].first) {
+
+            bucket = static_cast<BlocoDeDados*>(dados.getPonteiroBloco(ordem[k].first));
+            resultados[i].blocos_dados++;
+
+        }
+
+        for (size_t r = 0; r < bucket->contador_registros; ++r) {
+
+            if (bucket->registros[r].id == ids[i]) {
+
+                resultados[i].registros.push_back(bucket->registros[r]);
+
+                break;
+
+            }
+
+        }
+
+    }
+
+    return resultados;
+
+}
+
+/**
+ * @brief Lote de consultas do findrec com sondagens intercaladas (ArquivoHashEstatico::buscarIntercalado).
+ * Os blocos lidos por consulta são os mesmos de consultarPorHash.
+ */
+inline std::vector<ResultadoConsulta> consultarPorHashIntercalado(ArquivoHashEstatico& arquivo_hash, const std::vector<int>& ids, size_t largura) {
+
+    std::vector<long> blocos;
+    std::vector<std::optional<ArtigoView>> artigos = arquivo_hash.buscarIntercalado(ids, largura, &blocos);
+    std::vector<ResultadoConsulta> resultados(ids.size());
+
+    for (size_t i = 0; i < ids.size(); ++i) {
+
+        resultados[i].blocos_dados = blocos[i];
+
+        if (artigos[i]) {
+
+            resultados[i].registros.push_back(*artigos[i]);
+
+        }
+
+    }
+
+    return resultados;
+
+}
+
+/**
+ * @brief Corrotina de consultarPorId: desce o índice primário um nó por vez (passoBusca) e
+ * lê o bucket apontado, sugerindo cada bloco ao S.O. e suspendendo antes de lê-lo.
+ */
+template <typename ArvoreId>
+Sondagem sondarPorId(ArvoreId& btree_id, GerenciadorArquivoDados& dados, int id, ResultadoConsulta& resultado) {
+
+    std::vector<long> ids_bucket;
+
+    for (long bloco = btree_id.getRaiz(); bloco != -1;) {
+
+        btree_id.sugerirLeituraNo(bloco);
+
+        co_await std::suspend_always{};
+
+        bloco = btree_id.passoBusca(bloco, id, ids_bucket);
+        resultado.blocos_indice++;
+
+    }
+
+    if (ids_bucket.empty()) {
+
+        co_return;
+
+    }
+
+    dados.anteciparBloco(ids_bucket[0]);
+
+    co_await std::suspend_always{};
+
+    BlocoDeDados* bucket = static_cast<BlocoDeDados*>(dados.getPonteiroBloco(ids_bucket[0]));
+    resultado.blocos_dados++;
+
+    for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+        if (bucket->registros[i].id == id) {
+
+            resultado.registros.push_back(bucket->registros[i]);
+
+            break;
+
+        }
+
+    }
+
+}
+
+/**
+ * @brief Lote de consultas do seek1 com até 'largura' sondagens intercaladas (sondarPorId).
+ * Os resultados e os blocos lidos por consulta são os mesmos de consultarPorId.
+ */
+template <typename ArvoreId>
+std::vector<ResultadoConsulta> consultarPorIdIntercalado(ArvoreId& btree_id, GerenciadorArquivoDados& dados, const std::vector<int>& ids, size_t largura) {
+
+    std::vector<ResultadoConsulta> resultados(ids.size());
+
+    executarIntercalado(ids.size(), largura, [&](size_t i) { return sondarPorId(btree_id, dados, ids[i], resultados[i]); });
+
+    return resultados;
+
+}
+
+/**
+ * @brief Consulta do seek2: busca o título no índice secundário e lê os registros com o título exato.
+ * Buckets repetidos são lidos uma única vez. Somente leitura e thread-safe.
+ */
+ResultadoConsulta consultarPorTitulo(IndiceTitulo& indice, GerenciadorArquivoDados& dados, const std::string& titulo);
+
+/**
+ * @brief Consulta do seek2 respondida só pelo índice de cobertura: os registros devolvidos
+ * têm apenas id, titulo, ano e citacoes preenchidos e artigos.dat não é lido.
+ * O titulo das visões aponta para 'titulo', que precisa existir enquanto o resultado for usado.
+ * @throws std::runtime_error Se o índice não tem campos incluídos.
+ */
+ResultadoConsulta consultarCamposPorTitulo(IndiceTitulo& indice, const std::string& titulo);
+
+#endif // CONSULTAS_HPP
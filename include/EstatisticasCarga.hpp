@@ -0,0 +1,179 @@
+#ifndef ESTATISTICAS_CARGA_HPP
+#define ESTATISTICAS_CARGA_HPP
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @enum FaseCarga
+ * @brief Etapas do upload com tempo acumulado separadamente.
+ */
+enum class FaseCarga {
+
+    INICIALIZACAO = 0, // criação dos arquivos e alocação dos buckets primários
+    LEITURA_CSV,       // std::getline
+    PARSE,             // parseCSVLinha
+    HASH,              // ArquivoHashEstatico::inserir
+    INDICE_ID,
+    INDICE_TITULO,
+    INDICE_ANO,
+    INDICE_AUTORES,    // dicionário e listas de autores em memória (--indice-autores)
+    COLUNAS,           // EscritorColunas::acrescentar (--colunas)
+    CHECKPOINT_DADOS,  // msync de artigos.dat
+    CHECKPOINT_INDICES,// flush das árvores
+    OUTROS,            // log de progresso e o restante do laço
+
+    NUM_FASES
+
+};
+
+/**
+ * @brief Nome da fase no log e no JSON (ex.: "indice_titulo").
+ */
+const char* nomeFaseCarga(FaseCarga fase);
+
+/**
+ * @struct IntervaloCarga
+ * @brief Vazão de um intervalo entre checkpoints (o último pode ser parcial).
+ */
+struct IntervaloCarga {
+
+    long registros_ate = 0;          // total de registros inseridos ao fim do intervalo
+    long registros = 0;
+    double segundos = 0.0;           // duração do intervalo, incluindo o checkpoint
+    double segundos_checkpoint = 0.0;
+    double registros_por_s = 0.0;
+
+};
+
+/**
+ * @struct EstatisticasArquivoCarga
+ * @brief Contadores de I/O de um arquivo, como impressos no fim do upload.
+ */
+struct EstatisticasArquivoCarga {
+
+    std::string nome;    // "dados", "indice_id", ...
+    std::string caminho;
+    long blocos_lidos = 0;
+    long blocos_escritos = 0;
+    long total_blocos = 0;
+
+};
+
+/**
+ * @struct ResumoCarga
+ * @brief Parâmetros e totais do upload que entram no JSON de --stats-json.
+ */
+struct ResumoCarga {
+
+    std::string csv;
+    std::string modo_indice_titulo;
+    bool indice_titulo_cobertura = false;
+    bool indice_ano = false;
+    bool indice_autores = false;
+    bool colunas = false;
+    bool colunas_atualizacao = false;
+    int tamanho_bloco_so = 0;
+    size_t tamanho_bloco_dados = 0;
+    size_t tamanho_bloco_btree = 0;
+    long duracao_ms = 0;
+    long registros_inseridos = 0;
+    long linhas_ignoradas = 0;
+    long erros_insercao = 0;
+
+};
+
+/**
+ * @class EstatisticasCarga
+ * @brief Tempo por fase e vazão por intervalo de checkpoint do upload.
+ *
+ * Funciona como um cronômetro de voltas: marcar(fase) soma à fase o tempo decorrido
+ * desde a marca anterior, então cada etapa custa uma leitura de steady_clock (vDSO,
+ * dezenas de ns) diante de microssegundos por registro.
+ */
+class EstatisticasCarga {
+
+    public:
+        using Relogio = std::chrono::steady_clock;
+
+    private:
+        Relogio::duration tempo[static_cast<size_t>(FaseCarga::NUM_FASES)];
+        long chamadas[static_cast<size_t>(FaseCarga::NUM_FASES)];
+        Relogio::time_point ultima_marca;
+
+        Relogio::time_point inicio_intervalo;
+        long registros_inicio_intervalo;
+        Relogio::duration tempo_checkpoint_intervalo;
+
+        std::vector<IntervaloCarga> intervalos;
+        std::vector<EstatisticasArquivoCarga> arquivos;
+
+    public:
+        EstatisticasCarga();
+
+        /**
+         * @brief Soma à fase o tempo desde a marca anterior (ou desde reiniciarMarca()).
+         */
+        void marcar(FaseCarga fase) {
+
+            Relogio::time_point agora = Relogio::now();
+            size_t f = static_cast<size_t>(fase);
+
+            tempo[f] += agora - ultima_marca;
+            chamadas[f]++;
+
+            if (fase == FaseCarga::CHECKPOINT_DADOS || fase == FaseCarga::CHECKPOINT_INDICES) {
+
+                tempo_checkpoint_intervalo += agora - ultima_marca;
+
+            }
+
+            ultima_marca = agora;
+
+        }
+
+        /**
+         * @brief Descarta o tempo desde a marca anterior (trechos que não pertencem a nenhuma fase).
+         */
+        void reiniciarMarca() { ultima_marca = Relogio::now(); }
+
+        /**
+         * @brief Começa a contar o primeiro intervalo (depois da inicialização, antes do laço de inserção).
+         */
+        void iniciarIntervalo() {
+
+            inicio_intervalo = Relogio::now();
+            registros_inicio_intervalo = 0;
+            tempo_checkpoint_intervalo = Relogio::duration::zero();
+
+        }
+
+        /**
+         * @brief Fecha o intervalo atual (chamado depois de cada checkpoint e no fim da carga).
+         * @param registros_total Registros inseridos até aqui.
+         * @return O intervalo fechado.
+         */
+        const IntervaloCarga& fecharIntervalo(long registros_total);
+
+        void registrarArquivo(const EstatisticasArquivoCarga& arquivo) { arquivos.push_back(arquivo); }
+
+        double getSegundos(FaseCarga fase) const;
+        long getChamadas(FaseCarga fase) const { return chamadas[static_cast<size_t>(fase)]; }
+        const std::vector<IntervaloCarga>& getIntervalos() const { return intervalos; }
+
+        /**
+         * @brief Imprime (log_info) o tempo e a fração de cada fase e a vazão de cada intervalo.
+         */
+        void relatar() const;
+
+        /**
+         * @brief Escreve um objeto JSON com o resumo, as fases, os intervalos e o I/O de cada arquivo.
+         */
+        void escreverJSON(std::ostream& saida, const ResumoCarga& resumo) const;
+
+};
+
+#endif // ESTATISTICAS_CARGA_HPP
@@ -0,0 +1,82 @@
+#ifndef EXECUTOR_CONSULTAS_HPP
+#define EXECUTOR_CONSULTAS_HPP
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <cstddef>
+
+/**
+ * @class ExecutorConsultas
+ * @brief Conjunto fixo de threads que executa lotes de consultas contra estruturas já abertas.
+ *
+ * As threads são criadas uma vez e reaproveitadas entre lotes. Dentro de um lote, cada
+ * thread pega o próximo índice livre com um contador atômico, então consultas lentas
+ * (cadeias longas, cache frio) não atrasam as demais. A thread que chama também trabalha.
+ *
+ * As funções executadas devem usar apenas caminhos de leitura thread-safe
+ * (BPlusTree::search, BPlusTreeTitulo::search, GerenciadorArquivoDados::getPonteiroBloco).
+ */
+class ExecutorConsultas {
+
+    private:
+        std::vector<std::thread> trabalhadores;
+        std::mutex mutex;
+        std::condition_variable cv_tarefa;
+        std::condition_variable cv_concluida;
+
+        std::function<void(size_t)> tarefa;
+        size_t total;
+        std::atomic<size_t> proximo;
+        size_t geracao;
+        size_t ativos;
+        bool encerrar;
+        std::exception_ptr erro;
+
+        void laco();
+        void processar();
+
+    public:
+        /**
+         * @brief Construtor. Cria (numThreads - 1) threads auxiliares; a thread chamadora completa o total.
+         * @param numThreads Número total de threads trabalhando em cada lote (mínimo 1).
+         */
+        explicit ExecutorConsultas(int numThreads);
+
+        /**
+         * @brief Destrutor. Encerra e aguarda as threads auxiliares.
+         */
+        ~ExecutorConsultas();
+
+        ExecutorConsultas(const ExecutorConsultas&) = delete;
+        ExecutorConsultas& operator=(const ExecutorConsultas&) = delete;
+
+        int getNumThreads() const { return static_cast<int>(trabalhadores.size()) + 1; }
+
+        /**
+         * @brief Executa tarefa(i) para cada i em [0, total) e aguarda o fim do lote.
+         * @throws A primeira exceção lançada por alguma tarefa, depois que todas terminam.
+         */
+        void paraCada(size_t total, const std::function<void(size_t)>& tarefa);
+
+        /**
+         * @brief Aplica a consulta a cada entrada e devolve os resultados na ordem original.
+         */
+        template <typename Entrada, typename Funcao>
+        auto executar(const std::vector<Entrada>& entradas, Funcao consulta) -> std::vector<decltype(consulta(entradas[0]))> {
+
+            std::vector<decltype(consulta(entradas[0]))> saidas(entradas.size());
+
+            paraCada(entradas.size(), [&](size_t i) { saidas[i] = consulta(entradas[i]); });
+
+            return saidas;
+
+        }
+
+};
+
+#endif // EXECUTOR_CONSULTAS_HPP
@@ -0,0 +1,122 @@
+#ifndef GERADOR_CSV_HPP
+#define GERADOR_CSV_HPP
+
+#include <string>
+#include <random>
+#include <cstdint>
+
+/**
+ * @enum OrdemIds
+ * @brief Ordem em que o GeradorCSV emite os IDs.
+ */
+enum class OrdemIds {
+
+    SEQUENCIAL,  // primeiro_id, primeiro_id + 1, ...
+    EMBARALHADA, // os mesmos IDs da ordem sequencial, em uma permutação fixada pela semente
+    AGRUPADA     // grupos de IDs consecutivos separados por lacunas (faixas esparsas)
+
+};
+
+/**
+ * @brief Converte "sequencial", "embaralhada" ou "agrupada" em OrdemIds.
+ * @return 'false' se o nome for desconhecido.
+ */
+bool ordemIdsDeString(const std::string& nome, OrdemIds& ordem);
+
+/**
+ * @struct ConfiguracaoGerador
+ * @brief Parâmetros do conjunto sintético. A mesma configuração (com a mesma semente)
+ * gera sempre o mesmo CSV, byte a byte.
+ */
+struct ConfiguracaoGerador {
+
+    long linhas = 100000;
+    uint64_t semente = 42;
+
+    OrdemIds ordem = OrdemIds::SEQUENCIAL;
+    long primeiro_id = 1;
+    long tamanho_grupo = 1000;      // AGRUPADA: IDs consecutivos por grupo
+    double lacuna_media = 1.0;      // AGRUPADA: lacuna média entre grupos, em tamanhos de grupo
+
+    long titulos_distintos = 0;     // 0: um título por linha (sem repetição)
+    double expoente_zipf = 1.0;     // repetição dos títulos: o k-ésimo título mais comum aparece ~ 1/k^s
+
+    double taxa_malformadas = 0.0;  // fração das linhas que o parser deve rejeitar
+
+    int ano_minimo = 1990;
+    int ano_maximo = 2016;
+
+};
+
+/**
+ * @class GeradorCSV
+ * @brief Gera linhas no formato "id";"titulo";"ano";"autores";"citacoes";"atualizacao";"snippet"
+ * esperado por parseCSVLinha, uma por vez e sem guardar o conjunto em memória.
+ *
+ * Os títulos seguem uma distribuição Zipf sobre 'titulos_distintos' títulos (amostragem por
+ * rejeição-inversão); o texto de cada título depende só do seu posto, então títulos repetidos
+ * são idênticos. Títulos, autores (1 a ~10 nomes) e snippets têm comprimentos com cauda longa,
+ * e alguns passam do tamanho dos campos de Artigo para exercitar o truncamento. As linhas
+ * malformadas alternam entre campos faltando e ID inválido.
+ *
+ * Só usa a saída crua de std::mt19937_64 (padronizada), então o CSV não depende da
+ * biblioteca padrão usada na compilação.
+ */
+class GeradorCSV {
+
+    private:
+        ConfiguracaoGerador config;
+        std::mt19937_64 aleatorio;
+
+        long geradas;
+        long malformadas;
+
+        // Permutação de [0, linhas) para OrdemIds::EMBARALHADA
+        int bits_permutacao;
+        uint64_t chaves_permutacao[4];
+
+        // Estado da OrdemIds::AGRUPADA
+        long proximo_id_grupo;
+        long restantes_no_grupo;
+
+        // Amostragem Zipf (rejeição-inversão)
+        double zipf_h_integral_x1;
+        double zipf_h_integral_n;
+        double zipf_s;
+
+        double uniforme();
+        long inteiro(long minimo, long maximo);
+        double normal();
+
+        long proximoId();
+        uint64_t permutar(uint64_t indice) const;
+        long sortearPostoTitulo();
+
+        double zipfH(double x) const;
+        double zipfHIntegral(double x) const;
+        double zipfHIntegralInversa(double x) const;
+
+        void acrescentarPalavra(std::string& texto, std::mt19937_64& fonte);
+        std::string tituloDoPosto(long posto);
+        std::string autores();
+        std::string snippet(const std::string& titulo);
+
+    public:
+        /**
+         * @brief Construtor.
+         * @throws std::invalid_argument Se a configuração for inválida (ex.: IDs acima de INT32_MAX).
+         */
+        explicit GeradorCSV(const ConfiguracaoGerador& configuracao);
+
+        /**
+         * @brief Gera a próxima linha (sem '\n').
+         * @return 'false' quando as 'linhas' pedidas já foram geradas.
+         */
+        bool proximaLinha(std::string& linha);
+
+        long getLinhasGeradas() const { return geradas; }
+        long getLinhasMalformadas() const { return malformadas; }
+
+};
+
+#endif // GERADOR_CSV_HPP
@@ -4,6 +4,8 @@
 #include <string>
 #include <cstddef> // Para size_t
 #include <stdexcept>
+#include <atomic>
+#include <cstdint>
 
 /**
  * @class GerenciadorArquivoDados
@@ -11,6 +13,10 @@
  *
  * Esta classe permite alocar blocos de tamanho fixo no arquivo e acessar/manipular
  * seu conteúdo diretamente na memória, simulando um array contíguo de blocos.
+ *
+ * Os contadores de I/O são atômicos, então getPonteiroBloco() pode ser usado por
+ * várias threads em um banco somente leitura. Alocar blocos (mremap) não é seguro
+ * em paralelo com leituras.
  */
 class GerenciadorArquivoDados {
 private:
@@ -19,8 +25,12 @@ private:
     const size_t tamanho_bloco;
     void* mapa_memoria;
     size_t tamanho_total_arquivo;
-    long blocos_lidos;
-    long blocos_escritos;
+    std::atomic<long> blocos_lidos;
+    std::atomic<long> blocos_escritos;
+    uint16_t id_rastro; // identificador no rastro de acessos (RastroBlocos.hpp)
+
+    // madvise(conselho) sobre a faixa de blocos, alinhada à página
+    void aconselhar(size_t id_bloco, size_t num_blocos, int conselho);
 
 public:
     /**
@@ -63,6 +73,31 @@ public:
      */
     void* getPonteiroBloco(size_t id_bloco);
 
+    /**
+     * @brief Avisa o S.O. que uma faixa de blocos será acessada em breve (madvise MADV_WILLNEED).
+     * É apenas uma dica: não conta como leitura e falhas são ignoradas.
+     * @param id_bloco O primeiro bloco da faixa.
+     * @param num_blocos A quantidade de blocos consecutivos.
+     */
+    void sugerirLeitura(size_t id_bloco, size_t num_blocos = 1);
+
+    /**
+     * @brief Avisa o S.O. que uma faixa de blocos será lida em sequência (madvise MADV_SEQUENTIAL,
+     * que aumenta a leitura antecipada e libera as páginas já lidas, seguido de MADV_WILLNEED).
+     * Usado pela varredura completa, uma vez por partição. Falhas são ignoradas.
+     * @param id_bloco O primeiro bloco da faixa.
+     * @param num_blocos A quantidade de blocos consecutivos.
+     */
+    void sugerirLeituraSequencial(size_t id_bloco, size_t num_blocos);
+
+    /**
+     * @brief Antecipa o acesso a um bloco: sugere a página ao S.O. (sugerirLeitura) e pede à
+     * CPU o início do bloco (__builtin_prefetch). Usado pelas sondagens intercaladas antes de
+     * suspender. Não conta como leitura.
+     * @param id_bloco O ID (índice) do bloco.
+     */
+    void anteciparBloco(size_t id_bloco);
+
     // Métodos de Sincronização
 
     /**
@@ -105,7 +140,7 @@ public:
      * @return O contador de blocos lidos.
      */
     long obterBlocosLidos() const {
-        return blocos_lidos;
+        return blocos_lidos.load(std::memory_order_relaxed);
     }
 
     /**
@@ -113,7 +148,7 @@ public:
      * @return O contador de blocos escritos.
      */
     long obterBlocosEscritos() const {
-        return blocos_escritos;
+        return blocos_escritos.load(std::memory_order_relaxed);
     }
 };
 
@@ -2,27 +2,39 @@
 #define GERENCIADOR_INDICE_HPP
 
 #include <string>
-#include <fstream>
 #include <cstddef>
 #include <stdexcept>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
 
 /**
  * @class GerenciadorIndice
  * @brief Gerencia a leitura e escrita de blocos de dados de tamanho fixo 
  * em um arquivo binário, simulando acesso a disco.
  * * Mantém contadores de operações de I/O para análise de desempenho.
+ *
+ * As operações usam leitura/escrita posicional (pread/pwrite), sem posição de
+ * arquivo compartilhada, e os contadores são atômicos: várias threads podem
+ * chamar lerBloco() ao mesmo tempo. Escritas concorrentes continuam exigindo
+ * coordenação externa.
  */
 class GerenciadorIndice {
 private:
     std::string nomeArquivo;
-    std::fstream fileStream;
+    int fd;
     const size_t tamanhoBloco;
-    long blocos_lidos;
-    long blocos_escritos;
+    mutable std::atomic<long> blocos_lidos;
+    std::atomic<long> blocos_escritos;
+    mutable std::atomic<long> acertos_cache;
+    std::unordered_map<long, std::vector<char>> blocos_fixados;
+    uint16_t id_rastro; // identificador no rastro de acessos (RastroBlocos.hpp)
 
 public:
     /**
      * @brief Construtor. Tenta abrir o arquivo. Se não existir, tenta criá-lo.
+     * Se não houver permissão de escrita, abre somente para leitura.
      * @param nomeArquivo O caminho para o arquivo binário.
      * @param tamanhoBloco O tamanho fixo de cada bloco em bytes.
      * @throws std::runtime_error Se não for possível abrir ou criar o arquivo.
@@ -42,7 +54,7 @@ public:
      * @param buffer O ponteiro para o buffer onde o conteúdo será armazenado.
      * @throws std::runtime_error Em caso de erro de leitura no arquivo.
      */
-    void lerBloco(long idBloco, char* buffer);
+    void lerBloco(long idBloco, char* buffer) const;
 
     /**
      * @brief Escreve o conteúdo de um buffer em um bloco específico no disco.
@@ -53,7 +65,23 @@ public:
     void escreveBloco(long idBloco, const char* buffer);
 
     /**
-     * @brief Força a escrita de todos os buffers pendentes para o disco.
+     * @brief Avisa o S.O. que uma faixa de blocos será lida em breve (posix_fadvise WILLNEED).
+     * É apenas uma dica: não conta como leitura e falhas são ignoradas.
+     * @param idBloco O primeiro bloco da faixa.
+     * @param numBlocos A quantidade de blocos consecutivos.
+     */
+    void sugerirLeitura(long idBloco, long numBlocos) const;
+
+    /**
+     * @brief Mantém uma cópia do bloco em memória; leituras seguintes dele não vão ao disco.
+     * Usado para fixar os níveis superiores das árvores em processos de longa duração.
+     * Não é thread-safe: fixe os blocos antes de iniciar leituras concorrentes.
+     * @param idBloco O índice (ID) do bloco a ser fixado.
+     */
+    void fixarBloco(long idBloco);
+
+    /**
+     * @brief Força a escrita dos blocos já gravados para o disco (fdatasync).
      */
     void flush();
 
@@ -63,7 +91,7 @@ public:
      * @brief Obtém o tamanho total do arquivo em bytes.
      * @return O tamanho total do arquivo, ou 0 se o arquivo não puder ser aberto.
      */
-    long getTamanhoArquivo();
+    long getTamanhoArquivo() const;
     
     /**
      * @brief Obtém o número total de operações de leitura de bloco realizadas.
@@ -76,6 +104,13 @@ public:
      * @return O contador de blocos escritos.
      */
     long getBlocosEscritos() const;
+
+    /**
+     * @brief Obtém a quantidade de blocos fixados em memória e de leituras atendidas por eles.
+     * As leituras atendidas pela memória continuam somadas em getBlocosLidos().
+     */
+    long getBlocosFixados() const { return static_cast<long>(blocos_fixados.size()); }
+    long getAcertosCache() const { return acertos_cache.load(std::memory_order_relaxed); }
 };
 
 #endif // GERENCIADOR_INDICE_HPP
\ No newline at end of file
@@ -0,0 +1,195 @@
+#ifndef INDICE_AUTORES_HPP
+#define INDICE_AUTORES_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+#include "BlocoDeDados.hpp"
+
+/**
+ * Índice invertido de autores (autores.idx), gravado pelo upload com --indice-autores.
+ *
+ * O campo 'autores' é uma lista separada por '|'. Cada nome distinto recebe um id denso
+ * (dicionário) e cada id aponta para a lista ordenada dos locais dos registros em que o
+ * autor aparece. O local identifica o registro dentro de artigos.dat:
+ * bucket * CAPACIDADE_BUCKET + posição no bucket (os registros nunca mudam de lugar).
+ *
+ * As listas são gravadas como diferenças entre locais consecutivos em varint (7 bits por
+ * byte), em blocos de POSTAGENS_POR_SALTO. Uma tabela de saltos guarda o primeiro local e
+ * o deslocamento de cada bloco, então a interseção (coautoria) decodifica por inteiro só
+ * a lista menor e, nas demais, pula direto para o bloco que pode conter cada candidato.
+ */
+
+// Postagens por bloco de varints (uma entrada da tabela de saltos por bloco)
+const size_t POSTAGENS_POR_SALTO = 128;
+
+inline uint64_t localRegistro(size_t bucket, size_t posicao) { return static_cast<uint64_t>(bucket) * CAPACIDADE_BUCKET + posicao; }
+inline size_t bucketDoLocal(uint64_t local) { return static_cast<size_t>(local / CAPACIDADE_BUCKET); }
+inline size_t posicaoDoLocal(uint64_t local) { return static_cast<size_t>(local % CAPACIDADE_BUCKET); }
+
+/**
+ * @brief Nome sem os espaços das pontas (como os nomes entram no dicionário).
+ */
+std::string_view normalizarNomeAutor(std::string_view nome);
+
+#pragma pack(push, 1)
+
+/**
+ * @struct CabecalhoIndiceAutores
+ * @brief Primeiros 64 bytes de autores.idx. Os deslocamentos são a partir do início do arquivo.
+ */
+struct CabecalhoIndiceAutores {
+
+    char assinatura[8];        // "AUTORES1"
+    uint32_t versao;
+    uint32_t num_autores;
+    uint64_t num_locais;       // soma dos tamanhos de todas as listas
+    uint64_t offset_entradas;  // EntradaAutor[num_autores], em ordem de nome
+    uint64_t offset_listas;    // DescritorListaAutor[num_autores], em ordem de id
+    uint64_t offset_nomes;     // nomes concatenados, sem terminador
+    uint64_t offset_dados;     // tabelas de saltos e varints das listas
+    uint8_t reservado[8];
+
+};
+
+/**
+ * @struct EntradaAutor
+ * @brief Entrada do dicionário: nome (em offset_nomes) e id do autor.
+ */
+struct EntradaAutor {
+
+    uint64_t offset_nome;
+    uint32_t tamanho_nome;
+    uint32_t id_autor;
+
+};
+
+/**
+ * @struct DescritorListaAutor
+ * @brief Lista de um autor: num_saltos SaltoListaAutor seguidos de 'bytes' bytes de varints,
+ * a partir de offset (relativo a offset_dados, alinhado a 8 bytes).
+ */
+struct DescritorListaAutor {
+
+    uint64_t offset;
+    uint32_t registros;
+    uint32_t num_saltos;
+    uint64_t bytes;
+
+};
+
+/**
+ * @struct SaltoListaAutor
+ * @brief Primeiro local de um bloco e a posição do restante do bloco nos varints da lista.
+ */
+struct SaltoListaAutor {
+
+    uint64_t primeiro_local;
+    uint64_t offset;
+
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(CabecalhoIndiceAutores) == 64, "CabecalhoIndiceAutores deve ter 64 bytes");
+
+/**
+ * @class ConstrutorIndiceAutores
+ * @brief Monta o dicionário e as listas em memória durante o upload e grava autores.idx no fim.
+ */
+class ConstrutorIndiceAutores {
+
+    private:
+        // Busca por std::string_view sem criar std::string (busca heterogênea do C++20)
+        struct HashTexto {
+
+            using is_transparent = void;
+
+            size_t operator()(std::string_view texto) const { return std::hash<std::string_view>()(texto); }
+
+        };
+
+        std::unordered_map<std::string, uint32_t, HashTexto, std::equal_to<>> ids;
+        std::vector<std::string> nomes;
+        std::vector<std::vector<uint64_t>> locais;
+        uint64_t num_locais;
+
+    public:
+        ConstrutorIndiceAutores();
+
+        /**
+         * @brief Acrescenta o registro 'local' às listas de cada autor de 'autores' (separados por '|').
+         */
+        void acrescentar(std::string_view autores, uint64_t local);
+
+        /**
+         * @brief Ordena as listas e grava o arquivo (sobrescrevendo o anterior).
+         * @throws std::runtime_error se o arquivo não puder ser gravado.
+         */
+        void gravar(const std::string& caminho);
+
+        size_t getNumAutores() const { return nomes.size(); }
+        uint64_t getNumLocais() const { return num_locais; }
+
+};
+
+/**
+ * @class IndiceAutores
+ * @brief Leitura de autores.idx (mapeado somente leitura).
+ */
+class IndiceAutores {
+
+    private:
+        const char* mapa;
+        size_t tamanho;
+        const CabecalhoIndiceAutores* cabecalho;
+
+        const EntradaAutor* entradas() const;
+        const DescritorListaAutor& descritor(uint32_t id_autor) const;
+
+    public:
+        /**
+         * @throws std::runtime_error se o arquivo não existir ou estiver corrompido.
+         */
+        explicit IndiceAutores(const std::string& caminho);
+        ~IndiceAutores();
+
+        IndiceAutores(const IndiceAutores&) = delete;
+        IndiceAutores& operator=(const IndiceAutores&) = delete;
+
+        uint32_t getNumAutores() const { return cabecalho->num_autores; }
+        uint64_t getNumLocais() const { return cabecalho->num_locais; }
+
+        /**
+         * @brief Procura o nome exato (após normalizarNomeAutor) no dicionário.
+         * @return 'false' se o autor não existir.
+         */
+        bool buscar(std::string_view nome, uint32_t& id_autor) const;
+
+        uint32_t numeroRegistros(uint32_t id_autor) const { return descritor(id_autor).registros; }
+
+        /**
+         * @brief Bytes da lista (tabela de saltos + varints).
+         */
+        uint64_t bytesLista(uint32_t id_autor) const;
+
+        /**
+         * @brief Decodifica a lista inteira do autor, em ordem crescente de local.
+         */
+        void decodificar(uint32_t id_autor, std::vector<uint64_t>& locais) const;
+
+        /**
+         * @brief Locais presentes em todas as listas (registros com todos os autores), em ordem.
+         * A lista menor é decodificada; as demais são consultadas pela tabela de saltos.
+         * @param blocos_decodificados Se não for nulo, recebe o total de blocos de varints decodificados.
+         */
+        std::vector<uint64_t> intersectar(const std::vector<uint32_t>& ids_autores, long* blocos_decodificados = nullptr) const;
+
+};
+
+#endif // INDICE_AUTORES_HPP
@@ -0,0 +1,97 @@
+#ifndef INDICE_TITULO_HPP
+#define INDICE_TITULO_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstddef>
+
+#include "MetaDados.hpp"
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisTitulo.hpp"
+
+/**
+ * @class IndiceTitulo
+ * @brief Fachada do índice secundário de títulos que esconde o formato escolhido no upload.
+ *
+ * No modo COMPACTO a árvore guarda os títulos completos e a busca é exata.
+ * No modo HASH a árvore guarda apenas ChaveTituloNormalizada, então a busca
+ * devolve candidatos que precisam ser conferidos contra o 'titulo' do registro.
+ * Opcionalmente (só no modo COMPACTO) as folhas guardam CamposIncluidos, o que
+ * permite responder id, ano e citações sem ler o arquivo de dados.
+ */
+class IndiceTitulo {
+
+    private:
+        ModoIndiceTitulo modo;
+        std::unique_ptr<BPlusTreeTitulo> arvoreCompacta;
+        std::unique_ptr<BPlusTree<ChaveTituloNormalizada>> arvoreHash;
+
+    public:
+        /**
+         * @brief Construtor. Abre ou cria o arquivo de índice no formato indicado.
+         * @param nomeArquivo O caminho para o btree_titulo.idx.
+         * @param tamanhoBloco O tamanho do bloco do índice em bytes.
+         * @param modo O formato das chaves (gravado em db.meta).
+         * @param incluirCampos Se as folhas guardam CamposIncluidos (gravado em db.meta).
+         * @throws std::runtime_error Se campos incluídos forem pedidos no modo HASH.
+         */
+        IndiceTitulo(const std::string& nomeArquivo, size_t tamanhoBloco, ModoIndiceTitulo modo, bool incluirCampos = false);
+
+        /**
+         * @brief Insere um título apontando para o bucket de dados.
+         * @param campos Colunas incluídas do registro; obrigatório quando o índice inclui campos.
+         */
+        void insert(const std::string& titulo, long dataPointer, const CamposIncluidos* campos = nullptr);
+
+        /**
+         * @brief Busca os buckets candidatos a conter o título.
+         * @param blocosLidos Se informado, recebe a soma dos blocos lidos por esta consulta.
+         * @return Os IDs de bucket; no modo HASH podem incluir colisões.
+         */
+        std::vector<long> search(const std::string& titulo, long* blocosLidos = nullptr);
+
+        /**
+         * @brief Busca as colunas incluídas dos registros com o título exato, sem ler o arquivo de dados.
+         * @throws std::runtime_error Se o índice não inclui campos.
+         */
+        std::vector<CamposIncluidos> searchIncluidos(const std::string& titulo, long* blocosLidos = nullptr);
+
+        /**
+         * @brief Indica se as folhas guardam id, ano e citações de cada registro.
+         */
+        bool temCamposIncluidos() const { return arvoreCompacta && arvoreCompacta->temCamposIncluidos(); }
+
+        /**
+         * @brief Posiciona um cursor no primeiro título >= chave (varredura por prefixo).
+         * @throws std::runtime_error No modo HASH, cujas chaves não preservam a ordem dos títulos.
+         */
+        BPlusTreeTitulo::Cursor lowerBound(const std::string& chave, int leituraAntecipada = 0);
+
+        /**
+         * @brief Indica se o índice suporta varreduras ordenadas (lowerBound).
+         */
+        bool suportaVarredura() const { return modo == ModoIndiceTitulo::COMPACTO; }
+
+        /**
+         * @brief Indica se os resultados de search() precisam ser conferidos contra o registro.
+         */
+        bool exigeVerificacao() const { return modo == ModoIndiceTitulo::HASH; }
+
+        ModoIndiceTitulo getModo() const { return modo; }
+
+        /**
+         * @brief Fixa em memória os nós internos dos 'niveis' primeiros níveis da árvore em uso.
+         */
+        long fixarNiveisSuperiores(int niveis);
+
+        // Getters de estatísticas
+        long getIndexBlocosLidos() const;
+        long getIndexBlocosEscritos() const;
+        long getIndexTotalBlocos() const;
+
+        void flush();
+
+};
+
+#endif // INDICE_TITULO_HPP
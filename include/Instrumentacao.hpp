@@ -0,0 +1,178 @@
+#ifndef INSTRUMENTACAO_HPP
+#define INSTRUMENTACAO_HPP
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Instrumentação dos caminhos quentes (hash, árvores, gerenciadores de arquivo).
+ *
+ * Compilada só com -DINSTRUMENTACAO=1 ('make INSTRUMENTACAO=1'). Sem a flag as macros
+ * INSTR_* viram comandos vazios: nenhuma leitura de relógio, nenhum contador, nenhum
+ * estado extra nas classes instrumentadas.
+ *
+ * Com a flag, cada ponto de chamada tem a sua métrica estática (registrada no primeiro
+ * uso): histogramas log-lineares de tempo (ns) ou de valores (ex.: blocos da cadeia) e
+ * contadores. O relatório sai em std::cerr no fim do programa e a cada SIGUSR1
+ * (kill -USR1 <pid>), sem parar o programa. Métricas com o mesmo nome (ex.: as várias
+ * instâncias de BPlusTree<K>) aparecem somadas.
+ */
+
+/**
+ * @class HistogramaInstr
+ * @brief Histograma log-linear: valores abaixo de 8 são exatos e cada potência de 2 acima
+ * é dividida em 8 faixas (erro relativo de até 12,5%). Seguro entre threads (atômicos relaxados).
+ *
+ * Guarda também o maior valor e o contexto dele (ex.: o ID inserido), para achar o
+ * caso extremo; sob concorrência o par valor/contexto é aproximado.
+ */
+class HistogramaInstr {
+
+    public:
+        static const size_t SUBFAIXAS = 8;
+        static const size_t NUM_FAIXAS = (64 - 2) * SUBFAIXAS;
+
+    private:
+        const char* nome;
+        const char* unidade;
+        std::atomic<uint64_t> faixas[NUM_FAIXAS];
+        std::atomic<uint64_t> soma;
+        std::atomic<uint64_t> maximo;
+        std::atomic<long> contexto_maximo;
+        HistogramaInstr* proximo;
+
+    public:
+        HistogramaInstr(const char* nome, const char* unidade);
+
+        static size_t faixaDoValor(uint64_t valor) {
+
+            if (valor < SUBFAIXAS) return static_cast<size_t>(valor);
+
+            int expoente = 63 - __builtin_clzll(valor);
+
+            return static_cast<size_t>(expoente - 2) * SUBFAIXAS + ((valor >> (expoente - 3)) & (SUBFAIXAS - 1));
+
+        }
+
+        // Maior valor que cai na faixa
+        static uint64_t limiteSuperior(size_t faixa);
+
+        void registrar(uint64_t valor, long contexto = -1) {
+
+            faixas[faixaDoValor(valor)].fetch_add(1, std::memory_order_relaxed);
+            soma.fetch_add(valor, std::memory_order_relaxed);
+
+            uint64_t atual = maximo.load(std::memory_order_relaxed);
+
+            while (valor > atual) {
+
+                if (maximo.compare_exchange_weak(atual, valor, std::memory_order_relaxed)) {
+
+                    contexto_maximo.store(contexto, std::memory_order_relaxed);
+                    break;
+
+                }
+
+            }
+
+        }
+
+        const char* getNome() const { return nome; }
+        const char* getUnidade() const { return unidade; }
+        uint64_t getFaixa(size_t faixa) const { return faixas[faixa].load(std::memory_order_relaxed); }
+        uint64_t getSoma() const { return soma.load(std::memory_order_relaxed); }
+        uint64_t getMaximo() const { return maximo.load(std::memory_order_relaxed); }
+        long getContextoMaximo() const { return contexto_maximo.load(std::memory_order_relaxed); }
+        const HistogramaInstr* getProximo() const { return proximo; }
+
+};
+
+/**
+ * @class ContadorInstr
+ * @brief Contador de eventos (ex.: nós criados por divisão).
+ */
+class ContadorInstr {
+
+    private:
+        const char* nome;
+        std::atomic<uint64_t> valor;
+        ContadorInstr* proximo;
+
+    public:
+        explicit ContadorInstr(const char* nome);
+
+        void somar(uint64_t n) { valor.fetch_add(n, std::memory_order_relaxed); }
+
+        const char* getNome() const { return nome; }
+        uint64_t getValor() const { return valor.load(std::memory_order_relaxed); }
+        const ContadorInstr* getProximo() const { return proximo; }
+
+};
+
+/**
+ * @class TemporizadorInstr
+ * @brief Registra no histograma os ns entre a construção e o fim do escopo.
+ */
+class TemporizadorInstr {
+
+    private:
+        HistogramaInstr& histograma;
+        std::chrono::steady_clock::time_point inicio;
+
+    public:
+        explicit TemporizadorInstr(HistogramaInstr& histograma) : histograma(histograma), inicio(std::chrono::steady_clock::now()) {}
+
+        ~TemporizadorInstr() {
+
+            histograma.registrar(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count()));
+
+        }
+
+        TemporizadorInstr(const TemporizadorInstr&) = delete;
+        TemporizadorInstr& operator=(const TemporizadorInstr&) = delete;
+
+};
+
+/**
+ * @brief Escreve o relatório de todas as métricas registradas: contagem, média, p50, p90,
+ * p99, p99,9, máximo (com contexto) e, para tempos, quantos passaram de 1 ms.
+ */
+void relatarInstrumentacao(std::ostream& saida);
+
+#if defined(INSTRUMENTACAO) && INSTRUMENTACAO
+
+#define INSTR_JUNTAR_(a, b) a##b
+#define INSTR_JUNTAR(a, b) INSTR_JUNTAR_(a, b)
+
+// Mede o resto do escopo atual
+#define INSTR_TEMPORIZAR(nome) \
+    static HistogramaInstr INSTR_JUNTAR(instr_histograma_, __LINE__)(nome, "ns"); \
+    TemporizadorInstr INSTR_JUNTAR(instr_temporizador_, __LINE__)(INSTR_JUNTAR(instr_histograma_, __LINE__))
+
+// Registra um valor (não tempo) em um histograma; 'contexto' identifica o caso (ou -1)
+#define INSTR_REGISTRAR(nome, unidade, valor, contexto) do { \
+        static HistogramaInstr instr_histograma_(nome, unidade); \
+        instr_histograma_.registrar(static_cast<uint64_t>(valor), static_cast<long>(contexto)); \
+    } while (0)
+
+#define INSTR_CONTAR(nome, n) do { \
+        static ContadorInstr instr_contador_(nome); \
+        instr_contador_.somar(static_cast<uint64_t>(n)); \
+    } while (0)
+
+// Código que só existe na versão instrumentada (ex.: uma variável que conta blocos)
+#define INSTR_SO_INSTRUMENTADO(codigo) codigo
+
+#else
+
+#define INSTR_TEMPORIZAR(nome) do {} while (0)
+#define INSTR_REGISTRAR(nome, unidade, valor, contexto) do {} while (0)
+#define INSTR_CONTAR(nome, n) do {} while (0)
+#define INSTR_SO_INSTRUMENTADO(codigo)
+
+#endif
+
+#endif // INSTRUMENTACAO_HPP
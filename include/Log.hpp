@@ -2,6 +2,7 @@
 #define LOG_HPP
 
 #include <string>
+#include <atomic>
 
 /**
  * @enum LogLevel
@@ -9,7 +10,7 @@
  */
 
 enum class LogLevel {
-    
+
     ERROR = 0, // Apenas erros fatais
     WARN  = 1, // Avisos e erros
     INFO  = 2, // Informações padrão (default)
@@ -17,14 +18,88 @@ enum class LogLevel {
 
 };
 
+/**
+ * Nível mais verboso compilado nas macros LOG_*. Com -DLOG_NIVEL_COMPILADO=1, por exemplo,
+ * as chamadas LOG_INFO e LOG_DEBUG viram 'if (false)' e somem do binário, junto com a
+ * montagem das mensagens.
+ */
+#ifndef LOG_NIVEL_COMPILADO
+#define LOG_NIVEL_COMPILADO 3
+#endif
+
+// Nível escolhido em tempo de execução (LOG_LEVEL); só muda em log_init()
+extern LogLevel g_currentLevel;
+
+/**
+ * @brief Indica se uma mensagem do nível seria impressa, antes de montá-la.
+ */
+inline bool log_ativo(LogLevel nivel) {
+
+    return static_cast<int>(nivel) <= LOG_NIVEL_COMPILADO && nivel <= g_currentLevel;
+
+}
+
+/**
+ * Macros com formatação preguiçosa: a expressão da mensagem (concatenações, std::to_string)
+ * só é avaliada se o nível estiver ativo. Usadas nos caminhos quentes; as funções log_*
+ * continuam valendo para mensagens já prontas.
+ */
+#define LOG_MENSAGEM_(nivel, funcao, mensagem) do { if (log_ativo(nivel)) funcao(mensagem); } while (0)
+#define LOG_WARN(mensagem) LOG_MENSAGEM_(LogLevel::WARN, log_warn, mensagem)
+#define LOG_INFO(mensagem) LOG_MENSAGEM_(LogLevel::INFO, log_info, mensagem)
+#define LOG_DEBUG(mensagem) LOG_MENSAGEM_(LogLevel::DEBUG, log_debug, mensagem)
+
+/**
+ * @class AvisoLimitado
+ * @brief Contador de um aviso repetido (uma instância estática por ponto de chamada).
+ *
+ * As LIMITE primeiras ocorrências são impressas; as demais só são contadas, e no fim do
+ * programa sai uma linha por categoria com o total de ocorrências e de suprimidas.
+ */
+class AvisoLimitado {
+
+    private:
+        const char* categoria;
+        std::atomic<long> ocorrencias;
+        AvisoLimitado* proximo; // lista de todos os avisos, percorrida no fim do programa
+
+    public:
+        static const long LIMITE = 10;
+
+        explicit AvisoLimitado(const char* categoria);
+
+        bool permitir() { return ocorrencias.fetch_add(1, std::memory_order_relaxed) < LIMITE; }
+
+        const char* getCategoria() const { return categoria; }
+        long getOcorrencias() const { return ocorrencias.load(std::memory_order_relaxed); }
+        const AvisoLimitado* getProximo() const { return proximo; }
+
+};
+
+/**
+ * @brief Aviso repetido (ex.: uma linha mal formatada por linha do CSV), limitado por AvisoLimitado.
+ * @param categoria Texto literal que identifica o aviso no resumo final.
+ */
+#define LOG_WARN_LIMITADO(categoria, mensagem) do { \
+        static AvisoLimitado aviso_limitado_(categoria); \
+        if (log_ativo(LogLevel::WARN) && aviso_limitado_.permitir()) log_warn(mensagem); \
+    } while (0)
+
 /**
  * @brief Lê a variável de ambiente LOG_LEVEL e configura o nível global.
  * Deve ser chamada uma vez no início do main() de cada programa.
+ *
+ * WARN, INFO e DEBUG são assíncronos: a mensagem é copiada para um anel sem locks e uma
+ * thread escritora a imprime, descarregando o stream uma vez por rajada em vez de uma
+ * vez por linha. Mensagens maiores que uma entrada do anel, ou com LOG_ASYNC=0, são
+ * escritas na hora (depois de esvaziar o anel, mantendo a ordem). As pendentes são
+ * impressas no fim do programa.
  */
 void log_init();
 
 /**
  * @brief Imprime uma mensagem de ERRO (sempre visível) em std::cerr.
+ * Síncrona: esvazia o anel antes, para o erro não se perder nem sair fora de ordem.
  */
 void log_error(const std::string& msg);
 
@@ -43,4 +118,17 @@ void log_info(const std::string& msg);
  */
 void log_debug(const std::string& msg);
 
-#endif // LOG_HPP
\ No newline at end of file
+/**
+ * @brief Passa a imprimir INFO e DEBUG em std::cerr.
+ * Usado pelos modos que escrevem resultados em std::cout (ex.: --batch), para não misturá-los ao log.
+ */
+void log_redirect_stderr();
+
+/**
+ * @brief Espera a thread escritora imprimir tudo o que já foi registrado.
+ * Chamada antes de escrever resultados direto na saída padrão (ex.: BufferSaida), para
+ * que apareçam depois das mensagens que os precedem.
+ */
+void log_flush();
+
+#endif // LOG_HPP
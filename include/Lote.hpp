@@ -0,0 +1,223 @@
+#ifndef LOTE_HPP
+#define LOTE_HPP
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <cstddef>
+
+#include "config.hpp"
+#include "Consultas.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * Modo --batch do findrec, seek1 e seek2: as chaves (IDs ou títulos, um por linha,
+ * opcionalmente entre aspas) vêm da entrada padrão ou de um arquivo, os arquivos e
+ * índices são abertos uma única vez e os resultados de cada chave vão para a saída
+ * padrão no formato de --format (SaidaRegistros.hpp):
+ *
+ * tsv:    uma linha por registro encontrado: a chave seguida dos campos escolhidos. Uma
+ *         chave sem registros gera a chave seguida de campos vazios.
+ * jsonl:  um objeto por chave com os registros, os blocos lidos e a latência da consulta.
+ * text:   uma linha --- Chave "<chave>": <n> registro(s) --- seguida dos registros.
+ * binary: por chave, um uint32_t com o número de registros e os registros.
+ *
+ * O log e as estatísticas vão para std::cerr.
+ */
+
+/**
+ * @brief Lê as chaves do lote, uma por linha. Linhas vazias são ignoradas e aspas
+ * delimitadoras são removidas ("" dentro delas vira ").
+ * @param origem Caminho do arquivo, ou "-" para a entrada padrão.
+ * @return 'false' se o arquivo não puder ser aberto.
+ */
+bool lerChavesLote(const std::string& origem, std::vector<std::string>& chaves);
+
+/**
+ * @brief Remove (com aviso) as chaves que não são IDs inteiros positivos.
+ * Usado pelo findrec e seek1 antes de consultar.
+ */
+void descartarIdsInvalidosLote(std::vector<std::string>& chaves);
+
+/**
+ * @brief Escreve o resultado de uma chave no formato e com os campos do escritor.
+ */
+void escreverResultadoLote(EscritorRegistros& saida, const std::string& chave, const ResultadoConsulta& resultado, long latencia_ns);
+
+/**
+ * @brief Percentil p (0 a 100) pelo posto mais próximo de um vetor já ordenado; 0 se vazio.
+ * Usado no relatório do lote e no bench_carga.
+ */
+long percentil(const std::vector<long>& ordenado, double p);
+
+/**
+ * @class EstatisticasLote
+ * @brief Blocos lidos e latência de cada consulta de um lote, para o relatório final.
+ *
+ * Em um lote agrupado (processarLoteAgrupado) as chaves de um grupo não têm tempo nem
+ * blocos próprios: a latência registrada é a do grupo dividida pelo número de chaves e
+ * os blocos compartilhados ficam com a chave que os leu primeiro. Nesse caso (amortizado)
+ * o relatório traz só totais e médias, sem máximos nem percentis.
+ */
+class EstatisticasLote {
+
+    private:
+        std::vector<long> latencias_ns;
+        std::vector<long> blocos_indice;
+        std::vector<long> blocos_dados;
+        long encontradas = 0;
+        bool amortizado = false;
+
+    public:
+        EstatisticasLote() = default;
+        explicit EstatisticasLote(bool amortizado) : amortizado(amortizado) {}
+
+        void registrar(const ResultadoConsulta& resultado, long latencia_ns);
+
+        /**
+         * @brief Imprime (log_info) totais, médias e máximos de blocos por consulta e os
+         * percentis p50/p95/p99/máx de latência; no lote amortizado, só totais e médias.
+         */
+        void relatar(const std::string& programa, double duracao_s) const;
+
+};
+
+/**
+ * @brief Executa f(i) para i em [0, total) na thread atual (lotes sem ExecutorConsultas).
+ */
+inline void paraCadaSequencial(size_t total, const std::function<void(size_t)>& f) {
+
+    for (size_t i = 0; i < total; ++i) {
+
+        f(i);
+
+    }
+
+}
+
+/**
+ * @brief Executa as consultas do lote em blocos de TAMANHO_BLOCO_LOTE chaves, escrevendo
+ * os resultados na ordem das chaves. Só um bloco de resultados fica em memória por vez.
+ *
+ * @param paraCada Executa f(i) para i em [0, total): um laço simples ou ExecutorConsultas::paraCada.
+ * @param consulta Recebe a chave e devolve o ResultadoConsulta (deve ser thread-safe se paraCada usar threads).
+ */
+template <typename ParaCada, typename Consulta>
+EstatisticasLote processarLote(const std::vector<std::string>& chaves, EscritorRegistros& saida, ParaCada paraCada, Consulta consulta, size_t tamanhoBloco = TAMANHO_BLOCO_LOTE) {
+
+    EstatisticasLote estatisticas;
+    std::vector<ResultadoConsulta> resultados;
+    std::vector<long> latencias_ns;
+
+    saida.escreverCabecalho();
+
+    for (size_t inicio = 0; inicio < chaves.size(); inicio += tamanhoBloco) {
+
+        const size_t total = std::min(tamanhoBloco, chaves.size() - inicio);
+
+        resultados.assign(total, ResultadoConsulta());
+        latencias_ns.assign(total, 0);
+
+        paraCada(total, [&](size_t i) {
+
+            auto t0 = std::chrono::steady_clock::now();
+
+            resultados[i] = consulta(chaves[inicio + i]);
+
+            latencias_ns[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+
+        });
+
+        for (size_t i = 0; i < total; ++i) {
+
+            escreverResultadoLote(saida, chaves[inicio + i], resultados[i], latencias_ns[i]);
+            estatisticas.registrar(resultados[i], latencias_ns[i]);
+
+        }
+
+    }
+
+    saida.descarregar();
+
+    return estatisticas;
+
+}
+
+/**
+ * @brief Como processarLote, mas cada bloco de chaves é dividido em 'partes' fatias contíguas
+ * e cada fatia é respondida por uma única chamada consultaLote(fatia), que agrupa as buscas
+ * (ex.: consultarPorIdLote, consultarPorHashLote). A latência registrada para cada chave é
+ * a da chamada dividida pelo tamanho da fatia e as estatísticas devolvidas são amortizadas
+ * (ver EstatisticasLote).
+ *
+ * @param consultaLote Recebe um std::vector<std::string> de chaves e devolve um ResultadoConsulta por chave, na mesma ordem.
+ */
+template <typename ParaCada, typename ConsultaLote>
+EstatisticasLote processarLoteAgrupado(const std::vector<std::string>& chaves, EscritorRegistros& saida, ParaCada paraCada, size_t partes, ConsultaLote consultaLote, size_t tamanhoBloco = TAMANHO_BLOCO_LOTE) {
+
+    EstatisticasLote estatisticas(true);
+    std::vector<ResultadoConsulta> resultados;
+    std::vector<long> latencias_ns;
+
+    partes = std::max<size_t>(partes, 1);
+
+    saida.escreverCabecalho();
+
+    for (size_t inicio = 0; inicio < chaves.size(); inicio += tamanhoBloco) {
+
+        const size_t total = std::min(tamanhoBloco, chaves.size() - inicio);
+        const size_t tamanhoFatia = (total + partes - 1) / partes;
+
+        resultados.assign(total, ResultadoConsulta());
+        latencias_ns.assign(total, 0);
+
+        paraCada(partes, [&](size_t p) {
+
+            const size_t de = std::min(total, p * tamanhoFatia);
+            const size_t ate = std::min(total, de + tamanhoFatia);
+
+            if (de == ate) {
+
+                return;
+
+            }
+
+            auto t0 = std::chrono::steady_clock::now();
+
+            std::vector<ResultadoConsulta> fatia = consultaLote(std::vector<std::string>(chaves.begin() + inicio + de, chaves.begin() + inicio + ate));
+
+            long latencia_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count();
+
+            for (size_t i = de; i < ate; ++i) {
+
+                resultados[i] = std::move(fatia[i - de]);
+                latencias_ns[i] = latencia_ns / static_cast<long>(ate - de);
+
+            }
+
+        });
+
+        for (size_t i = 0; i < total; ++i) {
+
+            escreverResultadoLote(saida, chaves[inicio + i], resultados[i], latencias_ns[i]);
+            estatisticas.registrar(resultados[i], latencias_ns[i]);
+
+        }
+
+    }
+
+    saida.descarregar();
+
+    return estatisticas;
+
+}
+
+/**
+ * @brief Converte chaves já validadas por descartarIdsInvalidosLote em IDs.
+ */
+std::vector<int> idsDeChavesLote(const std::vector<std::string>& chaves);
+
+#endif // LOTE_HPP
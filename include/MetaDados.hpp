@@ -0,0 +1,68 @@
+#ifndef META_DADOS_HPP
+#define META_DADOS_HPP
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @enum ModoIndiceTitulo
+ * @brief Define o formato das chaves do índice secundário de títulos (btree_titulo.idx).
+ */
+enum class ModoIndiceTitulo : int32_t {
+
+    COMPACTO = 0, // Chaves de tamanho variável com prefixo comprimido (padrão)
+    HASH     = 1  // Chave normalizada de 16 bytes (hash de 64 bits + prefixo de 8 bytes)
+
+};
+
+/**
+ * @struct MetaDados
+ * @brief Conteúdo do arquivo db.meta gravado pelo upload.
+ *
+ * Layout binário: os dois tamanhos de bloco (size_t), o modo do índice de títulos
+ * (int32_t, obrigatório) e os campos opcionais (int32_t) na ordem em que foram
+ * adicionados. Arquivos sem o modo (16 bytes) são de versões anteriores, com outro
+ * formato de btree_titulo.idx, e são recusados; os campos opcionais ausentes
+ * assumem os valores padrão.
+ */
+struct MetaDados {
+
+    size_t tamanho_bloco_dados = 0;
+    size_t tamanho_bloco_btree = 0;
+    ModoIndiceTitulo modo_indice_titulo = ModoIndiceTitulo::COMPACTO;
+    bool indice_titulo_cobertura = false; // folhas do índice de títulos com id, ano e citações
+    bool indice_ano = false;              // btree_ano.idx (ano, citacoes DESC, id) foi construído
+    bool colunas = false;                 // colunas/ (id, ano, citacoes, bucket) foram gravadas
+    bool colunas_atualizacao = false;     // colunas/ inclui atualizacao (segundos desde 1970)
+    bool indice_autores = false;          // autores.idx (dicionário e listas de autores) foi construído
+
+};
+
+/**
+ * @brief Lê o arquivo de metadados.
+ * @param caminho O caminho para o db.meta.
+ * @param meta A struct a ser preenchida.
+ * @return 'true' se o arquivo existe, os tamanhos de bloco são válidos e o modo do índice de
+ * títulos está presente e é conhecido; 'false' caso contrário.
+ */
+bool lerMetaDados(const std::string& caminho, MetaDados& meta);
+
+/**
+ * @brief Grava o arquivo de metadados, sobrescrevendo o anterior.
+ * @return 'true' em caso de sucesso.
+ */
+bool escreverMetaDados(const std::string& caminho, const MetaDados& meta);
+
+/**
+ * @brief Converte o nome de um modo ("compacto" ou "hash") para o enum.
+ * @return 'true' se o nome é válido.
+ */
+bool modoIndiceTituloDeString(const std::string& nome, ModoIndiceTitulo& modo);
+
+/**
+ * @brief Retorna o nome legível de um modo do índice de títulos.
+ */
+std::string modoIndiceTituloParaString(ModoIndiceTitulo modo);
+
+#endif // META_DADOS_HPP
@@ -7,12 +7,6 @@
 
 #include "Artigo.hpp"
 
-/**
- * @brief Imprime todos os campos de um struct Artigo para o console.
- * @param artigo O Artigo a ser impresso.
- */
-void printArtigo(const Artigo& artigo);
-
 /**
  * @brief Copia uma string de origem para um array de char de destino de forma segura.
  * Garante que a string de destino seja terminada em nulo e evita overflow.
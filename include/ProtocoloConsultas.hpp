@@ -0,0 +1,61 @@
+#ifndef PROTOCOLO_CONSULTAS_HPP
+#define PROTOCOLO_CONSULTAS_HPP
+
+#include <string>
+#include <cstddef>
+
+#include "Artigo.hpp"
+#include "ArtigoView.hpp"
+
+/**
+ * Protocolo de linhas entre o servidor de consultas e o cliente (socket Unix).
+ *
+ * Pedido:   "<comando> <argumento>\n", com comando findrec, seek1 ou seek2
+ *           (o argumento do seek2 é o restante da linha, sem aspas). "sair" encerra a conexão.
+ * Resposta: "OK <registros> <blocos_indice> <blocos_dados> <latencia_us>\n" seguida de uma
+ *           linha TSV por registro (ver artigoParaLinhaTSV), ou "ERRO <mensagem>\n".
+ */
+
+// Caminho padrão do socket, ao lado dos arquivos do banco
+const char* const SOCKET_CONSULTAS_PADRAO = "/data/db/consultas.sock";
+
+/**
+ * @class ConexaoLinhas
+ * @brief Lê e escreve linhas completas em um socket já conectado.
+ */
+class ConexaoLinhas {
+
+    private:
+        int fd;
+        std::string pendente;
+
+    public:
+        explicit ConexaoLinhas(int fd) : fd(fd) {}
+
+        /**
+         * @brief Lê a próxima linha (sem o '\n').
+         * @return 'false' no fim da conexão ou em erro de leitura.
+         */
+        bool lerLinha(std::string& linha);
+
+        /**
+         * @brief Envia todo o texto, repetindo a escrita se ela for parcial.
+         * @return 'false' se a conexão foi fechada pelo outro lado.
+         */
+        bool enviar(const std::string& texto);
+
+};
+
+/**
+ * @brief Converte um Artigo em uma linha TSV (id, titulo, ano, autores, citacoes, atualizacao, snippet).
+ * Barra invertida, tabulações e quebras de linha dentro dos campos são escapadas (escaparCampoTSV).
+ */
+std::string artigoParaLinhaTSV(const ArtigoView& artigo);
+
+/**
+ * @brief Preenche um Artigo a partir de uma linha gerada por artigoParaLinhaTSV.
+ * @return 'false' se a linha não tiver os sete campos.
+ */
+bool artigoDeLinhaTSV(const std::string& linha, Artigo& artigo);
+
+#endif // PROTOCOLO_CONSULTAS_HPP
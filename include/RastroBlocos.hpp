@@ -0,0 +1,119 @@
+#ifndef RASTRO_BLOCOS_HPP
+#define RASTRO_BLOCOS_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Rastro de acessos a blocos: com a variável de ambiente RASTRO_BLOCOS=<arquivo>, cada
+ * getPonteiroBloco/notificarEscrita (GerenciadorArquivoDados) e lerBloco/escreveBloco
+ * (GerenciadorIndice) é gravado em um arquivo binário, lido depois pelo simcache.
+ * Um "%p" no nome é trocado pelo PID (um rastro por processo); um nome relativo vai para /data/.
+ * Sem a variável, cada acesso custa só o teste de rastro_ativo().
+ *
+ * Formato (little-endian): CabecalhoRastro e uma sequência de RegistroRastro. Um registro
+ * ACESSO_ARQUIVO declara um arquivo e é seguido de DeclaracaoArquivoRastro e do nome.
+ */
+
+enum class TipoAcessoBloco : uint8_t {
+
+    LEITURA = 0,
+    ESCRITA = 1,
+    ACESSO_ARQUIVO = 2 // declaração de arquivo (não é acesso)
+
+};
+
+#pragma pack(push, 1)
+
+struct CabecalhoRastro {
+
+    char assinatura[8];   // "RASTROB1"
+    uint32_t versao;
+    uint32_t reservado;
+
+};
+
+struct RegistroRastro {
+
+    uint64_t tempo_ns;    // desde o início do rastro (steady_clock)
+    uint32_t bloco;
+    uint16_t arquivo;     // índice na ordem das declarações
+    uint8_t tipo;         // TipoAcessoBloco
+    uint8_t reservado;
+
+};
+
+struct DeclaracaoArquivoRastro {
+
+    uint32_t tamanho_bloco;
+    uint16_t tamanho_nome;
+
+};
+
+#pragma pack(pop)
+
+// Ligado só quando RASTRO_BLOCOS foi definida e o arquivo abriu
+extern std::atomic<bool> g_rastroAtivo;
+
+inline bool rastro_ativo() {
+
+    return g_rastroAtivo.load(std::memory_order_relaxed);
+
+}
+
+/**
+ * @brief Declara um arquivo de blocos no rastro (chamada pelos construtores dos gerenciadores).
+ * Na primeira chamada lê RASTRO_BLOCOS e abre o rastro.
+ * @return O identificador do arquivo nos registros (0 se o rastro estiver desligado).
+ */
+uint16_t rastro_registrar_arquivo(const std::string& caminho, size_t tamanho_bloco);
+
+/**
+ * @brief Grava um acesso. Thread-safe (um mutex em volta de um buffer); chame só se rastro_ativo().
+ */
+void rastro_acesso(uint16_t arquivo, size_t bloco, TipoAcessoBloco tipo);
+
+/**
+ * @struct ArquivoRastro
+ * @brief Arquivo declarado em um rastro.
+ */
+struct ArquivoRastro {
+
+    std::string nome;
+    uint32_t tamanho_bloco;
+
+};
+
+/**
+ * @class LeitorRastro
+ * @brief Lê um rastro gravado com RASTRO_BLOCOS, registro a registro.
+ */
+class LeitorRastro {
+
+    private:
+        std::ifstream entrada;
+        std::vector<ArquivoRastro> arquivos;
+
+    public:
+        /**
+         * @throws std::runtime_error Se o arquivo não abrir ou não for um rastro.
+         */
+        explicit LeitorRastro(const std::string& caminho);
+
+        /**
+         * @brief Lê o próximo acesso (as declarações de arquivo são consumidas por dentro).
+         * @return 'false' no fim do rastro.
+         * @throws std::runtime_error Se o rastro estiver truncado no meio de uma declaração.
+         */
+        bool proximo(RegistroRastro& registro);
+
+        // Arquivos declarados até o ponto lido
+        const std::vector<ArquivoRastro>& getArquivos() const { return arquivos; }
+
+};
+
+#endif // RASTRO_BLOCOS_HPP
@@ -0,0 +1,305 @@
+#ifndef SAIDA_REGISTROS_HPP
+#define SAIDA_REGISTROS_HPP
+
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <unistd.h>
+
+#include "ArtigoView.hpp"
+
+/**
+ * Saída dos registros encontrados pelas ferramentas de consulta (findrec, seek1, seek2,
+ * seekano, cliente), escolhida com --format:
+ *
+ * text:   blocos "ID: ...", "Ano: ..." para leitura humana (o formato original).
+ * tsv:    uma linha por registro com os campos escolhidos, na ordem id, titulo, ano,
+ *         autores, citacoes, atualizacao, snippet. Barra invertida, tabulação e quebras
+ *         de linha dentro dos campos viram \\, \t, \n e \r (TSV "linear", sem aspas).
+ * jsonl:  um objeto JSON por registro (ou por chave, no modo --batch).
+ * binary: cabeçalho ASSINATURA_SAIDA_BINARIA seguido de registros
+ *         CabecalhoRegistroBinario + textos (ver abaixo), sem conversão de números.
+ *
+ * Tudo é montado em um buffer grande em espaço de usuário e enviado com write(2) em
+ * poucas chamadas. Em text o log continua na saída padrão; nos demais formatos as
+ * ferramentas mandam o log para std::cerr (log_redirect_stderr).
+ */
+
+/**
+ * @enum FormatoSaida
+ * @brief Formato dos registros escritos por EscritorRegistros.
+ */
+enum class FormatoSaida {
+
+    TEXTO,
+    TSV,
+    JSONL,
+    BINARIO
+
+};
+
+/**
+ * @brief Converte "text", "tsv", "jsonl" ou "binary" em FormatoSaida.
+ * @return 'false' se o nome for desconhecido.
+ */
+bool formatoSaidaDeString(const std::string& nome, FormatoSaida& formato);
+
+/**
+ * @struct SelecaoCampos
+ * @brief Campos de Artigo escolhidos para a saída (ex.: seek2 --fields id,ano,citacoes).
+ */
+struct SelecaoCampos {
+
+    bool id = true;
+    bool titulo = true;
+    bool ano = true;
+    bool autores = true;
+    bool citacoes = true;
+    bool atualizacao = true;
+    bool snippet = true;
+
+    /**
+     * @brief Indica se todos os campos escolhidos estão entre id, titulo, ano e citacoes.
+     */
+    bool somenteCamposIndexados() const { return !autores && !atualizacao && !snippet; }
+
+};
+
+/**
+ * @brief Converte uma lista separada por vírgulas ("id,ano,citacoes") em uma SelecaoCampos.
+ * Nomes aceitos: id, titulo, ano, autores, citacoes, atualizacao, snippet.
+ * @return 'false' se algum nome for desconhecido ou a lista estiver vazia.
+ */
+bool selecaoCamposDeString(const std::string& lista, SelecaoCampos& selecao);
+
+// Primeiros bytes de uma saída --format binary
+const char ASSINATURA_SAIDA_BINARIA[8] = {'A', 'R', 'T', 'B', 'I', 'N', '0', '1'};
+
+/**
+ * @struct CabecalhoRegistroBinario
+ * @brief Registro no formato binary: os inteiros em ordem nativa (little-endian no x86)
+ * e o tamanho de cada texto, que vem logo depois, na ordem titulo, autores, atualizacao,
+ * snippet, sem terminador. Campos fora de --fields saem zerados / vazios.
+ *
+ * No modo --batch cada chave é precedida de um uint32_t com o número de registros dela.
+ */
+#pragma pack(push, 1)
+struct CabecalhoRegistroBinario {
+
+    int32_t id;
+    int32_t ano;
+    int32_t citacoes;
+    uint16_t tamanho_titulo;
+    uint16_t tamanho_autores;
+    uint16_t tamanho_atualizacao;
+    uint16_t tamanho_snippet;
+
+};
+#pragma pack(pop)
+
+/**
+ * @brief Acrescenta um campo a uma linha TSV, escapando \\, \t, \n e \r.
+ * Destino é std::string ou BufferSaida (qualquer tipo com append(const char*, size_t)).
+ */
+template <typename Destino>
+void escaparCampoTSV(Destino& destino, std::string_view campo) {
+
+    size_t inicio = 0;
+
+    for (size_t i = 0; i < campo.size(); ++i) {
+
+        const char* escape;
+
+        switch (campo[i]) {
+
+            case '\\': escape = "\\\\"; break;
+            case '\t': escape = "\\t"; break;
+            case '\n': escape = "\\n"; break;
+            case '\r': escape = "\\r"; break;
+            default: continue;
+
+        }
+
+        destino.append(campo.data() + inicio, i - inicio);
+        destino.append(escape, 2);
+        inicio = i + 1;
+
+    }
+
+    destino.append(campo.data() + inicio, campo.size() - inicio);
+
+}
+
+/**
+ * @brief Acrescenta um texto como string JSON (com aspas). Trechos sem caracteres
+ * especiais são copiados de uma vez; controles viram \\uXXXX.
+ */
+template <typename Destino>
+void escaparTextoJSON(Destino& destino, std::string_view texto) {
+
+    static const char HEX[] = "0123456789abcdef";
+
+    size_t inicio = 0;
+
+    destino.append("\"", 1);
+
+    for (size_t i = 0; i < texto.size(); ++i) {
+
+        unsigned char c = static_cast<unsigned char>(texto[i]);
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+
+            continue;
+
+        }
+
+        destino.append(texto.data() + inicio, i - inicio);
+        inicio = i + 1;
+
+        switch (c) {
+
+            case '"': destino.append("\\\"", 2); break;
+            case '\\': destino.append("\\\\", 2); break;
+            case '\n': destino.append("\\n", 2); break;
+            case '\r': destino.append("\\r", 2); break;
+            case '\t': destino.append("\\t", 2); break;
+
+            default: {
+
+                char escape[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xf]};
+                destino.append(escape, sizeof(escape));
+
+            }
+
+        }
+
+    }
+
+    destino.append(texto.data() + inicio, texto.size() - inicio);
+    destino.append("\"", 1);
+
+}
+
+/**
+ * @brief Desfaz escaparCampoTSV. Sequências desconhecidas são mantidas como estão.
+ */
+std::string desescaparCampoTSV(std::string_view campo);
+
+/**
+ * @class BufferSaida
+ * @brief Buffer de saída sobre um descritor de arquivo (normalmente a saída padrão).
+ *
+ * Os bytes só vão para o descritor quando o buffer enche ou em descarregar(), em uma
+ * única chamada write(2) por vez. Antes de escrever, as mensagens de log pendentes e
+ * std::cout são descarregados, para a saída não se misturar fora de ordem com o log.
+ */
+class BufferSaida {
+
+    private:
+        int fd;
+        char* dados;
+        size_t usados;
+        size_t capacidade;
+
+        void escreverTudo(const char* texto, size_t tamanho);
+        void acrescentarGrande(const char* texto, size_t tamanho);
+
+    public:
+        static const size_t CAPACIDADE_PADRAO = 1 << 20;
+
+        explicit BufferSaida(int fd = STDOUT_FILENO, size_t capacidade = CAPACIDADE_PADRAO);
+        ~BufferSaida();
+
+        BufferSaida(const BufferSaida&) = delete;
+        BufferSaida& operator=(const BufferSaida&) = delete;
+
+        // Mesma assinatura de std::string::append, para os escapes acima aceitarem os dois
+        void append(const char* texto, size_t tamanho) {
+
+            if (tamanho <= capacidade - usados) {
+
+                std::memcpy(dados + usados, texto, tamanho);
+                usados += tamanho;
+
+                return;
+
+            }
+
+            acrescentarGrande(texto, tamanho);
+
+        }
+
+        void acrescentar(std::string_view texto) { append(texto.data(), texto.size()); }
+
+        void acrescentar(char c) { append(&c, 1); }
+
+        void acrescentarInteiro(long valor) {
+
+            char texto[24];
+            char* fim = std::to_chars(texto, texto + sizeof(texto), valor).ptr;
+
+            append(texto, static_cast<size_t>(fim - texto));
+
+        }
+
+        /**
+         * @brief Grava o conteúdo do buffer no descritor.
+         * @throws std::runtime_error se a escrita falhar (ex.: pipe fechado pelo leitor).
+         */
+        void descarregar();
+
+};
+
+/**
+ * @class EscritorRegistros
+ * @brief Escreve registros (ArtigoView) no formato e com os campos escolhidos, através
+ * de um BufferSaida. O destrutor descarrega o que faltar.
+ */
+class EscritorRegistros {
+
+    private:
+        BufferSaida buffer;
+        FormatoSaida formato;
+        SelecaoCampos selecao;
+        bool cabecalho_escrito = false;
+
+    public:
+        explicit EscritorRegistros(FormatoSaida formato, const SelecaoCampos& selecao = SelecaoCampos(), int fd = STDOUT_FILENO);
+
+        FormatoSaida getFormato() const { return formato; }
+        const SelecaoCampos& getSelecao() const { return selecao; }
+        BufferSaida& getBuffer() { return buffer; }
+
+        /**
+         * @brief Escreve a assinatura do formato binary, uma vez, antes do primeiro registro.
+         * Nos demais formatos não faz nada.
+         */
+        void escreverCabecalho();
+
+        /**
+         * @brief Escreve um registro completo: bloco de texto, linha TSV, linha JSON ou
+         * registro binário.
+         */
+        void escreverArtigo(const ArtigoView& artigo);
+
+        /**
+         * @brief Escreve só os campos escolhidos do registro, sem o fim de linha: os campos
+         * TSV separados por tabulação ou o objeto JSON. Usado pelo modo --batch (Lote.hpp),
+         * que acrescenta a chave à linha.
+         */
+        void escreverCamposTSV(const ArtigoView& artigo);
+        void escreverObjetoJSON(const ArtigoView& artigo);
+
+        /**
+         * @brief Número de campos escolhidos (colunas TSV de um registro).
+         */
+        size_t numeroCampos() const;
+
+        void descarregar() { buffer.descarregar(); }
+
+};
+
+#endif // SAIDA_REGISTROS_HPP
@@ -0,0 +1,116 @@
+#ifndef SIMULADOR_CACHE_HPP
+#define SIMULADOR_CACHE_HPP
+
+#include <list>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Políticas de substituição simuladas pelo simcache sobre um rastro de acessos
+ * (RastroBlocos.hpp). Cada cache guarda só as chaves dos blocos (arquivo e bloco),
+ * e acessar() devolve se a chave já estava no cache, inserindo-a se não estava.
+ */
+
+/**
+ * @class CacheLRU
+ * @brief Menos recentemente usado: lista em ordem de uso e mapa chave -> posição.
+ */
+class CacheLRU {
+
+    private:
+        size_t capacidade;
+        std::list<uint64_t> ordem; // frente: mais recente
+        std::unordered_map<uint64_t, std::list<uint64_t>::iterator> posicoes;
+
+    public:
+        explicit CacheLRU(size_t capacidade);
+
+        bool acessar(uint64_t chave);
+
+};
+
+/**
+ * @class CacheCLOCK
+ * @brief Aproximação do LRU com um bit de referência por quadro e um ponteiro circular
+ * (segunda chance), como nas caches de página dos S.O.s.
+ */
+class CacheCLOCK {
+
+    private:
+        size_t capacidade;
+        std::vector<uint64_t> quadros;
+        std::vector<uint8_t> referenciado;
+        std::unordered_map<uint64_t, size_t> posicoes;
+        size_t ponteiro;
+
+    public:
+        explicit CacheCLOCK(size_t capacidade);
+
+        bool acessar(uint64_t chave);
+
+};
+
+/**
+ * @class CacheARC
+ * @brief Adaptive Replacement Cache (Megiddo e Modha, 2003).
+ *
+ * T1 guarda os blocos vistos uma vez e T2 os vistos mais de uma vez; B1 e B2 guardam só
+ * as chaves recém-expulsas de cada um (fantasmas). Um acerto em B1 aumenta a parte da
+ * cache dada a T1 (alvo p) e um acerto em B2 a diminui, adaptando a divisão entre
+ * recência e frequência ao padrão de acesso.
+ */
+class CacheARC {
+
+    private:
+        enum Lista { T1 = 0, T2 = 1, B1 = 2, B2 = 3 };
+
+        struct Entrada {
+
+            Lista lista;
+            std::list<uint64_t>::iterator posicao;
+
+        };
+
+        size_t capacidade;
+        size_t alvo_t1; // p
+        std::list<uint64_t> listas[4]; // frente: mais recente
+        std::unordered_map<uint64_t, Entrada> entradas;
+
+        void mover(Entrada& entrada, Lista destino);
+        void descartarMaisAntigo(Lista lista);
+        void substituir(bool chave_em_b2);
+
+    public:
+        explicit CacheARC(size_t capacidade);
+
+        bool acessar(uint64_t chave);
+
+};
+
+/**
+ * @brief Simula uma política sobre a sequência de chaves.
+ * @return O número de acertos.
+ */
+template <typename Cache>
+size_t simularCache(const std::vector<uint64_t>& acessos, size_t capacidade) {
+
+    Cache cache(capacidade);
+    size_t acertos = 0;
+
+    for (uint64_t chave : acessos) {
+
+        if (cache.acessar(chave)) {
+
+            ++acertos;
+
+        }
+
+    }
+
+    return acertos;
+
+}
+
+#endif // SIMULADOR_CACHE_HPP
@@ -0,0 +1,163 @@
+#ifndef SONDAGEM_INTERCALADA_HPP
+#define SONDAGEM_INTERCALADA_HPP
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+/**
+ * Busca intercalada (AMAC / group prefetching) com corrotinas C++20.
+ *
+ * Cada consulta de um lote vira uma Sondagem: uma corrotina que, antes de tocar o
+ * próximo bloco (bucket de artigos.dat ou nó de índice), pede o bloco ao S.O.
+ * (madvise/fadvise WILLNEED) e suspende com 'co_await std::suspend_always{}'.
+ * executarIntercalado() mantém várias sondagens em andamento e as retoma em rodízio,
+ * então a leitura de um bloco sai do disco enquanto as outras consultas avançam,
+ * em vez de cada falta de página parar a thread inteira.
+ *
+ * As corrotinas só guardam referências para dados do lote que as criou; todas terminam
+ * (ou são destruídas) antes de executarIntercalado() retornar.
+ */
+
+/**
+ * @class Sondagem
+ * @brief Corrotina de uma consulta intercalada. Começa suspensa e é dona do seu quadro.
+ */
+class Sondagem {
+
+    public:
+        struct promise_type {
+
+            std::exception_ptr erro;
+
+            Sondagem get_return_object() { return Sondagem(std::coroutine_handle<promise_type>::from_promise(*this)); }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { erro = std::current_exception(); }
+
+        };
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+
+        explicit Sondagem(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+    public:
+        Sondagem(Sondagem&& outra) noexcept : handle(std::exchange(outra.handle, nullptr)) {}
+
+        Sondagem& operator=(Sondagem&& outra) noexcept {
+
+            if (this != &outra) {
+
+                if (handle) {
+
+                    handle.destroy();
+
+                }
+
+                handle = std::exchange(outra.handle, nullptr);
+
+            }
+
+            return *this;
+
+        }
+
+        Sondagem(const Sondagem&) = delete;
+        Sondagem& operator=(const Sondagem&) = delete;
+
+        ~Sondagem() {
+
+            if (handle) {
+
+                handle.destroy();
+
+            }
+
+        }
+
+        bool concluida() const { return !handle || handle.done(); }
+
+        /**
+         * @brief Retoma a corrotina até a próxima suspensão (ou até o fim).
+         * @throws A exceção que tiver escapado do corpo da corrotina.
+         */
+        void retomar() {
+
+            handle.resume();
+
+            if (handle.done() && handle.promise().erro) {
+
+                std::rethrow_exception(handle.promise().erro);
+
+            }
+
+        }
+
+};
+
+/**
+ * @brief Executa as sondagens criar(0) ... criar(total - 1) mantendo até 'largura' em andamento.
+ *
+ * As sondagens ativas são retomadas em rodízio; quando uma termina, a próxima do lote
+ * ocupa o seu lugar. Com largura 1 equivale a executar as consultas uma a uma.
+ * @param criar Recebe o índice da consulta e devolve a Sondagem dela (ainda suspensa).
+ */
+template <typename CriarSondagem>
+void executarIntercalado(size_t total, size_t largura, CriarSondagem criar) {
+
+    std::vector<Sondagem> ativas;
+    size_t proxima = 0;
+
+    largura = std::max<size_t>(largura, 1);
+    ativas.reserve(std::min(largura, total));
+
+    while (proxima < total && ativas.size() < largura) {
+
+        ativas.push_back(criar(proxima++));
+
+    }
+
+    while (!ativas.empty()) {
+
+        for (size_t s = 0; s < ativas.size();) {
+
+            ativas[s].retomar();
+
+            if (!ativas[s].concluida()) {
+
+                ++s;
+
+            }
+
+            else if (proxima < total) {
+
+                ativas[s] = criar(proxima++);
+                ++s;
+
+            }
+
+            else {
+
+                // Sem consultas novas: a última ativa ocupa a vaga
+                if (s + 1 < ativas.size()) {
+
+                    ativas[s] = std::move(ativas.back());
+
+                }
+
+                ativas.pop_back();
+
+            }
+
+        }
+
+    }
+
+}
+
+#endif // SONDAGEM_INTERCALADA_HPP
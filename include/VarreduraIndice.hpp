@@ -0,0 +1,123 @@
+#ifndef VARREDURA_INDICE_HPP
+#define VARREDURA_INDICE_HPP
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+
+#include "GerenciadorArquivoDados.hpp"
+#include "BlocoDeDados.hpp"
+
+/**
+ * @brief Varre um cursor de índice enquanto a chave estiver na faixa, lendo os buckets em lotes.
+ *
+ * Cada lote junta até 'tamanhoLote' entradas (chave, bucket) do cursor. Os IDs de bucket
+ * do lote são deduplicados e ordenados, faixas contíguas são sugeridas ao S.O. com
+ * madvise(MADV_WILLNEED) e cada bucket é obtido uma única vez de artigos.dat.
+ * Depois, na ordem das chaves, 'emitir(chave, bucket)' é chamado uma vez por bucket
+ * distinto de cada grupo de chaves iguais (mesma deduplicação feita pelo seek2).
+ *
+ * @param cursor Cursor já posicionado (BPlusTree<K>::Cursor ou BPlusTreeTitulo::Cursor).
+ * @param dados Gerenciador do arquivo de dados.
+ * @param dentroDaFaixa Predicado sobre a chave; a varredura para no primeiro 'false'.
+ * @param emitir Chamado com (chave, BlocoDeDados*) para extrair os registros.
+ * @param tamanhoLote Quantidade de entradas do índice por lote.
+ * @return O número de buckets distintos lidos do arquivo de dados.
+ */
+template <typename Cursor, typename DentroDaFaixa, typename Emitir>
+long varrerFaixaEmLotes(Cursor& cursor, GerenciadorArquivoDados& dados, DentroDaFaixa dentroDaFaixa, Emitir emitir, size_t tamanhoLote = 512) {
+
+    using Chave = typename std::decay<decltype(cursor.chave())>::type;
+
+    long buckets_lidos = 0;
+    std::vector<std::pair<Chave, long>> lote;
+    std::vector<long> ids_buckets;
+    std::unordered_map<long, BlocoDeDados*> buckets;
+
+    while (true) {
+
+        lote.clear();
+
+        // Um grupo de chaves iguais nunca é partido entre dois lotes, para não emitir o mesmo bucket duas vezes.
+        while (cursor.valido() && dentroDaFaixa(cursor.chave()) && (lote.size() < tamanhoLote || cursor.chave() == lote.back().first)) {
+
+            lote.emplace_back(cursor.chave(), cursor.apontador());
+            cursor.next();
+
+        }
+
+        if (lote.empty()) {
+
+            break;
+
+        }
+
+        ids_buckets.clear();
+
+        for (const auto& entrada : lote) {
+
+            ids_buckets.push_back(entrada.second);
+
+        }
+
+        std::sort(ids_buckets.begin(), ids_buckets.end());
+        ids_buckets.erase(std::unique(ids_buckets.begin(), ids_buckets.end()), ids_buckets.end());
+
+        // Sugere ao S.O. as faixas contíguas de buckets antes de tocar qualquer uma delas
+        for (size_t i = 0; i < ids_buckets.size();) {
+
+            size_t j = i + 1;
+
+            while (j < ids_buckets.size() && ids_buckets[j] == ids_buckets[j - 1] + 1) {
+
+                j++;
+
+            }
+
+            dados.sugerirLeitura(ids_buckets[i], j - i);
+            i = j;
+
+        }
+
+        buckets.clear();
+
+        for (long id_bucket : ids_buckets) {
+
+            buckets[id_bucket] = static_cast<BlocoDeDados*>(dados.getPonteiroBloco(id_bucket));
+            buckets_lidos++;
+
+        }
+
+        // Emite na ordem das chaves, um bucket distinto por grupo de chaves iguais
+        for (size_t i = 0; i < lote.size();) {
+
+            std::set<long> vistos;
+            size_t j = i;
+
+            while (j < lote.size() && lote[j].first == lote[i].first) {
+
+                if (vistos.insert(lote[j].second).second) {
+
+                    emitir(lote[i].first, buckets[lote[j].second]);
+
+                }
+
+                j++;
+
+            }
+
+            i = j;
+
+        }
+
+    }
+
+    return buckets_lidos;
+
+}
+
+#endif // VARREDURA_INDICE_HPP
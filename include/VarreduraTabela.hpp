@@ -0,0 +1,62 @@
+#ifndef VARREDURA_TABELA_HPP
+#define VARREDURA_TABELA_HPP
+
+#include <string>
+#include <vector>
+#include <climits>
+#include <cstddef>
+
+#include "Artigo.hpp"
+#include "ArtigoView.hpp"
+#include "GerenciadorArquivoDados.hpp"
+
+/**
+ * Varredura completa de artigos.dat (programa scan), para consultas que não são por ID nem
+ * por título exato. A faixa de buckets primários é dividida em partições contíguas; cada
+ * partição é lida em sequência (com a dica MADV_SEQUENTIAL só sobre ela) e as cadeias de
+ * overflow dos seus primários são seguidas pela mesma thread, então nenhum bloco é lido
+ * duas vezes e as partições podem rodar em paralelo sem coordenação.
+ */
+
+/**
+ * @struct PredicadoVarredura
+ * @brief Condições que um registro deve satisfazer (todas). Os campos numéricos são testados
+ * primeiro; os textos só são medidos (strnlen) se os números passarem.
+ */
+struct PredicadoVarredura {
+
+    int ano_min = INT_MIN;
+    int ano_max = INT_MAX;
+    int citacoes_min = INT_MIN;
+    std::string titulo_contem;   // vazio: não filtra
+    std::string autores_contem;  // vazio: não filtra
+
+    bool aceita(const Artigo& artigo) const;
+
+};
+
+/**
+ * @struct EstatisticasVarredura
+ * @brief Contadores de uma partição (ou da varredura toda, somados).
+ */
+struct EstatisticasVarredura {
+
+    long buckets_primarios = 0;
+    long blocos_overflow = 0;
+    long registros = 0;
+    long aceitos = 0;
+
+    void somar(const EstatisticasVarredura& outra);
+
+};
+
+/**
+ * @brief Varre os buckets primários [bucket_inicio, bucket_fim) e as cadeias de overflow deles.
+ * @param aceitos Se não for nulo, recebe os registros aceitos na ordem da varredura. As visões
+ * apontam para o mapeamento de 'dados' (ver ArtigoView).
+ * @throws std::runtime_error se uma cadeia de overflow sair do arquivo ou tiver um ciclo.
+ */
+void varrerParticao(GerenciadorArquivoDados& dados, const PredicadoVarredura& predicado, size_t bucket_inicio, size_t bucket_fim,
+                    std::vector<ArtigoView>* aceitos, EstatisticasVarredura& estatisticas);
+
+#endif // VARREDURA_TABELA_HPP
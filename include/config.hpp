@@ -8,4 +8,22 @@
 const int NUM_BUCKETS_PRIMARIOS = 567411;
 const long checkpoint_intervalo = 100000;
 
+// Varreduras por faixa (seek1 --range, seek2 --prefix)
+const int LEITURA_ANTECIPADA_FOLHAS = 8;      // blocos de índice sugeridos ao S.O. a cada folha
+const size_t TAMANHO_LOTE_VARREDURA = 512;    // entradas do índice por lote de leitura de buckets
+
+// Modo --batch (findrec, seek1, seek2)
+const size_t TAMANHO_BLOCO_LOTE = 4096;       // chaves consultadas antes de escrever os resultados
+
+// Varredura completa (scan)
+const size_t BUCKETS_POR_PARTICAO_VARREDURA = 4096; // buckets primários por tarefa (16 MiB com blocos de 4 KiB)
+const size_t PARTICOES_POR_THREAD_RODADA = 4;       // partições por thread antes de escrever os resultados
+
+// Índice primário (upload --fator-divisao)
+const double FATOR_DIVISAO_DIREITA_PADRAO = 1.0; // fração das chaves que fica no nó antigo ao dividir à direita
+
+// Servidor de consultas
+const int NIVEIS_FIXADOS_SERVIDOR = 3;        // níveis superiores das árvores mantidos em memória
+const int MAX_CONEXOES_SERVIDOR = 64;         // conexões atendidas ao mesmo tempo (uma thread cada)
+
 #endif
\ No newline at end of file
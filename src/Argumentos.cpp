@@ -0,0 +1,59 @@
+#include <string>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
+
+#include "Argumentos.hpp"
+#include "Log.hpp"
+
+// Converte o texto inteiro para um valor em [minimo, maximo]; 'false' se não for possível.
+static bool converterInteiro(const char* texto, long long minimo, long long maximo, long long& valor) {
+
+    try {
+
+        size_t lidos = 0;
+        valor = std::stoll(texto, &lidos);
+
+        return lidos == std::strlen(texto) && valor >= minimo && valor <= maximo;
+
+    }
+
+    catch (const std::exception& e) {
+
+        return false;
+
+    }
+
+}
+
+bool lerInteiroArgumento(const char* texto, const std::string& descricao, long long minimo, long long maximo, long long& valor) {
+
+    if (!converterInteiro(texto, minimo, maximo, valor)) {
+
+        log_error(descricao + " '" + std::string(texto) + "' inválido. Deve ser um inteiro entre " + std::to_string(minimo) + " e " + std::to_string(maximo) + ".");
+
+        return false;
+
+    }
+
+    return true;
+
+}
+
+bool lerInteiroArgumento(const char* texto, const std::string& descricao, int& valor) {
+
+    long long lido = 0;
+
+    if (!converterInteiro(texto, INT_MIN, INT_MAX, lido)) {
+
+        log_error(descricao + " '" + std::string(texto) + "' inválido. Deve ser um número inteiro.");
+
+        return false;
+
+    }
+
+    valor = static_cast<int>(lido);
+
+    return true;
+
+}
@@ -2,8 +2,12 @@
 #include <iostream>
 #include <cstring>
 #include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include "ArquivoHashEstatico.hpp"
+#include "Instrumentacao.hpp"
 #include "Log.hpp"
 
 ArquivoHashEstatico::ArquivoHashEstatico(GerenciadorArquivoDados& gm_dados, int num_buckets) : gerenciador_dados(gm_dados), NUM_BUCKETS_PRIMARIOS(num_buckets) {
@@ -46,11 +50,11 @@ void ArquivoHashEstatico::inicializar() {
     
     if (gerenciador_dados.obterNumeroTotalBlocos() == 0) {
         
-        log_info("Inicializando com " + std::to_string(NUM_BUCKETS_PRIMARIOS) + " buckets primários...");
+        LOG_INFO("Inicializando com " + std::to_string(NUM_BUCKETS_PRIMARIOS) + " buckets primários...");
 
         gerenciador_dados.alocarBlocosEmMassa(NUM_BUCKETS_PRIMARIOS);
 
-        log_info("Configurando ponteiros de overflow...");
+        LOG_INFO("Configurando ponteiros de overflow...");
         
         for (int i = 0; i < NUM_BUCKETS_PRIMARIOS; ++i) {
             
@@ -66,27 +70,40 @@ void ArquivoHashEstatico::inicializar() {
     
     else {
         
-        log_info("Arquivo de dados já inicializado.");
+        LOG_INFO("Arquivo de dados já inicializado.");
     
     }
 
 }
 
-size_t ArquivoHashEstatico::inserir(const Artigo& a) {
+size_t ArquivoHashEstatico::inserir(const Artigo& a, size_t* posicao) {
     
+    INSTR_TEMPORIZAR("hash.inserir");
+    INSTR_SO_INSTRUMENTADO(long blocos_cadeia = 0;)
+
     int id_bucket_atual = hash(a.id);
 
     while (true) {
         
         BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados.getPonteiroBloco(id_bucket_atual));
 
+        INSTR_SO_INSTRUMENTADO(++blocos_cadeia;)
+
         // Caso 1: Bucket atual tem espaço livre.
         if (bucket->contador_registros < CAPACIDADE_BUCKET) {
             
+            if (posicao) {
+
+                *posicao = bucket->contador_registros;
+
+            }
+
             bucket->registros[bucket->contador_registros] = a;
             bucket->contador_registros++;
 
             gerenciador_dados.notificarEscrita(id_bucket_atual);
+
+            INSTR_REGISTRAR("hash.inserir.cadeia", "blocos", blocos_cadeia, a.id);
             
             return id_bucket_atual; 
 
@@ -106,11 +123,20 @@ size_t ArquivoHashEstatico::inserir(const Artigo& a) {
             
             BlocoDeDados* bucket_overflow = static_cast<BlocoDeDados*>(gerenciador_dados.getPonteiroBloco(novo_id_overflow));
             
+            if (posicao) {
+
+                *posicao = bucket_overflow->contador_registros;
+
+            }
+
             bucket_overflow->registros[bucket_overflow->contador_registros] = a;
             bucket_overflow->contador_registros++;
             
             gerenciador_dados.notificarEscrita(id_bucket_atual);
 
+            INSTR_CONTAR("hash.overflow_alocados", 1);
+            INSTR_REGISTRAR("hash.inserir.cadeia", "blocos", blocos_cadeia + 1, a.id);
+
             return novo_id_overflow;
 
         }
@@ -122,8 +148,11 @@ size_t ArquivoHashEstatico::inserir(const Artigo& a) {
 
 }
 
-std::optional<Artigo> ArquivoHashEstatico::buscar(int id) {
+std::optional<ArtigoView> ArquivoHashEstatico::buscar(int id, long* blocosLidos) {
     
+    INSTR_TEMPORIZAR("hash.buscar");
+    INSTR_SO_INSTRUMENTADO(long blocos_cadeia = 0;)
+
     int id_bucket_atual = hash(id);
 
     // Percorre a cadeia de overflow
@@ -131,12 +160,22 @@ std::optional<Artigo> ArquivoHashEstatico::buscar(int id) {
         
         BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados.getPonteiroBloco(id_bucket_atual));
 
+        INSTR_SO_INSTRUMENTADO(++blocos_cadeia;)
+
+        if (blocosLidos) {
+
+            (*blocosLidos)++;
+
+        }
+
         // Procura linearmente o ID dentro do bucket atual
         for (size_t i = 0; i < bucket->contador_registros; ++i) {
         
             if (bucket->registros[i].id == id) {
         
                 // Encontrou: retorna o artigo.
+                INSTR_REGISTRAR("hash.buscar.cadeia", "blocos", blocos_cadeia, id);
+
                 return bucket->registros[i];
         
             }
@@ -149,6 +188,157 @@ std::optional<Artigo> ArquivoHashEstatico::buscar(int id) {
     }
 
     // Percorreu toda a cadeia e não encontrou: retorna vazio.
+    INSTR_REGISTRAR("hash.buscar.cadeia", "blocos", blocos_cadeia, id);
+
     return std::nullopt;
     
-}
\ No newline at end of file
+}
+
+std::vector<std::optional<ArtigoView>> ArquivoHashEstatico::buscarLote(const std::vector<int>& ids, std::vector<long>* blocosPorChave) {
+
+    const size_t n = ids.size();
+    std::vector<std::optional<ArtigoView>> resultados(n);
+
+    if (blocosPorChave) {
+
+        blocosPorChave->assign(n, 0);
+
+    }
+
+    // 1. Ordena as consultas pelo bucket primário (o índice original desempata)
+    std::vector<std::pair<int, size_t>> ordem(n);
+
+    for (size_t i = 0; i < n; ++i) {
+
+        ordem[i] = {hash(ids[i]), i};
+
+    }
+
+    std::sort(ordem.begin(), ordem.end());
+
+    // 2. Sugere ao S.O. as faixas contíguas de buckets primários antes de tocar qualquer uma delas
+    for (size_t i = 0; i < n;) {
+
+        size_t j = i + 1;
+
+        while (j < n && ordem[j].first <= ordem[j - 1].first + 1) {
+
+            j++;
+
+        }
+
+        gerenciador_dados.sugerirLeitura(ordem[i].first, ordem[j - 1].first - ordem[i].first + 1);
+        i = j;
+
+    }
+
+    // 3. Percorre cada cadeia uma única vez para todos os IDs do grupo
+    for (size_t inicio = 0; inicio < n;) {
+
+        size_t fim = inicio + 1;
+
+        while (fim < n && ordem[fim].first == ordem[inicio].first) {
+
+            fim++;
+
+        }
+
+        size_t pendentes = fim - inicio;
+        int id_bucket_atual = ordem[inicio].first;
+
+        while (id_bucket_atual != -1 && pendentes > 0) {
+
+            BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados.getPonteiroBloco(id_bucket_atual));
+
+            if (blocosPorChave) {
+
+                (*blocosPorChave)[ordem[inicio].second]++;
+
+            }
+
+            for (size_t k = inicio; k < fim; ++k) {
+
+                const size_t i = ordem[k].second;
+
+                if (resultados[i]) {
+
+                    continue;
+
+                }
+
+                for (size_t r = 0; r < bucket->contador_registros; ++r) {
+
+                    if (bucket->registros[r].id == ids[i]) {
+
+                        resultados[i] = bucket->registros[r];
+                        pendentes--;
+
+                        break;
+
+                    }
+
+                }
+
+            }
+
+            id_bucket_atual = bucket->proximo_bloco_overflow;
+
+        }
+
+        inicio = fim;
+
+    }
+
+    return resultados;
+
+}
+
+
+Sondagem ArquivoHashEstatico::sondar(int id, std::optional<ArtigoView>& resultado, long& blocosLidos) {
+
+    long id_bucket_atual = hash(id);
+
+    while (id_bucket_atual != -1) {
+
+        // Pede o bucket e deixa as outras sondagens avançarem enquanto ele chega
+        gerenciador_dados.anteciparBloco(id_bucket_atual);
+
+        co_await std::suspend_always{};
+
+        BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados.getPonteiroBloco(id_bucket_atual));
+        blocosLidos++;
+
+        for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+            if (bucket->registros[i].id == id) {
+
+                resultado = bucket->registros[i];
+
+                co_return;
+
+            }
+
+        }
+
+        id_bucket_atual = bucket->proximo_bloco_overflow;
+
+    }
+
+}
+
+std::vector<std::optional<ArtigoView>> ArquivoHashEstatico::buscarIntercalado(const std::vector<int>& ids, size_t largura, std::vector<long>* blocosPorChave) {
+
+    std::vector<std::optional<ArtigoView>> resultados(ids.size());
+    std::vector<long> blocos(ids.size(), 0);
+
+    executarIntercalado(ids.size(), largura, [&](size_t i) { return sondar(ids[i], resultados[i], blocos[i]); });
+
+    if (blocosPorChave) {
+
+        blocosPorChave->swap(blocos);
+
+    }
+
+    return resultados;
+
+}
@@ -0,0 +1,997 @@
+#include <stdexcept>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "ArvoreBMaisTitulo.hpp"
+#include "ArvoreBMais.hpp"
+
+// Tamanho do cabeçalho comum dos nós: ehFolha + numChaves + proximo.
+static const size_t TAM_CABECALHO_NO = sizeof(bool) + sizeof(int) + sizeof(long);
+
+// Bloco mínimo para que um nó interno sempre comporte três chaves de tamanho máximo.
+static const size_t TAM_MIN_BLOCO_TITULO = 1024;
+
+// Cabeçalho das páginas de excedente das listas de postagem: numApontadores + proxima.
+static const size_t TAM_CABECALHO_EXCEDENTE = sizeof(int) + sizeof(long);
+
+// Identificação do formato gravada no bloco 0, logo depois de CabecalhoIndice.
+static const char ASSINATURA_INDICE_TITULO[8] = {'T', 'I', 'T', 'U', 'L', 'O', 'V', 'L'};
+static const uint32_t VERSAO_INDICE_TITULO = 1;
+
+#pragma pack(push, 1)
+
+struct FormatoIndiceTitulo {
+
+    char assinatura[8];
+    uint32_t versao;
+    uint8_t incluirCampos;
+
+};
+
+#pragma pack(pop)
+
+// Grava uma entrada da lista de postagem (apontador e, se houver, as colunas incluídas).
+static char* gravarEntrada(char* ptr, long apontador, const CamposIncluidos* campos) {
+
+    memcpy(ptr, &apontador, sizeof(long));
+    ptr += sizeof(long);
+
+    if (campos) {
+
+        memcpy(ptr, campos, sizeof(CamposIncluidos));
+        ptr += sizeof(CamposIncluidos);
+
+    }
+
+    return ptr;
+
+}
+
+// Lê uma entrada da lista de postagem.
+static const char* lerEntrada(const char* ptr, long& apontador, CamposIncluidos* campos) {
+
+    memcpy(&apontador, ptr, sizeof(long));
+    ptr += sizeof(long);
+
+    if (campos) {
+
+        memcpy(campos, ptr, sizeof(CamposIncluidos));
+        ptr += sizeof(CamposIncluidos);
+
+    }
+
+    return ptr;
+
+}
+
+// Tamanho do prefixo comum entre duas strings.
+static size_t prefixoComum(const std::string& a, const std::string& b) {
+
+    size_t limite = std::min(a.size(), b.size());
+    size_t i = 0;
+
+    while (i < limite && a[i] == b[i]) {
+
+        i++;
+
+    }
+
+    return i;
+
+}
+
+// Prefixo comum a todas as chaves do nó. Como as chaves estão ordenadas, basta comparar a primeira com a última.
+static size_t prefixoDoNo(const NoTitulo& no) {
+
+    if (no.vetorChaves.empty()) {
+
+        return 0;
+
+    }
+
+    return prefixoComum(no.vetorChaves.front(), no.vetorChaves.back());
+
+}
+
+// Menor prefixo de 'direita' que ainda é estritamente maior que 'esquerda' (truncamento de sufixo).
+static std::string separadorMinimo(const std::string& esquerda, const std::string& direita) {
+
+    size_t lcp = prefixoComum(esquerda, direita);
+
+    if (lcp >= direita.size()) {
+
+        return direita;
+
+    }
+
+    return direita.substr(0, lcp + 1);
+
+}
+
+BPlusTreeTitulo::BPlusTreeTitulo(const std::string& nomeArquivo, size_t tamanhoBloco, bool incluirCampos)
+    : tamanhoBloco(tamanhoBloco),
+      incluirCampos(incluirCampos),
+      tamanhoEntrada(sizeof(long) + (incluirCampos ? sizeof(CamposIncluidos) : 0)),
+      nomeArquivo(nomeArquivo),
+      gerenciador(nomeArquivo, tamanhoBloco),
+      idRaiz(-1),
+      totalBlocos(0),
+      cabecalhoAlterado(false) {
+
+    if (tamanhoBloco < TAM_MIN_BLOCO_TITULO) {
+
+        throw std::runtime_error("Erro: Bloco de " + std::to_string(tamanhoBloco) + " bytes e pequeno demais para o indice de titulos (minimo " + std::to_string(TAM_MIN_BLOCO_TITULO) + ").");
+
+    }
+
+    if (gerenciador.getTamanhoArquivo() > 0) {
+
+        lerCabecalho();
+
+        if (this->tamanhoBloco != tamanhoBloco) {
+
+            throw std::runtime_error("Erro: O tamanho do bloco fornecido é inconsistente com o do arquivo!");
+
+        }
+
+    }
+
+    else {
+
+        this->idRaiz = -1;
+        this->totalBlocos = 1;
+        escreverCabecalho();
+
+    }
+
+}
+
+BPlusTreeTitulo::~BPlusTreeTitulo() {
+
+    try {
+
+        // Só quem inseriu regrava o cabeçalho: abrir para consulta não altera o arquivo
+        if (cabecalhoAlterado) {
+
+            escreverCabecalho();
+
+        }
+
+    }
+
+    catch (const std::exception&) {
+
+        // Destrutor não pode propagar exceções.
+
+    }
+
+}
+
+void BPlusTreeTitulo::escreverCabecalho() {
+
+    CabecalhoIndice hdr;
+    hdr.idRaiz = this->idRaiz;
+    hdr.tamanhoBloco = static_cast<long>(this->tamanhoBloco);
+    hdr.numBlocos = static_cast<int>(this->totalBlocos);
+
+    FormatoIndiceTitulo formato;
+    memcpy(formato.assinatura, ASSINATURA_INDICE_TITULO, sizeof(formato.assinatura));
+    formato.versao = VERSAO_INDICE_TITULO;
+    formato.incluirCampos = this->incluirCampos ? 1 : 0;
+
+    std::vector<char> buffer(tamanhoBloco, 0);
+    memcpy(buffer.data(), &hdr, sizeof(CabecalhoIndice));
+    memcpy(buffer.data() + sizeof(CabecalhoIndice), &formato, sizeof(FormatoIndiceTitulo));
+    gerenciador.escreveBloco(0, buffer.data());
+
+    this->cabecalhoAlterado = false;
+
+}
+
+void BPlusTreeTitulo::lerCabecalho() {
+
+    std::vector<char> buffer(tamanhoBloco);
+    gerenciador.lerBloco(0, buffer.data());
+
+    CabecalhoIndice hdr;
+    memcpy(&hdr, buffer.data(), sizeof(CabecalhoIndice));
+
+    FormatoIndiceTitulo formato;
+    memcpy(&formato, buffer.data() + sizeof(CabecalhoIndice), sizeof(FormatoIndiceTitulo));
+
+    // Índices gravados antes da assinatura têm zeros aqui e páginas em outro formato
+    if (memcmp(formato.assinatura, ASSINATURA_INDICE_TITULO, sizeof(formato.assinatura)) != 0) {
+
+        throw std::runtime_error("Erro: " + nomeArquivo + " foi gravado por uma versao anterior do indice de titulos. Refaca o upload.");
+
+    }
+
+    if (formato.versao != VERSAO_INDICE_TITULO) {
+
+        throw std::runtime_error("Erro: " + nomeArquivo + " esta na versao " + std::to_string(formato.versao) + " do indice de titulos (esperada " +
+                                 std::to_string(VERSAO_INDICE_TITULO) + "). Refaca o upload.");
+
+    }
+
+    if ((formato.incluirCampos != 0) != this->incluirCampos) {
+
+        throw std::runtime_error("Erro: " + nomeArquivo + " foi gravado " + (formato.incluirCampos ? "com" : "sem") +
+                                 " campos incluidos, inconsistente com db.meta. Refaca o upload.");
+
+    }
+
+    this->idRaiz = hdr.idRaiz;
+    this->tamanhoBloco = static_cast<size_t>(hdr.tamanhoBloco);
+    this->totalBlocos = hdr.numBlocos;
+
+}
+
+size_t BPlusTreeTitulo::tamanhoPostagem(const ListaPostagem& lista) const {
+
+    if (lista.paginaExcedente != -1) {
+
+        return sizeof(int) + sizeof(long);
+
+    }
+
+    return sizeof(int) + lista.apontadores.size() * tamanhoEntrada;
+
+}
+
+size_t BPlusTreeTitulo::tamanhoSerializado(const NoTitulo& no) const {
+
+    size_t prefixo = prefixoDoNo(no);
+    size_t tamanho = TAM_CABECALHO_NO + sizeof(uint16_t) + prefixo;
+
+    for (const std::string& chave : no.vetorChaves) {
+
+        tamanho += sizeof(uint16_t) + (chave.size() - prefixo);
+
+    }
+
+    if (no.ehFolha) {
+
+        for (const ListaPostagem& lista : no.postagens) {
+
+            tamanho += tamanhoPostagem(lista);
+
+        }
+
+    }
+
+    else {
+
+        tamanho += no.vetorApontadores.size() * sizeof(long);
+
+    }
+
+    return tamanho;
+
+}
+
+void BPlusTreeTitulo::serializaNo(const NoTitulo& no, char* buffer) const {
+
+    char* ptr = buffer;
+    int numChaves = static_cast<int>(no.vetorChaves.size());
+
+    memcpy(ptr, &no.ehFolha, sizeof(bool));
+    ptr += sizeof(bool);
+    memcpy(ptr, &numChaves, sizeof(int));
+    ptr += sizeof(int);
+    memcpy(ptr, &no.proximo, sizeof(long));
+    ptr += sizeof(long);
+
+    // Prefixo comum gravado uma única vez
+    uint16_t tamPrefixo = static_cast<uint16_t>(prefixoDoNo(no));
+    memcpy(ptr, &tamPrefixo, sizeof(uint16_t));
+    ptr += sizeof(uint16_t);
+
+    if (tamPrefixo > 0) {
+
+        memcpy(ptr, no.vetorChaves.front().data(), tamPrefixo);
+        ptr += tamPrefixo;
+
+    }
+
+    // Sufixos com prefixo de tamanho
+    for (const std::string& chave : no.vetorChaves) {
+
+        uint16_t tamSufixo = static_cast<uint16_t>(chave.size() - tamPrefixo);
+        memcpy(ptr, &tamSufixo, sizeof(uint16_t));
+        ptr += sizeof(uint16_t);
+        memcpy(ptr, chave.data() + tamPrefixo, tamSufixo);
+        ptr += tamSufixo;
+
+    }
+
+    if (!no.ehFolha) {
+
+        memcpy(ptr, no.vetorApontadores.data(), no.vetorApontadores.size() * sizeof(long));
+
+        return;
+
+    }
+
+    // Listas de postagem: total seguido dos apontadores ou da primeira página de excedente
+    for (const ListaPostagem& lista : no.postagens) {
+
+        memcpy(ptr, &lista.total, sizeof(int));
+        ptr += sizeof(int);
+
+        if (lista.paginaExcedente != -1) {
+
+            memcpy(ptr, &lista.paginaExcedente, sizeof(long));
+            ptr += sizeof(long);
+
+        }
+
+        else {
+
+            for (size_t j = 0; j < lista.apontadores.size(); ++j) {
+
+                ptr = gravarEntrada(ptr, lista.apontadores[j], incluirCampos ? &lista.campos[j] : nullptr);
+
+            }
+
+        }
+
+    }
+
+}
+
+void BPlusTreeTitulo::deserializaNo(const char* buffer, NoTitulo& no) const {
+
+    const char* ptr = buffer;
+    int numChaves = 0;
+
+    memcpy(&no.ehFolha, ptr, sizeof(bool));
+    ptr += sizeof(bool);
+    memcpy(&numChaves, ptr, sizeof(int));
+    ptr += sizeof(int);
+    memcpy(&no.proximo, ptr, sizeof(long));
+    ptr += sizeof(long);
+
+    uint16_t tamPrefixo = 0;
+    memcpy(&tamPrefixo, ptr, sizeof(uint16_t));
+    ptr += sizeof(uint16_t);
+
+    const char* prefixo = ptr;
+    ptr += tamPrefixo;
+
+    no.vetorChaves.resize(numChaves);
+
+    for (int i = 0; i < numChaves; ++i) {
+
+        uint16_t tamSufixo = 0;
+        memcpy(&tamSufixo, ptr, sizeof(uint16_t));
+        ptr += sizeof(uint16_t);
+
+        std::string& chave = no.vetorChaves[i];
+        chave.assign(prefixo, tamPrefixo);
+        chave.append(ptr, tamSufixo);
+        ptr += tamSufixo;
+
+    }
+
+    if (!no.ehFolha) {
+
+        no.postagens.clear();
+        no.vetorApontadores.resize(numChaves + 1);
+        memcpy(no.vetorApontadores.data(), ptr, (numChaves + 1) * sizeof(long));
+
+        return;
+
+    }
+
+    no.vetorApontadores.clear();
+    no.postagens.resize(numChaves);
+
+    for (int i = 0; i < numChaves; ++i) {
+
+        ListaPostagem& lista = no.postagens[i];
+        memcpy(&lista.total, ptr, sizeof(int));
+        ptr += sizeof(int);
+
+        if (lista.total > ListaPostagem::LIMITE_INLINE) {
+
+            memcpy(&lista.paginaExcedente, ptr, sizeof(long));
+            ptr += sizeof(long);
+            lista.apontadores.clear();
+            lista.campos.clear();
+
+        }
+
+        else {
+
+            lista.paginaExcedente = -1;
+            lista.apontadores.resize(lista.total);
+            lista.campos.resize(incluirCampos ? lista.total : 0);
+
+            for (int j = 0; j < lista.total; ++j) {
+
+                ptr = lerEntrada(ptr, lista.apontadores[j], incluirCampos ? &lista.campos[j] : nullptr);
+
+            }
+
+        }
+
+    }
+
+}
+
+void BPlusTreeTitulo::escreverNo(const NoTitulo& no) {
+
+    std::vector<char> buffer(tamanhoBloco, 0);
+    serializaNo(no, buffer.data());
+    gerenciador.escreveBloco(no.selfId, buffer.data());
+
+}
+
+void BPlusTreeTitulo::lerNo(long idBloco, NoTitulo& no) const {
+
+    std::vector<char> buffer(tamanhoBloco);
+    gerenciador.lerBloco(idBloco, buffer.data());
+    deserializaNo(buffer.data(), no);
+    no.selfId = idBloco;
+
+}
+
+void BPlusTreeTitulo::adicionarPostagem(ListaPostagem& lista, long dataPointer, const CamposIncluidos* campos) {
+
+    lista.total++;
+
+    if (lista.paginaExcedente == -1 && lista.total <= ListaPostagem::LIMITE_INLINE) {
+
+        lista.apontadores.push_back(dataPointer);
+
+        if (incluirCampos) {
+
+            lista.campos.push_back(*campos);
+
+        }
+
+        return;
+
+    }
+
+    const int capacidade = static_cast<int>((tamanhoBloco - TAM_CABECALHO_EXCEDENTE) / tamanhoEntrada);
+    std::vector<char> buffer(tamanhoBloco, 0);
+
+    int numApontadores = 0;
+    long proxima = -1;
+
+    if (lista.paginaExcedente != -1) {
+
+        gerenciador.lerBloco(lista.paginaExcedente, buffer.data());
+        memcpy(&numApontadores, buffer.data(), sizeof(int));
+
+        if (numApontadores < capacidade) {
+
+            gravarEntrada(buffer.data() + TAM_CABECALHO_EXCEDENTE + numApontadores * tamanhoEntrada, dataPointer, campos);
+            numApontadores++;
+            memcpy(buffer.data(), &numApontadores, sizeof(int));
+            gerenciador.escreveBloco(lista.paginaExcedente, buffer.data());
+
+            return;
+
+        }
+
+        // Página cheia: a nova página entra no início da cadeia
+        proxima = lista.paginaExcedente;
+        std::fill(buffer.begin(), buffer.end(), 0);
+        numApontadores = 0;
+
+    }
+
+    // Passou do limite: as entradas da folha vão para a primeira página de excedente
+    char* ptr = buffer.data() + TAM_CABECALHO_EXCEDENTE;
+
+    for (size_t j = 0; j < lista.apontadores.size(); ++j) {
+
+        ptr = gravarEntrada(ptr, lista.apontadores[j], incluirCampos ? &lista.campos[j] : nullptr);
+        numApontadores++;
+
+    }
+
+    gravarEntrada(ptr, dataPointer, campos);
+    numApontadores++;
+
+    lista.apontadores.clear();
+    lista.campos.clear();
+
+    long idPagina = getNovoId();
+    memcpy(buffer.data(), &numApontadores, sizeof(int));
+    memcpy(buffer.data() + sizeof(int), &proxima, sizeof(long));
+    gerenciador.escreveBloco(idPagina, buffer.data());
+
+    lista.paginaExcedente = idPagina;
+
+}
+
+long BPlusTreeTitulo::lerPostagem(const ListaPostagem& lista, std::vector<long>& destino, std::vector<CamposIncluidos>* campos) const {
+
+    if (!incluirCampos) {
+
+        campos = nullptr;
+
+    }
+
+    if (lista.paginaExcedente == -1) {
+
+        destino.assign(lista.apontadores.begin(), lista.apontadores.end());
+
+        if (campos) {
+
+            campos->assign(lista.campos.begin(), lista.campos.end());
+
+        }
+
+        return 0;
+
+    }
+
+    destino.clear();
+    destino.reserve(lista.total);
+
+    if (campos) {
+
+        campos->clear();
+        campos->reserve(lista.total);
+
+    }
+
+    std::vector<char> buffer(tamanhoBloco);
+    long paginasLidas = 0;
+
+    for (long idPagina = lista.paginaExcedente; idPagina != -1;) {
+
+        gerenciador.lerBloco(idPagina, buffer.data());
+        paginasLidas++;
+
+        int numApontadores = 0;
+        memcpy(&numApontadores, buffer.data(), sizeof(int));
+        memcpy(&idPagina, buffer.data() + sizeof(int), sizeof(long));
+
+        const char* ptr = buffer.data() + TAM_CABECALHO_EXCEDENTE;
+
+        for (int i = 0; i < numApontadores; ++i) {
+
+            long apontador = 0;
+            CamposIncluidos incluidos;
+            ptr = lerEntrada(ptr, apontador, incluirCampos ? &incluidos : nullptr);
+            destino.push_back(apontador);
+
+            if (campos) {
+
+                campos->push_back(incluidos);
+
+            }
+
+        }
+
+    }
+
+    return paginasLidas;
+
+}
+
+long BPlusTreeTitulo::getNovoId() {
+
+    long id = this->totalBlocos;
+    this->totalBlocos++;
+    this->cabecalhoAlterado = true;
+    return id;
+
+}
+
+size_t BPlusTreeTitulo::escolherPontoDivisao(const NoTitulo& no) const {
+
+    size_t n = no.vetorChaves.size();
+    size_t prefixo = prefixoDoNo(no);
+
+    // acumulado[i] = bytes das entradas [0, i) com o prefixo atual do nó (chave + apontador ou lista de postagem)
+    std::vector<size_t> acumulado(n + 1, 0);
+
+    for (size_t i = 0; i < n; ++i) {
+
+        size_t apontadores = no.ehFolha ? tamanhoPostagem(no.postagens[i]) : sizeof(long);
+        acumulado[i + 1] = acumulado[i] + sizeof(uint16_t) + (no.vetorChaves[i].size() - prefixo) + apontadores;
+
+    }
+
+    size_t total = acumulado[n];
+
+    // Em folhas a divisão é antes da chave k (k em [1, n-1]);
+    // em nós internos a chave k é promovida (k em [1, n-2]).
+    size_t minimo = 1;
+    size_t maximo = no.ehFolha ? n - 1 : n - 2;
+
+    size_t k = minimo;
+
+    while (k < maximo && acumulado[k] * 2 < total) {
+
+        k++;
+
+    }
+
+    return k;
+
+}
+
+void BPlusTreeTitulo::dividirNo(NoTitulo& no, std::string& separador, long& idNovoIrmao) {
+
+    size_t k = escolherPontoDivisao(no);
+
+    NoTitulo novoIrmao(no.ehFolha);
+    novoIrmao.selfId = getNovoId();
+
+    if (no.ehFolha) {
+
+        novoIrmao.vetorChaves.assign(no.vetorChaves.begin() + k, no.vetorChaves.end());
+        novoIrmao.postagens.assign(no.postagens.begin() + k, no.postagens.end());
+
+        no.vetorChaves.resize(k);
+        no.postagens.resize(k);
+
+        novoIrmao.proximo = no.proximo;
+        no.proximo = novoIrmao.selfId;
+
+        separador = separadorMinimo(no.vetorChaves.back(), novoIrmao.vetorChaves.front());
+
+    }
+
+    else {
+
+        separador = no.vetorChaves[k];
+
+        novoIrmao.vetorChaves.assign(no.vetorChaves.begin() + k + 1, no.vetorChaves.end());
+        novoIrmao.vetorApontadores.assign(no.vetorApontadores.begin() + k + 1, no.vetorApontadores.end());
+
+        no.vetorChaves.resize(k);
+        no.vetorApontadores.resize(k + 1);
+
+    }
+
+    if (tamanhoSerializado(no) > tamanhoBloco || tamanhoSerializado(novoIrmao) > tamanhoBloco) {
+
+        throw std::runtime_error("Erro: Divisao do no " + std::to_string(no.selfId) + " do indice de titulos nao coube no bloco.");
+
+    }
+
+    escreverNo(no);
+    escreverNo(novoIrmao);
+
+    idNovoIrmao = novoIrmao.selfId;
+
+}
+
+bool BPlusTreeTitulo::insertRecursivo(long idNo, const std::string& chave, long dataPointer, const CamposIncluidos* campos, std::string& separador, long& idNovoIrmao) {
+
+    NoTitulo no;
+    lerNo(idNo, no);
+
+    if (no.ehFolha) {
+
+        // Chave já existente: só a lista de postagem cresce
+        size_t i = std::lower_bound(no.vetorChaves.begin(), no.vetorChaves.end(), chave) - no.vetorChaves.begin();
+
+        if (i < no.vetorChaves.size() && no.vetorChaves[i] == chave) {
+
+            adicionarPostagem(no.postagens[i], dataPointer, campos);
+
+        }
+
+        else {
+
+            no.vetorChaves.insert(no.vetorChaves.begin() + i, chave);
+            no.postagens.insert(no.postagens.begin() + i, ListaPostagem());
+            adicionarPostagem(no.postagens[i], dataPointer, campos);
+
+        }
+
+    }
+
+    else {
+
+        // Separador igual à chave: a chave está à direita (separador <= primeira chave da folha direita)
+        size_t i = std::upper_bound(no.vetorChaves.begin(), no.vetorChaves.end(), chave) - no.vetorChaves.begin();
+
+        std::string separadorFilho;
+        long idNovoFilho = -1;
+
+        if (!insertRecursivo(no.vetorApontadores[i], chave, dataPointer, campos, separadorFilho, idNovoFilho)) {
+
+            return false;
+
+        }
+
+        no.vetorChaves.insert(no.vetorChaves.begin() + i, separadorFilho);
+        no.vetorApontadores.insert(no.vetorApontadores.begin() + i + 1, idNovoFilho);
+
+    }
+
+    if (tamanhoSerializado(no) <= tamanhoBloco) {
+
+        escreverNo(no);
+
+        return false;
+
+    }
+
+    dividirNo(no, separador, idNovoIrmao);
+
+    return true;
+
+}
+
+void BPlusTreeTitulo::insert(const std::string& chave, long dataPointer, const CamposIncluidos* campos) {
+
+    if (incluirCampos && !campos) {
+
+        throw std::invalid_argument("Erro: O indice de titulos com campos incluidos exige id, ano e citacoes em cada insercao.");
+
+    }
+
+    if (!incluirCampos) {
+
+        campos = nullptr;
+
+    }
+
+    std::string chaveTruncada = chave.substr(0, TAMANHO_MAX_CHAVE);
+
+    if (idRaiz == -1) {
+
+        NoTitulo primeiraRaiz(true);
+        primeiraRaiz.selfId = getNovoId();
+        primeiraRaiz.vetorChaves.push_back(chaveTruncada);
+        primeiraRaiz.postagens.push_back(ListaPostagem());
+        adicionarPostagem(primeiraRaiz.postagens.back(), dataPointer, campos);
+
+        this->idRaiz = primeiraRaiz.selfId;
+
+        escreverNo(primeiraRaiz);
+        escreverCabecalho();
+
+        return;
+
+    }
+
+    std::string separador;
+    long idNovoIrmao = -1;
+
+    if (insertRecursivo(idRaiz, chaveTruncada, dataPointer, campos, separador, idNovoIrmao)) {
+
+        NoTitulo novaRaiz(false);
+        novaRaiz.selfId = getNovoId();
+        novaRaiz.vetorChaves.push_back(separador);
+        novaRaiz.vetorApontadores.push_back(idRaiz);
+        novaRaiz.vetorApontadores.push_back(idNovoIrmao);
+
+        this->idRaiz = novaRaiz.selfId;
+
+        escreverNo(novaRaiz);
+        escreverCabecalho();
+
+    }
+
+}
+
+std::vector<long> BPlusTreeTitulo::search(const std::string& chave, long* blocosLidos) const {
+
+    std::vector<long> resultados;
+    Cursor cursor = lowerBound(chave);
+
+    if (cursor.valido() && cursor.chave() == chave) {
+
+        resultados = cursor.postagens();
+
+    }
+
+    if (blocosLidos) {
+
+        *blocosLidos += cursor.getBlocosLidos();
+
+    }
+
+    return resultados;
+
+}
+
+std::vector<CamposIncluidos> BPlusTreeTitulo::searchIncluidos(const std::string& chave, long* blocosLidos) const {
+
+    if (!incluirCampos) {
+
+        throw std::runtime_error("Erro: O indice de titulos nao tem campos incluidos. Refaca o upload com --indice-titulo-cobertura.");
+
+    }
+
+    std::vector<CamposIncluidos> resultados;
+    Cursor cursor = lowerBound(chave);
+
+    if (cursor.valido() && cursor.chave() == chave) {
+
+        resultados = cursor.postagensIncluidas();
+
+    }
+
+    if (blocosLidos) {
+
+        *blocosLidos += cursor.getBlocosLidos();
+
+    }
+
+    return resultados;
+
+}
+
+BPlusTreeTitulo::Cursor BPlusTreeTitulo::lowerBound(const std::string& chave, int leituraAntecipada) const {
+
+    Cursor cursor(this, leituraAntecipada);
+
+    if (idRaiz == -1) {
+
+        return cursor;
+
+    }
+
+    NoTitulo& noAtual = cursor.folha;
+    cursor.carregarNo(idRaiz);
+
+    // 1. Desce até a folha. As chaves das folhas são únicas e cada separador é <= primeira
+    // chave da subárvore direita, então em caso de igualdade a descida é pela direita.
+    while (!noAtual.ehFolha) {
+
+        size_t i = std::upper_bound(noAtual.vetorChaves.begin(), noAtual.vetorChaves.end(), chave) - noAtual.vetorChaves.begin();
+
+        cursor.carregarNo(noAtual.vetorApontadores[i]);
+
+    }
+
+    // 2. Primeira chave >= busca na folha (ou nas seguintes)
+    cursor.posicao = std::lower_bound(noAtual.vetorChaves.begin(), noAtual.vetorChaves.end(), chave) - noAtual.vetorChaves.begin();
+    cursor.posicaoPostagem = 0;
+    cursor.ativo = true;
+    cursor.antecipar();
+    cursor.ajustar();
+
+    return cursor;
+
+}
+
+void BPlusTreeTitulo::Cursor::carregarNo(long idBloco) {
+
+    arvore->lerNo(idBloco, folha);
+    blocosLidos++;
+
+}
+
+void BPlusTreeTitulo::Cursor::carregarPostagem() {
+
+    blocosLidos += arvore->lerPostagem(folha.postagens[posicao], postagem, &campos);
+    posicaoPostagem = 0;
+
+}
+
+void BPlusTreeTitulo::Cursor::ajustar() {
+
+    while (ativo && posicao >= folha.vetorChaves.size()) {
+
+        if (folha.proximo == -1) {
+
+            ativo = false;
+
+            return;
+
+        }
+
+        carregarNo(folha.proximo);
+        posicao = 0;
+        antecipar();
+
+    }
+
+    if (ativo) {
+
+        carregarPostagem();
+
+    }
+
+}
+
+void BPlusTreeTitulo::Cursor::antecipar() {
+
+    if (leituraAntecipada > 0 && folha.proximo != -1) {
+
+        arvore->gerenciador.sugerirLeitura(folha.proximo, leituraAntecipada);
+
+    }
+
+}
+
+void BPlusTreeTitulo::Cursor::next() {
+
+    if (!ativo) {
+
+        return;
+
+    }
+
+    if (++posicaoPostagem < postagem.size()) {
+
+        return;
+
+    }
+
+    posicao++;
+    ajustar();
+
+}
+
+void BPlusTreeTitulo::Cursor::proximaChave() {
+
+    if (!ativo) {
+
+        return;
+
+    }
+
+    posicao++;
+    ajustar();
+
+}
+
+long BPlusTreeTitulo::fixarNiveisSuperiores(int niveis) {
+
+    long fixados = 0;
+
+    if (idRaiz == -1) {
+
+        return fixados;
+
+    }
+
+    std::vector<long> nivel(1, idRaiz);
+    NoTitulo no;
+
+    for (int n = 0; n < niveis && !nivel.empty(); ++n) {
+
+        std::vector<long> proximoNivel;
+
+        for (long id : nivel) {
+
+            lerNo(id, no);
+
+            if (no.ehFolha) {
+
+                continue;
+
+            }
+
+            gerenciador.fixarBloco(id);
+            fixados++;
+            proximoNivel.insert(proximoNivel.end(), no.vetorApontadores.begin(), no.vetorApontadores.end());
+
+        }
+
+        nivel.swap(proximoNivel);
+
+    }
+
+    return fixados;
+
+}
+
+void BPlusTreeTitulo::flush() {
+
+    if (cabecalhoAlterado) {
+
+        escreverCabecalho();
+
+    }
+
+    gerenciador.flush();
+
+}
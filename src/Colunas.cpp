@@ -0,0 +1,495 @@
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "Colunas.hpp"
+#include "Log.hpp"
+
+static const char ASSINATURA_COLUNA[8] = {'C', 'O', 'L', 'U', 'N', 'A', '0', '1'};
+static const uint32_t VERSAO_COLUNA = 1;
+static const size_t TAMANHO_BUFFER_COLUNA = 1 << 20;
+
+// Linhas filtradas por vez: a máscara do trecho cabe no L1
+static const size_t TAMANHO_TRECHO = 4096;
+
+const char* nomeColuna(Coluna coluna) {
+
+    switch (coluna) {
+
+        case Coluna::ID: return "id";
+        case Coluna::ANO: return "ano";
+        case Coluna::CITACOES: return "citacoes";
+        case Coluna::BUCKET: return "bucket";
+        case Coluna::ATUALIZACAO: return "atualizacao";
+        case Coluna::NUM_COLUNAS: break;
+
+    }
+
+    return "?";
+
+}
+
+size_t larguraColuna(Coluna coluna) {
+
+    switch (coluna) {
+
+        case Coluna::ID: return sizeof(int32_t);
+        case Coluna::ANO: return sizeof(int16_t);
+        case Coluna::CITACOES: return sizeof(int32_t);
+        case Coluna::BUCKET: return sizeof(uint32_t);
+        case Coluna::ATUALIZACAO: return sizeof(int64_t);
+        case Coluna::NUM_COLUNAS: break;
+
+    }
+
+    return 0;
+
+}
+
+static std::string caminhoColuna(const std::string& diretorio, Coluna coluna) {
+
+    return diretorio + "/" + nomeColuna(coluna) + ".col";
+
+}
+
+// Lê 'digitos' dígitos decimais a partir de 'pos'; 'false' se algum não for dígito.
+static bool lerNumero(std::string_view texto, size_t pos, size_t digitos, int& valor) {
+
+    if (pos + digitos > texto.size()) {
+
+        return false;
+
+    }
+
+    valor = 0;
+
+    for (size_t i = pos; i < pos + digitos; ++i) {
+
+        if (texto[i] < '0' || texto[i] > '9') {
+
+            return false;
+
+        }
+
+        valor = valor * 10 + (texto[i] - '0');
+
+    }
+
+    return true;
+
+}
+
+bool epochDeData(std::string_view texto, int64_t& segundos) {
+
+    int ano = 0, mes = 0, dia = 0, hora = 0, minuto = 0, segundo = 0;
+
+    if (!lerNumero(texto, 0, 4, ano) || texto.size() < 10 || texto[4] != '-' || texto[7] != '-' ||
+        !lerNumero(texto, 5, 2, mes) || !lerNumero(texto, 8, 2, dia) || mes < 1 || mes > 12 || dia < 1 || dia > 31) {
+
+        return false;
+
+    }
+
+    if (texto.size() > 10) {
+
+        if (texto.size() < 19 || (texto[10] != ' ' && texto[10] != 'T') || texto[13] != ':' || texto[16] != ':' ||
+            !lerNumero(texto, 11, 2, hora) || !lerNumero(texto, 14, 2, minuto) || !lerNumero(texto, 17, 2, segundo)) {
+
+            return false;
+
+        }
+
+    }
+
+    // Dias desde 1970-01-01 no calendário gregoriano (algoritmo days_from_civil de H. Hinnant)
+    int64_t a = ano - (mes <= 2 ? 1 : 0);
+    int64_t era = (a >= 0 ? a : a - 399) / 400;
+    int64_t ano_da_era = a - era * 400;
+    int64_t dia_do_ano = (153 * (mes + (mes > 2 ? -3 : 9)) + 2) / 5 + dia - 1;
+    int64_t dia_da_era = ano_da_era * 365 + ano_da_era / 4 - ano_da_era / 100 + dia_do_ano;
+    int64_t dias = era * 146097 + dia_da_era - 719468;
+
+    segundos = dias * 86400 + hora * 3600 + minuto * 60 + segundo;
+
+    return true;
+
+}
+
+//#################################################################
+// Escrita
+//#################################################################
+
+EscritorColunas::EscritorColunas(const std::string& diretorio, bool com_atualizacao)
+    : diretorio(diretorio), com_atualizacao(com_atualizacao), linhas(0) {
+
+    std::filesystem::create_directories(diretorio);
+
+    for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+        Coluna coluna = static_cast<Coluna>(c);
+        std::string caminho = caminhoColuna(diretorio, coluna);
+
+        std::filesystem::remove(caminho);
+
+        if (coluna == Coluna::ATUALIZACAO && !com_atualizacao) {
+
+            continue;
+
+        }
+
+        // O buffer precisa ser instalado antes de abrir o arquivo
+        buffers[c].reset(new char[TAMANHO_BUFFER_COLUNA]);
+        arquivos[c].rdbuf()->pubsetbuf(buffers[c].get(), TAMANHO_BUFFER_COLUNA);
+        arquivos[c].open(caminho, std::ios::binary | std::ios::trunc);
+
+        if (!arquivos[c].is_open()) {
+
+            throw std::runtime_error("[Colunas] Nao foi possivel criar " + caminho);
+
+        }
+
+        CabecalhoColuna cabecalho;
+        std::memset(&cabecalho, 0, sizeof(cabecalho));
+        std::memcpy(cabecalho.assinatura, ASSINATURA_COLUNA, sizeof(cabecalho.assinatura));
+        cabecalho.versao = VERSAO_COLUNA;
+        cabecalho.largura = static_cast<uint32_t>(larguraColuna(coluna));
+        std::strncpy(cabecalho.nome, nomeColuna(coluna), sizeof(cabecalho.nome) - 1);
+
+        arquivos[c].write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+
+    }
+
+}
+
+EscritorColunas::~EscritorColunas() {
+
+    try {
+
+        sincronizar();
+
+    }
+
+    catch (const std::exception& e) {
+
+        log_error(e.what());
+
+    }
+
+}
+
+void EscritorColunas::escreverValor(Coluna coluna, const void* valor) {
+
+    size_t c = static_cast<size_t>(coluna);
+
+    arquivos[c].write(static_cast<const char*>(valor), static_cast<std::streamsize>(larguraColuna(coluna)));
+
+}
+
+void EscritorColunas::acrescentar(const Artigo& artigo, size_t bucket) {
+
+    int32_t id = artigo.id;
+    int16_t ano = static_cast<int16_t>(std::clamp<int>(artigo.ano, INT16_MIN, INT16_MAX));
+    int32_t citacoes = artigo.citacoes;
+    uint32_t bloco = static_cast<uint32_t>(bucket);
+
+    escreverValor(Coluna::ID, &id);
+    escreverValor(Coluna::ANO, &ano);
+    escreverValor(Coluna::CITACOES, &citacoes);
+    escreverValor(Coluna::BUCKET, &bloco);
+
+    if (com_atualizacao) {
+
+        int64_t segundos = 0;
+
+        if (!epochDeData(std::string_view(artigo.atualizacao, strnlen(artigo.atualizacao, sizeof(artigo.atualizacao))), segundos)) {
+
+            segundos = 0;
+
+        }
+
+        escreverValor(Coluna::ATUALIZACAO, &segundos);
+
+    }
+
+    linhas++;
+
+}
+
+void EscritorColunas::sincronizar() {
+
+    for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+        if (!arquivos[c].is_open()) {
+
+            continue;
+
+        }
+
+        arquivos[c].seekp(offsetof(CabecalhoColuna, linhas));
+        arquivos[c].write(reinterpret_cast<const char*>(&linhas), sizeof(linhas));
+        arquivos[c].seekp(0, std::ios::end);
+        arquivos[c].flush();
+
+        if (!arquivos[c]) {
+
+            throw std::runtime_error("[Colunas] Falha ao gravar " + caminhoColuna(diretorio, static_cast<Coluna>(c)));
+
+        }
+
+    }
+
+}
+
+uint64_t EscritorColunas::getBytes() const {
+
+    uint64_t bytes = 0;
+
+    for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+        if (arquivos[c].is_open()) {
+
+            bytes += sizeof(CabecalhoColuna) + linhas * larguraColuna(static_cast<Coluna>(c));
+
+        }
+
+    }
+
+    return bytes;
+
+}
+
+//#################################################################
+// Leitura
+//#################################################################
+
+LeitorColunas::LeitorColunas(const std::string& diretorio) : linhas(0) {
+
+    for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+        mapas[c] = nullptr;
+        tamanhos[c] = 0;
+
+    }
+
+    try {
+
+        for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+            Coluna coluna = static_cast<Coluna>(c);
+            std::string caminho = caminhoColuna(diretorio, coluna);
+
+            int fd = open(caminho.c_str(), O_RDONLY);
+
+            if (fd == -1) {
+
+                if (coluna == Coluna::ATUALIZACAO && errno == ENOENT) {
+
+                    continue;
+
+                }
+
+                throw std::runtime_error("[Colunas] Nao foi possivel abrir " + caminho + ": " + std::strerror(errno) + ". Refaca o upload com --colunas.");
+
+            }
+
+            struct stat info;
+
+            if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(CabecalhoColuna)) {
+
+                close(fd);
+
+                throw std::runtime_error("[Colunas] Coluna truncada: " + caminho);
+
+            }
+
+            void* mapa = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+
+            if (mapa == MAP_FAILED) {
+
+                throw std::runtime_error("[Colunas] Falha no mmap de " + caminho + ": " + std::strerror(errno));
+
+            }
+
+            mapas[c] = static_cast<const char*>(mapa);
+            tamanhos[c] = static_cast<size_t>(info.st_size);
+
+            CabecalhoColuna cabecalho;
+            std::memcpy(&cabecalho, mapa, sizeof(cabecalho));
+
+            if (std::memcmp(cabecalho.assinatura, ASSINATURA_COLUNA, sizeof(cabecalho.assinatura)) != 0 ||
+                cabecalho.versao != VERSAO_COLUNA || cabecalho.largura != larguraColuna(coluna)) {
+
+                throw std::runtime_error("[Colunas] " + caminho + " nao e uma coluna valida.");
+
+            }
+
+            if (sizeof(CabecalhoColuna) + cabecalho.linhas * cabecalho.largura > tamanhos[c]) {
+
+                throw std::runtime_error("[Colunas] Coluna truncada: " + caminho);
+
+            }
+
+            if (c > 0 && cabecalho.linhas != linhas) {
+
+                throw std::runtime_error("[Colunas] " + caminho + " tem " + std::to_string(cabecalho.linhas) + " linhas; as demais colunas tem " + std::to_string(linhas) + ".");
+
+            }
+
+            linhas = cabecalho.linhas;
+
+        }
+
+    }
+
+    catch (...) {
+
+        liberar();
+
+        throw;
+
+    }
+
+}
+
+LeitorColunas::~LeitorColunas() {
+
+    liberar();
+
+}
+
+void LeitorColunas::liberar() {
+
+    for (size_t c = 0; c < NUM_COLUNAS; ++c) {
+
+        if (mapas[c] != nullptr) {
+
+            munmap(const_cast<char*>(mapas[c]), tamanhos[c]);
+            mapas[c] = nullptr;
+
+        }
+
+    }
+
+}
+
+void LeitorColunas::aconselharSequencial(Coluna coluna) const {
+
+    size_t c = static_cast<size_t>(coluna);
+
+    if (mapas[c] != nullptr) {
+
+        madvise(const_cast<char*>(mapas[c]), tamanhos[c], MADV_SEQUENTIAL);
+        madvise(const_cast<char*>(mapas[c]), tamanhos[c], MADV_WILLNEED);
+
+    }
+
+}
+
+//#################################################################
+// Agregação
+//#################################################################
+
+// Máscara das linhas aceitas. Chamada com n constante (TAMANHO_TRECHO) nos trechos cheios,
+// o laço sem desvios é vetorizado mesmo no -O2 (sem laço de sobra para o fim do trecho).
+static inline void mascararTrecho(const int16_t* anos, const int32_t* citacoes, const int64_t* atualizacoes, size_t n,
+                                  const FiltroColunas& filtro, uint8_t* aceita) {
+
+    const int16_t ano_min = filtro.ano_min;
+    const int16_t ano_max = filtro.ano_max;
+    const int32_t citacoes_min = filtro.citacoes_min;
+
+    for (size_t i = 0; i < n; ++i) {
+
+        aceita[i] = static_cast<uint8_t>((anos[i] >= ano_min) & (anos[i] <= ano_max) & (citacoes[i] >= citacoes_min));
+
+    }
+
+    if (atualizacoes != nullptr) {
+
+        const int64_t desde = filtro.atualizado_desde;
+
+        for (size_t i = 0; i < n; ++i) {
+
+            aceita[i] &= static_cast<uint8_t>(atualizacoes[i] >= desde);
+
+        }
+
+    }
+
+}
+
+void agregarColunas(const LeitorColunas& colunas, const FiltroColunas& filtro, uint64_t de, uint64_t ate,
+                    AgregadoAno* por_ano, std::vector<uint64_t>* linhas_aceitas) {
+
+    const int16_t* anos = colunas.anos();
+    const int32_t* citacoes = colunas.citacoes();
+    const int64_t* atualizacoes = filtro.usaAtualizacao() ? colunas.atualizacoes() : nullptr;
+
+    if (filtro.usaAtualizacao() && atualizacoes == nullptr) {
+
+        throw std::runtime_error("[Colunas] Filtro por atualizacao sem a coluna atualizacao (upload com --colunas-atualizacao).");
+
+    }
+
+    uint8_t aceita[TAMANHO_TRECHO];
+
+    for (uint64_t inicio = de; inicio < ate; inicio += TAMANHO_TRECHO) {
+
+        const size_t n = static_cast<size_t>(std::min<uint64_t>(TAMANHO_TRECHO, ate - inicio));
+        const int16_t* a = anos + inicio;
+        const int32_t* c = citacoes + inicio;
+        const int64_t* t = atualizacoes == nullptr ? nullptr : atualizacoes + inicio;
+
+        // 1. Máscara do trecho
+        if (n == TAMANHO_TRECHO) {
+
+            mascararTrecho(a, c, t, TAMANHO_TRECHO, filtro, aceita);
+
+        }
+
+        else {
+
+            mascararTrecho(a, c, t, n, filtro, aceita);
+
+        }
+
+        // 2. Soma ao ano de cada linha; as rejeitadas somam zero (sem desvio imprevisível)
+        for (size_t i = 0; i < n; ++i) {
+
+            AgregadoAno& grupo = por_ano[a[i] - INT16_MIN];
+            const int32_t m = aceita[i];
+
+            grupo.registros += m;
+            grupo.soma_citacoes += c[i] & -m;
+            grupo.max_citacoes = (m && c[i] > grupo.max_citacoes) ? c[i] : grupo.max_citacoes;
+
+        }
+
+        if (linhas_aceitas != nullptr) {
+
+            for (size_t i = 0; i < n; ++i) {
+
+                if (aceita[i]) {
+
+                    linhas_aceitas->push_back(inicio + i);
+
+                }
+
+            }
+
+        }
+
+    }
+
+}
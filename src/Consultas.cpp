@@ -0,0 +1,61 @@
+#include <algorithm>
+#include <cstring>
+
+#include "Consultas.hpp"
+#include "BlocoDeDados.hpp"
+
+ResultadoConsulta consultarPorTitulo(IndiceTitulo& indice, GerenciadorArquivoDados& dados, const std::string& titulo) {
+
+    ResultadoConsulta resultado;
+
+    // 1. Busca no Índice B+Tree. Retorna a lista de postagem do título (candidatos, no modo hash).
+    std::vector<long> ids_buckets = indice.search(titulo, &resultado.blocos_indice);
+
+    // 2. Ordena e remove IDs repetidos (dois registros com o mesmo título no mesmo bucket)
+    std::sort(ids_buckets.begin(), ids_buckets.end());
+    ids_buckets.erase(std::unique(ids_buckets.begin(), ids_buckets.end()), ids_buckets.end());
+
+    // 3. Para cada bucket ID encontrado, busca no arquivo de dados
+    for (long id_bucket : ids_buckets) {
+
+        BlocoDeDados* bucket = static_cast<BlocoDeDados*>(dados.getPonteiroBloco(id_bucket));
+        resultado.blocos_dados++;
+
+        // Varre o bucket para encontrar o(s) registro(s) com o título exato (descarta colisões do modo hash)
+        for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+            if (std::strcmp(bucket->registros[i].titulo, titulo.c_str()) == 0) {
+
+                resultado.registros.push_back(bucket->registros[i]);
+
+            }
+
+        }
+
+    }
+
+    return resultado;
+
+}
+
+ResultadoConsulta consultarCamposPorTitulo(IndiceTitulo& indice, const std::string& titulo) {
+
+    ResultadoConsulta resultado;
+
+    // Uma entrada por registro inserido: não há buckets para deduplicar
+    for (const CamposIncluidos& campos : indice.searchIncluidos(titulo, &resultado.blocos_indice)) {
+
+        ArtigoView artigo;
+
+        artigo.id = campos.id;
+        artigo.ano = campos.ano;
+        artigo.citacoes = campos.citacoes;
+        artigo.titulo = titulo;
+
+        resultado.registros.push_back(artigo);
+
+    }
+
+    return resultado;
+
+}
@@ -0,0 +1,228 @@
+#include <string>
+#include <vector>
+#include <ostream>
+#include <sstream>
+#include <iomanip>
+#include <cstdio>
+
+#include "EstatisticasCarga.hpp"
+#include "Log.hpp"
+
+static const size_t NUM_FASES = static_cast<size_t>(FaseCarga::NUM_FASES);
+
+const char* nomeFaseCarga(FaseCarga fase) {
+
+    switch (fase) {
+
+        case FaseCarga::INICIALIZACAO: return "inicializacao";
+        case FaseCarga::LEITURA_CSV: return "leitura_csv";
+        case FaseCarga::PARSE: return "parse";
+        case FaseCarga::HASH: return "hash";
+        case FaseCarga::INDICE_ID: return "indice_id";
+        case FaseCarga::INDICE_TITULO: return "indice_titulo";
+        case FaseCarga::INDICE_ANO: return "indice_ano";
+        case FaseCarga::INDICE_AUTORES: return "indice_autores";
+        case FaseCarga::COLUNAS: return "colunas";
+        case FaseCarga::CHECKPOINT_DADOS: return "checkpoint_dados";
+        case FaseCarga::CHECKPOINT_INDICES: return "checkpoint_indices";
+        case FaseCarga::OUTROS: return "outros";
+        case FaseCarga::NUM_FASES: break;
+
+    }
+
+    return "?";
+
+}
+
+EstatisticasCarga::EstatisticasCarga()
+    : ultima_marca(Relogio::now()),
+      inicio_intervalo(ultima_marca),
+      registros_inicio_intervalo(0),
+      tempo_checkpoint_intervalo(Relogio::duration::zero()) {
+
+    for (size_t f = 0; f < NUM_FASES; ++f) {
+
+        tempo[f] = Relogio::duration::zero();
+        chamadas[f] = 0;
+
+    }
+
+}
+
+const IntervaloCarga& EstatisticasCarga::fecharIntervalo(long registros_total) {
+
+    Relogio::time_point agora = Relogio::now();
+
+    IntervaloCarga intervalo;
+    intervalo.registros_ate = registros_total;
+    intervalo.registros = registros_total - registros_inicio_intervalo;
+    intervalo.segundos = std::chrono::duration<double>(agora - inicio_intervalo).count();
+    intervalo.segundos_checkpoint = std::chrono::duration<double>(tempo_checkpoint_intervalo).count();
+    intervalo.registros_por_s = intervalo.segundos > 0 ? intervalo.registros / intervalo.segundos : 0.0;
+
+    intervalos.push_back(intervalo);
+
+    inicio_intervalo = agora;
+    registros_inicio_intervalo = registros_total;
+    tempo_checkpoint_intervalo = Relogio::duration::zero();
+
+    return intervalos.back();
+
+}
+
+double EstatisticasCarga::getSegundos(FaseCarga fase) const {
+
+    return std::chrono::duration<double>(tempo[static_cast<size_t>(fase)]).count();
+
+}
+
+void EstatisticasCarga::relatar() const {
+
+    double total = 0.0;
+
+    for (size_t f = 0; f < NUM_FASES; ++f) {
+
+        total += getSegundos(static_cast<FaseCarga>(f));
+
+    }
+
+    log_info("\nTempo por fase:");
+
+    for (size_t f = 0; f < NUM_FASES; ++f) {
+
+        FaseCarga fase = static_cast<FaseCarga>(f);
+
+        if (chamadas[f] == 0) {
+
+            continue;
+
+        }
+
+        std::ostringstream linha;
+        linha << "  - " << std::left << std::setw(20) << nomeFaseCarga(fase) << std::right << std::fixed
+              << std::setprecision(3) << std::setw(10) << getSegundos(fase) << " s"
+              << std::setprecision(1) << std::setw(7) << (total > 0 ? 100.0 * getSegundos(fase) / total : 0.0) << "%";
+
+        log_info(linha.str());
+
+    }
+
+    log_info("\nVazão por intervalo de checkpoint:");
+
+    for (const IntervaloCarga& intervalo : intervalos) {
+
+        std::ostringstream linha;
+        linha << "  - até " << intervalo.registros_ate << " registros: " << std::fixed << std::setprecision(0)
+              << intervalo.registros_por_s << " registros/s (" << std::setprecision(3) << intervalo.segundos
+              << " s, checkpoint " << intervalo.segundos_checkpoint << " s)";
+
+        log_info(linha.str());
+
+    }
+
+}
+
+// Escreve um texto como string JSON (com aspas e escapes).
+static void escreverTextoJSON(std::ostream& saida, const std::string& texto) {
+
+    saida << '"';
+
+    for (char c : texto) {
+
+        if (c == '"' || c == '\\') {
+
+            saida << '\\' << c;
+
+        }
+
+        else if (static_cast<unsigned char>(c) < 0x20) {
+
+            char escape[8];
+            std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned char>(c));
+            saida << escape;
+
+        }
+
+        else {
+
+            saida << c;
+
+        }
+
+    }
+
+    saida << '"';
+
+}
+
+void EstatisticasCarga::escreverJSON(std::ostream& saida, const ResumoCarga& resumo) const {
+
+    saida << std::fixed << std::setprecision(6);
+
+    saida << "{\n";
+    saida << "  \"csv\": ";
+    escreverTextoJSON(saida, resumo.csv);
+    saida << ",\n";
+    saida << "  \"indice_titulo\": {\"modo\": ";
+    escreverTextoJSON(saida, resumo.modo_indice_titulo);
+    saida << ", \"cobertura\": " << (resumo.indice_titulo_cobertura ? "true" : "false") << "},\n";
+    saida << "  \"indice_ano\": " << (resumo.indice_ano ? "true" : "false") << ",\n";
+    saida << "  \"indice_autores\": " << (resumo.indice_autores ? "true" : "false") << ",\n";
+    saida << "  \"colunas\": {\"ativas\": " << (resumo.colunas ? "true" : "false")
+          << ", \"atualizacao\": " << (resumo.colunas_atualizacao ? "true" : "false") << "},\n";
+    saida << "  \"tamanho_bloco_so\": " << resumo.tamanho_bloco_so << ",\n";
+    saida << "  \"tamanho_bloco_dados\": " << resumo.tamanho_bloco_dados << ",\n";
+    saida << "  \"tamanho_bloco_btree\": " << resumo.tamanho_bloco_btree << ",\n";
+    saida << "  \"duracao_ms\": " << resumo.duracao_ms << ",\n";
+    saida << "  \"registros_inseridos\": " << resumo.registros_inseridos << ",\n";
+    saida << "  \"linhas_ignoradas\": " << resumo.linhas_ignoradas << ",\n";
+    saida << "  \"erros_insercao\": " << resumo.erros_insercao << ",\n";
+
+    saida << "  \"fases\": {";
+
+    bool primeira = true;
+
+    for (size_t f = 0; f < NUM_FASES; ++f) {
+
+        FaseCarga fase = static_cast<FaseCarga>(f);
+
+        saida << (primeira ? "\n" : ",\n") << "    \"" << nomeFaseCarga(fase) << "\": {\"segundos\": " << getSegundos(fase)
+              << ", \"chamadas\": " << chamadas[f] << "}";
+        primeira = false;
+
+    }
+
+    saida << "\n  },\n";
+    saida << "  \"intervalos\": [";
+
+    for (size_t i = 0; i < intervalos.size(); ++i) {
+
+        const IntervaloCarga& intervalo = intervalos[i];
+
+        saida << (i == 0 ? "\n" : ",\n") << "    {\"registros_ate\": " << intervalo.registros_ate
+              << ", \"registros\": " << intervalo.registros << ", \"segundos\": " << intervalo.segundos
+              << ", \"segundos_checkpoint\": " << intervalo.segundos_checkpoint
+              << ", \"registros_por_s\": " << intervalo.registros_por_s << "}";
+
+    }
+
+    saida << (intervalos.empty() ? "],\n" : "\n  ],\n");
+    saida << "  \"arquivos\": [";
+
+    for (size_t i = 0; i < arquivos.size(); ++i) {
+
+        const EstatisticasArquivoCarga& arquivo = arquivos[i];
+
+        saida << (i == 0 ? "\n" : ",\n") << "    {\"nome\": ";
+        escreverTextoJSON(saida, arquivo.nome);
+        saida << ", \"caminho\": ";
+        escreverTextoJSON(saida, arquivo.caminho);
+        saida << ", \"blocos_lidos\": " << arquivo.blocos_lidos << ", \"blocos_escritos\": " << arquivo.blocos_escritos
+              << ", \"total_blocos\": " << arquivo.total_blocos << "}";
+
+    }
+
+    saida << (arquivos.empty() ? "]\n" : "\n  ]\n");
+    saida << "}\n";
+
+}
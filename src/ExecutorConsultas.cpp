@@ -0,0 +1,154 @@
+#include <thread>
+#include <mutex>
+#include <algorithm>
+
+#include "ExecutorConsultas.hpp"
+
+ExecutorConsultas::ExecutorConsultas(int numThreads)
+    : total(0),
+      proximo(0),
+      geracao(0),
+      ativos(0),
+      encerrar(false) {
+
+    int auxiliares = std::max(numThreads, 1) - 1;
+
+    for (int i = 0; i < auxiliares; ++i) {
+
+        trabalhadores.emplace_back(&ExecutorConsultas::laco, this);
+
+    }
+
+}
+
+ExecutorConsultas::~ExecutorConsultas() {
+
+    {
+
+        std::lock_guard<std::mutex> trava(mutex);
+        encerrar = true;
+
+    }
+
+    cv_tarefa.notify_all();
+
+    for (std::thread& t : trabalhadores) {
+
+        t.join();
+
+    }
+
+}
+
+void ExecutorConsultas::processar() {
+
+    while (true) {
+
+        size_t i = proximo.fetch_add(1, std::memory_order_relaxed);
+
+        if (i >= total) {
+
+            return;
+
+        }
+
+        try {
+
+            tarefa(i);
+
+        }
+
+        catch (...) {
+
+            std::lock_guard<std::mutex> trava(mutex);
+
+            if (!erro) {
+
+                erro = std::current_exception();
+
+            }
+
+        }
+
+    }
+
+}
+
+void ExecutorConsultas::laco() {
+
+    size_t geracao_vista = 0;
+
+    while (true) {
+
+        {
+
+            std::unique_lock<std::mutex> trava(mutex);
+            cv_tarefa.wait(trava, [&] { return encerrar || geracao != geracao_vista; });
+
+            if (encerrar) {
+
+                return;
+
+            }
+
+            geracao_vista = geracao;
+
+        }
+
+        processar();
+
+        {
+
+            std::lock_guard<std::mutex> trava(mutex);
+
+            if (--ativos == 0) {
+
+                cv_concluida.notify_one();
+
+            }
+
+        }
+
+    }
+
+}
+
+void ExecutorConsultas::paraCada(size_t total, const std::function<void(size_t)>& tarefa) {
+
+    {
+
+        std::lock_guard<std::mutex> trava(mutex);
+
+        this->tarefa = tarefa;
+        this->total = total;
+        this->proximo.store(0, std::memory_order_relaxed);
+        this->ativos = trabalhadores.size();
+        this->erro = nullptr;
+        this->geracao++;
+
+    }
+
+    cv_tarefa.notify_all();
+
+    // A thread chamadora também consome o lote
+    processar();
+
+    std::exception_ptr erro_lote;
+
+    {
+
+        std::unique_lock<std::mutex> trava(mutex);
+        cv_concluida.wait(trava, [&] { return ativos == 0; });
+
+        this->tarefa = nullptr;
+        erro_lote = this->erro;
+
+    }
+
+    if (erro_lote) {
+
+        std::rethrow_exception(erro_lote);
+
+    }
+
+}
@@ -0,0 +1,418 @@
+#include <string>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+#include "GeradorCSV.hpp"
+
+// Sílabas das palavras geradas: só letras, então nenhum campo precisa de escape no CSV
+static const char* const SILABAS[] = {
+    "ta", "ne", "ro", "li", "sa", "mi", "co", "de", "ver", "al", "in", "tra", "por", "ma", "ge",
+    "lo", "ri", "da", "pen", "se", "vi", "to", "nu", "ca", "ble", "ex", "mo", "pa", "ti", "ra",
+    "sen", "te", "pro", "cu", "di", "na", "lu", "fe", "go", "re"
+};
+
+static const char* const NOMES[] = {
+    "Ana", "Bruno", "Carla", "Daniel", "Elisa", "Felipe", "Gabriela", "Hugo", "Isabel", "Joao",
+    "Karen", "Lucas", "Marina", "Nuno", "Olivia", "Paulo", "Rafaela", "Sergio", "Tatiana", "Victor"
+};
+
+static const char* const SOBRENOMES[] = {
+    "Silva", "Santos", "Oliveira", "Souza", "Lima", "Pereira", "Costa", "Rodrigues", "Almeida", "Nascimento",
+    "Carvalho", "Gomes", "Martins", "Araujo", "Ribeiro", "Barbosa", "Rocha", "Dias", "Teixeira", "Moreira"
+};
+
+static const size_t NUM_SILABAS = sizeof(SILABAS) / sizeof(SILABAS[0]);
+static const size_t NUM_NOMES = sizeof(NOMES) / sizeof(NOMES[0]);
+static const size_t NUM_SOBRENOMES = sizeof(SOBRENOMES) / sizeof(SOBRENOMES[0]);
+
+bool ordemIdsDeString(const std::string& nome, OrdemIds& ordem) {
+
+    if (nome == "sequencial") {
+
+        ordem = OrdemIds::SEQUENCIAL;
+
+        return true;
+
+    }
+
+    if (nome == "embaralhada") {
+
+        ordem = OrdemIds::EMBARALHADA;
+
+        return true;
+
+    }
+
+    if (nome == "agrupada") {
+
+        ordem = OrdemIds::AGRUPADA;
+
+        return true;
+
+    }
+
+    return false;
+
+}
+
+// Mistura de 64 bits (finalizador do splitmix64)
+static uint64_t misturar(uint64_t x) {
+
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+
+    return x ^ (x >> 31);
+
+}
+
+// Auxiliares da amostragem Zipf, estáveis perto de zero
+static double log1pSobreX(double x) {
+
+    return std::fabs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+
+}
+
+static double expm1SobreX(double x) {
+
+    return std::fabs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+
+}
+
+GeradorCSV::GeradorCSV(const ConfiguracaoGerador& configuracao)
+    : config(configuracao),
+      aleatorio(configuracao.semente),
+      geradas(0),
+      malformadas(0),
+      bits_permutacao(1),
+      proximo_id_grupo(configuracao.primeiro_id),
+      restantes_no_grupo(configuracao.tamanho_grupo) {
+
+    if (config.linhas < 0 || config.primeiro_id <= 0 || config.tamanho_grupo <= 0 || config.lacuna_media < 0.0) {
+
+        throw std::invalid_argument("[GeradorCSV] Configuração inválida (linhas, primeiro ID, grupo ou lacuna).");
+
+    }
+
+    if (config.ordem != OrdemIds::AGRUPADA && config.primeiro_id + config.linhas - 1 > INT32_MAX) {
+
+        throw std::invalid_argument("[GeradorCSV] Os IDs passariam de INT32_MAX.");
+
+    }
+
+    if (config.taxa_malformadas < 0.0 || config.taxa_malformadas > 1.0 || config.ano_minimo > config.ano_maximo || config.titulos_distintos < 0) {
+
+        throw std::invalid_argument("[GeradorCSV] Configuração inválida (taxa de malformadas, anos ou títulos distintos).");
+
+    }
+
+    // Domínio 2^k da permutação (cycle walking até cair em [0, linhas))
+    while ((1ULL << bits_permutacao) < static_cast<uint64_t>(std::max<long>(config.linhas, 1))) {
+
+        bits_permutacao++;
+
+    }
+
+    for (int i = 0; i < 4; ++i) {
+
+        chaves_permutacao[i] = misturar(config.semente + 0x1000 + i);
+
+    }
+
+    zipf_s = std::max(config.expoente_zipf, 0.0);
+
+    if (config.titulos_distintos > 0) {
+
+        zipf_h_integral_x1 = zipfHIntegral(1.5) - 1.0;
+        zipf_h_integral_n = zipfHIntegral(config.titulos_distintos + 0.5);
+
+    }
+
+}
+
+double GeradorCSV::uniforme() {
+
+    // 53 bits da saída crua: [0, 1)
+    return static_cast<double>(aleatorio() >> 11) * (1.0 / 9007199254740992.0);
+
+}
+
+long GeradorCSV::inteiro(long minimo, long maximo) {
+
+    return minimo + static_cast<long>(aleatorio() % static_cast<uint64_t>(maximo - minimo + 1));
+
+}
+
+double GeradorCSV::normal() {
+
+    // Box-Muller
+    double u1 = 1.0 - uniforme();
+    double u2 = uniforme();
+
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+
+}
+
+uint64_t GeradorCSV::permutar(uint64_t indice) const {
+
+    const uint64_t mascara = (bits_permutacao >= 64) ? ~0ULL : ((1ULL << bits_permutacao) - 1);
+    const int deslocamento = bits_permutacao / 2 + 1;
+
+    uint64_t x = indice;
+
+    do {
+
+        // Cada passo é uma bijeção em [0, 2^k): soma, produto por ímpar e xorshift
+        for (int r = 0; r < 4; ++r) {
+
+            x = (x + chaves_permutacao[r]) & mascara;
+            x = (x * (chaves_permutacao[r] | 1ULL)) & mascara;
+            x ^= x >> deslocamento;
+
+        }
+
+    } while (x >= static_cast<uint64_t>(config.linhas));
+
+    return x;
+
+}
+
+long GeradorCSV::proximoId() {
+
+    switch (config.ordem) {
+
+        case OrdemIds::SEQUENCIAL:
+
+            return config.primeiro_id + geradas;
+
+        case OrdemIds::EMBARALHADA:
+
+            return config.primeiro_id + static_cast<long>(permutar(static_cast<uint64_t>(geradas)));
+
+        case OrdemIds::AGRUPADA:
+
+            break;
+
+    }
+
+    if (restantes_no_grupo == 0) {
+
+        // Lacuna com distribuição exponencial de média lacuna_media * tamanho_grupo
+        double media = config.lacuna_media * config.tamanho_grupo;
+
+        proximo_id_grupo += 1 + static_cast<long>(-media * std::log(1.0 - uniforme()));
+        restantes_no_grupo = config.tamanho_grupo;
+
+    }
+
+    if (proximo_id_grupo > INT32_MAX) {
+
+        throw std::runtime_error("[GeradorCSV] Os IDs passaram de INT32_MAX; reduza a lacuna ou o número de linhas.");
+
+    }
+
+    restantes_no_grupo--;
+
+    return proximo_id_grupo++;
+
+}
+
+double GeradorCSV::zipfH(double x) const {
+
+    return std::exp(-zipf_s * std::log(x));
+
+}
+
+double GeradorCSV::zipfHIntegral(double x) const {
+
+    double log_x = std::log(x);
+
+    return expm1SobreX((1.0 - zipf_s) * log_x) * log_x;
+
+}
+
+double GeradorCSV::zipfHIntegralInversa(double x) const {
+
+    double t = std::max(x * (1.0 - zipf_s), -1.0);
+
+    return std::exp(log1pSobreX(t) * x);
+
+}
+
+long GeradorCSV::sortearPostoTitulo() {
+
+    if (config.titulos_distintos == 0) {
+
+        return geradas + 1;
+
+    }
+
+    const long n = config.titulos_distintos;
+
+    // Rejeição-inversão (Hörmann e Derflinger) sobre os postos [1, n]
+    while (true) {
+
+        double u = zipf_h_integral_n + uniforme() * (zipf_h_integral_x1 - zipf_h_integral_n);
+        double x = zipfHIntegralInversa(u);
+        long k = std::min(std::max(static_cast<long>(x + 0.5), 1L), n);
+
+        if (k - x <= 2.0 - zipfHIntegralInversa(zipfHIntegral(2.5) - zipfH(2.0)) || u >= zipfHIntegral(k + 0.5) - zipfH(static_cast<double>(k))) {
+
+            return k;
+
+        }
+
+    }
+
+}
+
+void GeradorCSV::acrescentarPalavra(std::string& texto, std::mt19937_64& fonte) {
+
+    int silabas = 1 + static_cast<int>(fonte() % 3);
+
+    for (int i = 0; i < silabas; ++i) {
+
+        texto += SILABAS[fonte() % NUM_SILABAS];
+
+    }
+
+}
+
+std::string GeradorCSV::tituloDoPosto(long posto) {
+
+    // O texto depende só da semente e do posto: o mesmo posto gera o mesmo título
+    std::mt19937_64 fonte(misturar(config.semente ^ misturar(static_cast<uint64_t>(posto))));
+
+    // Número de palavras log-normal (mediana ~8, cauda passando de 300 caracteres)
+    double u1 = 1.0 - static_cast<double>(fonte() >> 11) * (1.0 / 9007199254740992.0);
+    double u2 = static_cast<double>(fonte() >> 11) * (1.0 / 9007199254740992.0);
+    double z = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    int palavras = std::min(std::max(static_cast<int>(std::exp(2.1 + 0.5 * z)), 2), 80);
+
+    std::string titulo;
+
+    for (int i = 0; i < palavras; ++i) {
+
+        if (i > 0) {
+
+            titulo += (i == palavras / 2 && palavras > 6) ? ": " : " ";
+
+        }
+
+        size_t inicio = titulo.size();
+        acrescentarPalavra(titulo, fonte);
+
+        if (i == 0) {
+
+            titulo[inicio] = static_cast<char>(titulo[inicio] - 'a' + 'A');
+
+        }
+
+    }
+
+    return titulo + ".";
+
+}
+
+std::string GeradorCSV::autores() {
+
+    // 1 + geométrica (média ~2,5 autores); listas longas passam dos 150 caracteres do campo
+    int quantidade = 1;
+
+    while (quantidade < 30 && uniforme() < 0.6) {
+
+        quantidade++;
+
+    }
+
+    std::string texto;
+
+    for (int i = 0; i < quantidade; ++i) {
+
+        if (i > 0) {
+
+            texto += "|";
+
+        }
+
+        texto += NOMES[aleatorio() % NUM_NOMES];
+        texto += " ";
+        texto += SOBRENOMES[aleatorio() % NUM_SOBRENOMES];
+
+    }
+
+    return texto;
+
+}
+
+std::string GeradorCSV::snippet(const std::string& titulo) {
+
+    // Comprimento log-normal (mediana ~365 caracteres), às vezes acima dos 1024 do campo
+    size_t alvo = static_cast<size_t>(std::min(std::max(std::exp(5.9 + 0.45 * normal()), 40.0), 1600.0));
+
+    std::string texto = titulo + " ";
+
+    while (texto.size() < alvo) {
+
+        acrescentarPalavra(texto, aleatorio);
+        texto += (uniforme() < 0.08) ? ". " : " ";
+
+    }
+
+    return texto + "..";
+
+}
+
+bool GeradorCSV::proximaLinha(std::string& linha) {
+
+    if (geradas >= config.linhas) {
+
+        return false;
+
+    }
+
+    const long id = proximoId();
+    const std::string titulo = tituloDoPosto(sortearPostoTitulo());
+    const long ano = inteiro(config.ano_minimo, config.ano_maximo);
+
+    // Citações com cauda de Pareto: a maioria perto de zero, poucas na casa dos milhares
+    const long citacoes = std::min(static_cast<long>(std::pow(1.0 - uniforme(), -1.0 / 1.2)) - 1, 100000L);
+
+    char atualizacao[32];
+    std::snprintf(atualizacao, sizeof(atualizacao), "%04ld-%02ld-%02ld %02ld:%02ld:%02ld",
+                  inteiro(2016, 2017), inteiro(1, 12), inteiro(1, 28), inteiro(0, 23), inteiro(0, 59), inteiro(0, 59));
+
+    const bool malformada = config.taxa_malformadas > 0.0 && uniforme() < config.taxa_malformadas;
+
+    std::string campo_id = std::to_string(id);
+
+    if (malformada && malformadas % 2 == 1) {
+
+        // ID não numérico: o parser o lê como zero e descarta a linha
+        campo_id = "x" + campo_id;
+
+    }
+
+    linha = "\"" + campo_id + "\";\"" + titulo + "\";\"" + std::to_string(ano) + "\"";
+
+    if (!(malformada && malformadas % 2 == 0)) {
+
+        // Sem estes campos a linha fica com menos de 7 e é descartada
+        linha += ";\"" + autores() + "\";\"" + std::to_string(citacoes) + "\";\"" + atualizacao + "\";\"" + snippet(titulo) + "\"";
+
+    }
+
+    if (malformada) {
+
+        malformadas++;
+
+    }
+
+    geradas++;
+
+    return true;
+
+}
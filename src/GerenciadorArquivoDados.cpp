@@ -9,8 +9,11 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <string>
+#include <algorithm>
 
 #include "GerenciadorArquivoDados.hpp"
+#include "Instrumentacao.hpp"
+#include "RastroBlocos.hpp"
 #include "Log.hpp"
 
 GerenciadorArquivoDados::GerenciadorArquivoDados(const std::string& caminho, size_t tamanho)
@@ -20,7 +23,8 @@ GerenciadorArquivoDados::GerenciadorArquivoDados(const std::string& caminho, siz
       mapa_memoria(nullptr),
       tamanho_total_arquivo(0),
       blocos_lidos(0),
-      blocos_escritos(0) {
+      blocos_escritos(0),
+      id_rastro(0) {
 
     if (tamanho_bloco == 0) {
     
@@ -96,6 +100,8 @@ GerenciadorArquivoDados::GerenciadorArquivoDados(const std::string& caminho, siz
     
     }
 
+    id_rastro = rastro_registrar_arquivo(caminho_arquivo, tamanho_bloco);
+
 }
 
 GerenciadorArquivoDados::~GerenciadorArquivoDados() {
@@ -126,14 +132,72 @@ void* GerenciadorArquivoDados::getPonteiroBloco(size_t id_bloco) {
     
     }
 
-    blocos_lidos++;
+    blocos_lidos.fetch_add(1, std::memory_order_relaxed);
+
+    if (rastro_ativo()) {
+
+        rastro_acesso(id_rastro, id_bloco, TipoAcessoBloco::LEITURA);
+
+    }
 
     return (void*)(static_cast<char*>(mapa_memoria) + offset);
 
 }
 
+void GerenciadorArquivoDados::aconselhar(size_t id_bloco, size_t num_blocos, int conselho) {
+
+    size_t offset = id_bloco * tamanho_bloco;
+
+    if (offset >= tamanho_total_arquivo || mapa_memoria == nullptr || num_blocos == 0) {
+
+        return;
+
+    }
+
+    size_t tamanho = std::min(num_blocos * tamanho_bloco, tamanho_total_arquivo - offset);
+
+    // madvise exige endereço alinhado à página
+    size_t pagina = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t inicio = (offset / pagina) * pagina;
+
+    madvise(static_cast<char*>(mapa_memoria) + inicio, tamanho + (offset - inicio), conselho);
+
+}
+
+void GerenciadorArquivoDados::sugerirLeitura(size_t id_bloco, size_t num_blocos) {
+
+    aconselhar(id_bloco, num_blocos, MADV_WILLNEED);
+
+}
+
+void GerenciadorArquivoDados::sugerirLeituraSequencial(size_t id_bloco, size_t num_blocos) {
+
+    aconselhar(id_bloco, num_blocos, MADV_SEQUENTIAL);
+    aconselhar(id_bloco, num_blocos, MADV_WILLNEED);
+
+}
+
+void GerenciadorArquivoDados::anteciparBloco(size_t id_bloco) {
+
+    size_t offset = id_bloco * tamanho_bloco;
+
+    if (offset >= tamanho_total_arquivo || mapa_memoria == nullptr) {
+
+        return;
+
+    }
+
+    sugerirLeitura(id_bloco, 1);
+
+    // Cabeçalho do bloco e começo do primeiro registro (onde fica o ID)
+    __builtin_prefetch(static_cast<char*>(mapa_memoria) + offset);
+
+}
+
 void GerenciadorArquivoDados::sincronizarBloco(size_t id_bloco) {
     
+    INSTR_TEMPORIZAR("dados.msync_bloco");
+
     size_t offset = id_bloco * tamanho_bloco;
 
     if (offset >= tamanho_total_arquivo || mapa_memoria == nullptr) {
@@ -160,6 +224,8 @@ void GerenciadorArquivoDados::sincronizarBloco(size_t id_bloco) {
 
 size_t GerenciadorArquivoDados::alocarNovoBloco() {
     
+    INSTR_TEMPORIZAR("dados.alocar_bloco");
+
     size_t novo_id = (tamanho_total_arquivo == 0) ? 0 : (tamanho_total_arquivo / tamanho_bloco);
     size_t novo_tamanho_total = (novo_id + 1) * tamanho_bloco;
 
@@ -225,7 +291,7 @@ void GerenciadorArquivoDados::alocarBlocosEmMassa(size_t num_blocos) {
 
     tamanho_total_arquivo = novo_tamanho_total;
 
-    log_debug(std::to_string(num_blocos) + " blocos alocados em massa (total: " + std::to_string(tamanho_total_arquivo) + " bytes).");
+    LOG_DEBUG(std::to_string(num_blocos) + " blocos alocados em massa (total: " + std::to_string(tamanho_total_arquivo) + " bytes).");
 
 }
 
@@ -254,6 +320,8 @@ void GerenciadorArquivoDados::sincronizarArquivoInteiro() {
 
 void GerenciadorArquivoDados::flushCheckpoint() {
 
+    INSTR_TEMPORIZAR("dados.msync_checkpoint");
+
     log_info("Sincronizando checkpoint..."); 
     
     if (mapa_memoria != nullptr && tamanho_total_arquivo > 0) {
@@ -282,4 +350,10 @@ void GerenciadorArquivoDados::notificarEscrita(size_t id_bloco) {
 
     blocos_escritos++;
 
+    if (rastro_ativo()) {
+
+        rastro_acesso(id_rastro, id_bloco, TipoAcessoBloco::ESCRITA);
+
+    }
+
 }
\ No newline at end of file
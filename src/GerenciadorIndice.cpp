@@ -1,115 +1,163 @@
 #include "GerenciadorIndice.hpp"
+#include "Instrumentacao.hpp"
+#include "RastroBlocos.hpp"
 #include <stdexcept>
-#include <fstream>
 #include <string>
+#include <cstring>
+#include <utility>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 
 //construtor
 GerenciadorIndice::GerenciadorIndice(const std::string& nomeArquivo, size_t tamanhoBloco)
-    : nomeArquivo(nomeArquivo), tamanhoBloco(tamanhoBloco), blocos_lidos(0), blocos_escritos(0) {
-    
-    this->fileStream.open(this->nomeArquivo, std::ios::in | std::ios::out | std::ios::binary);  //tenta abrir para leitura e escrita
-
-    if(!this->fileStream.is_open()){//verifica se conseguiu abrir o arquivo
-        this->fileStream.clear();//limpa as flags de erro
-
-        //ja que nao conseguiu abrir tenta escrever (forca a criacao)
-        if(!fileStream.is_open()){
-            this->fileStream.open(this->nomeArquivo, std::ios::out | std::ios::binary); 
-            if (!fileStream.is_open()) {
-            // Se AINDA não abriu, é porque não conseguiu criar.
-            // AGORA sim, você pode lançar o erro.
-            throw std::runtime_error("Erro: Nao foi possivel criar o arquivo: " + this->nomeArquivo);
-            }
-        }
-        this->fileStream.close();//fechamos o arquivo no modo somente para escrita
-
-        
-        //tenta abrir de novo para escrita e leitura
-        this->fileStream.open(this->nomeArquivo, std::ios::in | std::ios::out | std::ios::binary); 
-
-        if(!fileStream.is_open()){
-        this->fileStream.open(this->nomeArquivo, std::ios::out | std::ios::binary); 
-           if (!fileStream.is_open()) {
-            // Se AINDA não abriu, é porque não conseguiu criar.
-            // AGORA sim lançar o erro
-                throw std::runtime_error("Erro: Nao foi possivel criar o arquivo: " + this->nomeArquivo);
-            }
-        }
+    : nomeArquivo(nomeArquivo), fd(-1), tamanhoBloco(tamanhoBloco), blocos_lidos(0), blocos_escritos(0), acertos_cache(0), id_rastro(0) {
+
+    //tenta abrir para leitura e escrita, criando o arquivo se nao existir
+    this->fd = open(this->nomeArquivo.c_str(), O_RDWR | O_CREAT, (mode_t)0644);
+
+    if (this->fd == -1 && (errno == EACCES || errno == EROFS)) {
+        //sem permissao de escrita: banco somente leitura, as consultas continuam funcionando
+        this->fd = open(this->nomeArquivo.c_str(), O_RDONLY);
     }
+
+    if (this->fd == -1) {
+        throw std::runtime_error("Erro: Nao foi possivel criar o arquivo: " + this->nomeArquivo + " (" + std::strerror(errno) + ")");
+    }
+
+    this->id_rastro = rastro_registrar_arquivo(this->nomeArquivo, this->tamanhoBloco);
 }
 
 //destrutor
 GerenciadorIndice::~GerenciadorIndice() {
-    if (fileStream.is_open()) {//se esta aberto fecha o arquivo
-        fileStream.close();
+    if (fd != -1) {//se esta aberto fecha o arquivo
+        close(fd);
     }
 }
 
 // métodos para modificar e ler o arquivo
-    
+
 // Lê o conteúdo de um bloco específico do disco para um buffer.
-void GerenciadorIndice::lerBloco(long idBloco, char* buffer) {
-    // Calcula a posição exata do bloco no arquivo em bytes.
-    long posicao = idBloco * this->tamanhoBloco; //achar a posicao e achar a posicao do bloco
+// pread nao usa a posicao do arquivo, entao pode ser chamado por varias threads.
+void GerenciadorIndice::lerBloco(long idBloco, char* buffer) const {
+    if (rastro_ativo()) rastro_acesso(id_rastro, static_cast<size_t>(idBloco), TipoAcessoBloco::LEITURA);
+
+    //blocos fixados em memoria: o mapa so muda antes das leituras concorrentes
+    if (!blocos_fixados.empty()) {
+        auto it = blocos_fixados.find(idBloco);
+        if (it != blocos_fixados.end()) {
+            memcpy(buffer, it->second.data(), this->tamanhoBloco);
+            blocos_lidos.fetch_add(1, std::memory_order_relaxed);
+            acertos_cache.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
 
-    fileStream.clear(); // limpa flags antigas antes de mover ponteiro
-    fileStream.seekg(posicao, std::ios::beg);// O ponteiro de leitura é movido para o início do bloco desejado.
-    fileStream.read(buffer, this->tamanhoBloco);//finalmente le o bloco
+    INSTR_TEMPORIZAR("indice.pread");
 
-    if (fileStream.fail() && !fileStream.eof()) {//se falhou mas nao e final de arquivo(falhar real)
-        throw std::runtime_error("Erro ao ler o bloco " + std::to_string(tamanhoBloco) + " do arquivo.");
+    // Calcula a posição exata do bloco no arquivo em bytes.
+    off_t posicao = static_cast<off_t>(idBloco) * this->tamanhoBloco; //achar a posicao e achar a posicao do bloco
+
+    size_t lidos = 0;
+    while (lidos < this->tamanhoBloco) {
+        ssize_t r = pread(fd, buffer + lidos, this->tamanhoBloco - lidos, posicao + lidos);
+        if (r < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Erro ao ler o bloco " + std::to_string(idBloco) + " do arquivo.");
+        }
+        if (r == 0) {
+            //final de arquivo: completa o bloco com zeros (mesmo comportamento de um bloco nunca escrito)
+            memset(buffer + lidos, 0, this->tamanhoBloco - lidos);
+            break;
+        }
+        lidos += static_cast<size_t>(r);
     }
 
-    blocos_lidos++;
+    blocos_lidos.fetch_add(1, std::memory_order_relaxed);
 
 }
 
 // Escreve o conteúdo de um buffer em um bloco específico no disco.
 void GerenciadorIndice::escreveBloco(long idBloco, const char* buffer) {
-    // Calcula a posição exata para a escrita.
-    long position = idBloco * this->tamanhoBloco;
+    INSTR_TEMPORIZAR("indice.pwrite");
+    if (rastro_ativo()) rastro_acesso(id_rastro, static_cast<size_t>(idBloco), TipoAcessoBloco::ESCRITA);
 
-    fileStream.clear(); // limpa flags antigas antes de mover o ponteiro
-    fileStream.seekp(position, std::ios::beg);// O ponteiro de escrita é movido para o início do bloco desejado.
-    fileStream.write(buffer, this->tamanhoBloco);
+    // Calcula a posição exata para a escrita.
+    off_t position = static_cast<off_t>(idBloco) * this->tamanhoBloco;
+
+    size_t escritos = 0;
+    while (escritos < this->tamanhoBloco) {
+        ssize_t w = pwrite(fd, buffer + escritos, this->tamanhoBloco - escritos, position + escritos);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error("Erro ao escrever no bloco " + std::to_string(idBloco) + " do arquivo.");
+        }
+        escritos += static_cast<size_t>(w);
+    }
 
-    if (fileStream.fail()) {
-        throw std::runtime_error("Erro ao escrever no bloco " + std::to_string(idBloco) + " do arquivo.");
+    //mantem a copia fixada igual ao disco
+    auto it = blocos_fixados.find(idBloco);
+    if (it != blocos_fixados.end()) {
+        memcpy(it->second.data(), buffer, this->tamanhoBloco);
     }
 
-    blocos_escritos++;
+    blocos_escritos.fetch_add(1, std::memory_order_relaxed);
+
+}
+
+// Copia o bloco para a memoria; as proximas leituras dele sao atendidas pela copia.
+void GerenciadorIndice::fixarBloco(long idBloco) {
+    if (blocos_fixados.count(idBloco)) {
+        return;
+    }
 
+    std::vector<char> copia(this->tamanhoBloco);
+    lerBloco(idBloco, copia.data());
+    blocos_fixados.emplace(idBloco, std::move(copia));
 }
 
+// Dica de leitura antecipada para o S.O.
+void GerenciadorIndice::sugerirLeitura(long idBloco, long numBlocos) const {
+    if (idBloco < 0 || numBlocos <= 0) {
+        return;
+    }
 
-long GerenciadorIndice::getTamanhoArquivo() {
-    //stream temporario para checar o tamanho do arquivo
-    std::ifstream file(this->nomeArquivo, std::ios::binary | std::ios::ate);
+    //um bloco fixado ja esta em memoria
+    if (numBlocos == 1 && !blocos_fixados.empty() && blocos_fixados.count(idBloco)) {
+        return;
+    }
 
-    if (!file.is_open()) {
-        // Se não conseguiu abrir (provavelmente não existe), o tamanho é 0.
+    posix_fadvise(fd, static_cast<off_t>(idBloco) * this->tamanhoBloco, static_cast<off_t>(numBlocos) * this->tamanhoBloco, POSIX_FADV_WILLNEED);
+}
+
+long GerenciadorIndice::getTamanhoArquivo() const {
+    struct stat info;
+
+    if (fstat(fd, &info) == -1) {
+        // Se não conseguiu consultar, o tamanho é 0.
         return 0;
     }
-    //posicao final do arquivo
-    long size = file.tellg();
-    file.close();
-    return size;
+    //tamanho atual do arquivo
+    return static_cast<long>(info.st_size);
 }
 
 long GerenciadorIndice::getBlocosLidos() const {
-    return blocos_lidos;
+    return blocos_lidos.load(std::memory_order_relaxed);
 }
 
 long GerenciadorIndice::getBlocosEscritos() const {
-    return blocos_escritos;
+    return blocos_escritos.load(std::memory_order_relaxed);
 }
 
 void GerenciadorIndice::flush() {
 
-    if (fileStream.is_open()) {
-    
-        fileStream.flush();
-    
+    if (fd != -1) {
+
+        INSTR_TEMPORIZAR("indice.fdatasync");
+
+        fdatasync(fd);
+
     }
 
-}
\ No newline at end of file
+}
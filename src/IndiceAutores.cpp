@@ -0,0 +1,511 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "IndiceAutores.hpp"
+
+static const char ASSINATURA_INDICE_AUTORES[8] = {'A', 'U', 'T', 'O', 'R', 'E', 'S', '1'};
+static const uint32_t VERSAO_INDICE_AUTORES = 1;
+
+std::string_view normalizarNomeAutor(std::string_view nome) {
+
+    size_t inicio = nome.find_first_not_of(" \t");
+
+    if (inicio == std::string_view::npos) {
+
+        return std::string_view();
+
+    }
+
+    size_t fim = nome.find_last_not_of(" \t");
+
+    return nome.substr(inicio, fim - inicio + 1);
+
+}
+
+//#################################################################
+// Varint (7 bits por byte, o bit alto indica que há mais bytes)
+//#################################################################
+
+static void escreverVarint(std::string& destino, uint64_t valor) {
+
+    while (valor >= 0x80) {
+
+        destino.push_back(static_cast<char>((valor & 0x7f) | 0x80));
+        valor >>= 7;
+
+    }
+
+    destino.push_back(static_cast<char>(valor));
+
+}
+
+static uint64_t lerVarint(const uint8_t*& p, const uint8_t* fim) {
+
+    uint64_t valor = 0;
+
+    for (int deslocamento = 0; p < fim && deslocamento < 64; deslocamento += 7) {
+
+        uint8_t byte = *p++;
+        valor |= static_cast<uint64_t>(byte & 0x7f) << deslocamento;
+
+        if ((byte & 0x80) == 0) {
+
+            return valor;
+
+        }
+
+    }
+
+    throw std::runtime_error("[IndiceAutores] Lista de postagens corrompida.");
+
+}
+
+//#################################################################
+// Construção (upload)
+//#################################################################
+
+ConstrutorIndiceAutores::ConstrutorIndiceAutores() : num_locais(0) {}
+
+void ConstrutorIndiceAutores::acrescentar(std::string_view autores, uint64_t local) {
+
+    while (!autores.empty()) {
+
+        size_t separador = autores.find('|');
+        std::string_view nome = normalizarNomeAutor(autores.substr(0, separador));
+
+        autores = (separador == std::string_view::npos) ? std::string_view() : autores.substr(separador + 1);
+
+        if (nome.empty()) {
+
+            continue;
+
+        }
+
+        auto it = ids.find(nome);
+        uint32_t id_autor;
+
+        if (it == ids.end()) {
+
+            id_autor = static_cast<uint32_t>(nomes.size());
+            ids.emplace(std::string(nome), id_autor);
+            nomes.emplace_back(nome);
+            locais.emplace_back();
+
+        }
+
+        else {
+
+            id_autor = it->second;
+
+        }
+
+        // Autor repetido no mesmo registro entra uma vez só
+        std::vector<uint64_t>& lista = locais[id_autor];
+
+        if (lista.empty() || lista.back() != local) {
+
+            lista.push_back(local);
+            num_locais++;
+
+        }
+
+    }
+
+}
+
+void ConstrutorIndiceAutores::gravar(const std::string& caminho) {
+
+    const uint32_t num_autores = static_cast<uint32_t>(nomes.size());
+
+    // 1. Listas: tabela de saltos + varints de cada autor, alinhadas a 8 bytes
+    std::vector<DescritorListaAutor> descritores(num_autores);
+    std::string dados;
+    std::string varints;
+    std::vector<SaltoListaAutor> saltos;
+
+    for (uint32_t a = 0; a < num_autores; ++a) {
+
+        std::vector<uint64_t>& lista = locais[a];
+
+        std::sort(lista.begin(), lista.end());
+
+        varints.clear();
+        saltos.clear();
+
+        for (size_t i = 0; i < lista.size(); ++i) {
+
+            if (i % POSTAGENS_POR_SALTO == 0) {
+
+                // O primeiro local do bloco fica só no salto
+                saltos.push_back({lista[i], static_cast<uint64_t>(varints.size())});
+
+            }
+
+            else {
+
+                escreverVarint(varints, lista[i] - lista[i - 1]);
+
+            }
+
+        }
+
+        dados.resize((dados.size() + 7) & ~static_cast<size_t>(7), '\0');
+
+        descritores[a].offset = dados.size();
+        descritores[a].registros = static_cast<uint32_t>(lista.size());
+        descritores[a].num_saltos = static_cast<uint32_t>(saltos.size());
+        descritores[a].bytes = varints.size();
+
+        dados.append(reinterpret_cast<const char*>(saltos.data()), saltos.size() * sizeof(SaltoListaAutor));
+        dados.append(varints);
+
+    }
+
+    // 2. Dicionário em ordem de nome, para a busca binária
+    std::vector<uint32_t> ordem(num_autores);
+
+    for (uint32_t a = 0; a < num_autores; ++a) {
+
+        ordem[a] = a;
+
+    }
+
+    std::sort(ordem.begin(), ordem.end(), [&](uint32_t x, uint32_t y) { return nomes[x] < nomes[y]; });
+
+    std::vector<EntradaAutor> entradas(num_autores);
+    std::string texto_nomes;
+
+    for (uint32_t i = 0; i < num_autores; ++i) {
+
+        const std::string& nome = nomes[ordem[i]];
+
+        entradas[i].offset_nome = texto_nomes.size();
+        entradas[i].tamanho_nome = static_cast<uint32_t>(nome.size());
+        entradas[i].id_autor = ordem[i];
+        texto_nomes += nome;
+
+    }
+
+    // 3. Cabeçalho e seções
+    CabecalhoIndiceAutores cabecalho;
+    std::memset(&cabecalho, 0, sizeof(cabecalho));
+    std::memcpy(cabecalho.assinatura, ASSINATURA_INDICE_AUTORES, sizeof(cabecalho.assinatura));
+    cabecalho.versao = VERSAO_INDICE_AUTORES;
+    cabecalho.num_autores = num_autores;
+    cabecalho.num_locais = num_locais;
+    cabecalho.offset_entradas = sizeof(CabecalhoIndiceAutores);
+    cabecalho.offset_listas = cabecalho.offset_entradas + entradas.size() * sizeof(EntradaAutor);
+    cabecalho.offset_nomes = cabecalho.offset_listas + descritores.size() * sizeof(DescritorListaAutor);
+    cabecalho.offset_dados = (cabecalho.offset_nomes + texto_nomes.size() + 7) & ~static_cast<uint64_t>(7);
+
+    std::ofstream arquivo(caminho, std::ios::binary | std::ios::trunc);
+
+    if (!arquivo.is_open()) {
+
+        throw std::runtime_error("[IndiceAutores] Nao foi possivel criar " + caminho);
+
+    }
+
+    const char preenchimento[8] = {0};
+
+    arquivo.write(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+    arquivo.write(reinterpret_cast<const char*>(entradas.data()), entradas.size() * sizeof(EntradaAutor));
+    arquivo.write(reinterpret_cast<const char*>(descritores.data()), descritores.size() * sizeof(DescritorListaAutor));
+    arquivo.write(texto_nomes.data(), texto_nomes.size());
+    arquivo.write(preenchimento, cabecalho.offset_dados - (cabecalho.offset_nomes + texto_nomes.size()));
+    arquivo.write(dados.data(), dados.size());
+    arquivo.flush();
+
+    if (!arquivo) {
+
+        throw std::runtime_error("[IndiceAutores] Falha ao gravar " + caminho);
+
+    }
+
+}
+
+//#################################################################
+// Leitura
+//#################################################################
+
+IndiceAutores::IndiceAutores(const std::string& caminho) : mapa(nullptr), tamanho(0), cabecalho(nullptr) {
+
+    int fd = open(caminho.c_str(), O_RDONLY);
+
+    if (fd == -1) {
+
+        throw std::runtime_error("[IndiceAutores] Nao foi possivel abrir " + caminho + ": " + std::strerror(errno) + ". Refaca o upload com --indice-autores.");
+
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) == -1 || static_cast<size_t>(info.st_size) < sizeof(CabecalhoIndiceAutores)) {
+
+        close(fd);
+
+        throw std::runtime_error("[IndiceAutores] Indice truncado: " + caminho);
+
+    }
+
+    void* mapeado = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (mapeado == MAP_FAILED) {
+
+        throw std::runtime_error("[IndiceAutores] Falha no mmap de " + caminho + ": " + std::strerror(errno));
+
+    }
+
+    mapa = static_cast<const char*>(mapeado);
+    tamanho = static_cast<size_t>(info.st_size);
+    cabecalho = reinterpret_cast<const CabecalhoIndiceAutores*>(mapa);
+
+    // Confere as seções e cada lista uma vez, para as consultas não precisarem conferir
+    bool valido = std::memcmp(cabecalho->assinatura, ASSINATURA_INDICE_AUTORES, sizeof(cabecalho->assinatura)) == 0 &&
+                  cabecalho->versao == VERSAO_INDICE_AUTORES &&
+                  cabecalho->offset_listas == cabecalho->offset_entradas + uint64_t(cabecalho->num_autores) * sizeof(EntradaAutor) &&
+                  cabecalho->offset_nomes == cabecalho->offset_listas + uint64_t(cabecalho->num_autores) * sizeof(DescritorListaAutor) &&
+                  cabecalho->offset_nomes <= cabecalho->offset_dados && cabecalho->offset_dados <= tamanho;
+
+    for (uint32_t i = 0; valido && i < cabecalho->num_autores; ++i) {
+
+        const EntradaAutor& entrada = entradas()[i];
+        const DescritorListaAutor& lista = descritor(i);
+
+        valido = entrada.id_autor < cabecalho->num_autores &&
+                 cabecalho->offset_nomes + entrada.offset_nome + entrada.tamanho_nome <= cabecalho->offset_dados &&
+                 lista.num_saltos == (lista.registros + POSTAGENS_POR_SALTO - 1) / POSTAGENS_POR_SALTO &&
+                 cabecalho->offset_dados + lista.offset + uint64_t(lista.num_saltos) * sizeof(SaltoListaAutor) + lista.bytes <= tamanho;
+
+    }
+
+    if (!valido) {
+
+        munmap(const_cast<char*>(mapa), tamanho);
+
+        throw std::runtime_error("[IndiceAutores] " + caminho + " nao e um indice de autores valido.");
+
+    }
+
+}
+
+IndiceAutores::~IndiceAutores() {
+
+    munmap(const_cast<char*>(mapa), tamanho);
+
+}
+
+const EntradaAutor* IndiceAutores::entradas() const {
+
+    return reinterpret_cast<const EntradaAutor*>(mapa + cabecalho->offset_entradas);
+
+}
+
+const DescritorListaAutor& IndiceAutores::descritor(uint32_t id_autor) const {
+
+    return reinterpret_cast<const DescritorListaAutor*>(mapa + cabecalho->offset_listas)[id_autor];
+
+}
+
+bool IndiceAutores::buscar(std::string_view nome, uint32_t& id_autor) const {
+
+    nome = normalizarNomeAutor(nome);
+
+    const char* nomes = mapa + cabecalho->offset_nomes;
+    const EntradaAutor* inicio = entradas();
+    const EntradaAutor* fim = inicio + cabecalho->num_autores;
+
+    auto nomeDe = [&](const EntradaAutor& entrada) { return std::string_view(nomes + entrada.offset_nome, entrada.tamanho_nome); };
+
+    const EntradaAutor* it = std::lower_bound(inicio, fim, nome, [&](const EntradaAutor& entrada, std::string_view alvo) { return nomeDe(entrada) < alvo; });
+
+    if (it == fim || nomeDe(*it) != nome) {
+
+        return false;
+
+    }
+
+    id_autor = it->id_autor;
+
+    return true;
+
+}
+
+uint64_t IndiceAutores::bytesLista(uint32_t id_autor) const {
+
+    const DescritorListaAutor& lista = descritor(id_autor);
+
+    return uint64_t(lista.num_saltos) * sizeof(SaltoListaAutor) + lista.bytes;
+
+}
+
+/**
+ * @class CursorLista
+ * @brief Percorre uma lista em blocos de POSTAGENS_POR_SALTO, decodificando só os blocos visitados.
+ */
+class CursorLista {
+
+    private:
+        const SaltoListaAutor* saltos;
+        const uint8_t* varints;
+        const uint8_t* fim_varints;
+        uint32_t registros;
+        uint32_t num_saltos;
+
+        uint32_t bloco;              // bloco em 'valores' (num_saltos se nenhum)
+        std::vector<uint64_t> valores;
+        size_t posicao;
+        long blocos_decodificados;
+
+    public:
+        CursorLista(const char* inicio, const DescritorListaAutor& lista)
+            : saltos(reinterpret_cast<const SaltoListaAutor*>(inicio)),
+              varints(reinterpret_cast<const uint8_t*>(inicio) + uint64_t(lista.num_saltos) * sizeof(SaltoListaAutor)),
+              fim_varints(varints + lista.bytes),
+              registros(lista.registros),
+              num_saltos(lista.num_saltos),
+              bloco(lista.num_saltos),
+              posicao(0),
+              blocos_decodificados(0) {
+
+            valores.reserve(POSTAGENS_POR_SALTO);
+
+        }
+
+        uint32_t getNumSaltos() const { return num_saltos; }
+        long getBlocosDecodificados() const { return blocos_decodificados; }
+        const std::vector<uint64_t>& getValores() const { return valores; }
+
+        void carregar(uint32_t b) {
+
+            size_t n = std::min<size_t>(POSTAGENS_POR_SALTO, registros - size_t(b) * POSTAGENS_POR_SALTO);
+            const uint8_t* p = varints + saltos[b].offset;
+            uint64_t valor = saltos[b].primeiro_local;
+
+            valores.clear();
+            valores.push_back(valor);
+
+            for (size_t i = 1; i < n; ++i) {
+
+                valor += lerVarint(p, fim_varints);
+                valores.push_back(valor);
+
+            }
+
+            bloco = b;
+            posicao = 0;
+            blocos_decodificados++;
+
+        }
+
+        /**
+         * @brief Indica se 'alvo' está na lista. Os alvos devem vir em ordem crescente.
+         */
+        bool contem(uint64_t alvo) {
+
+            if (num_saltos == 0 || alvo < saltos[0].primeiro_local) {
+
+                return false;
+
+            }
+
+            // Último bloco que começa em alvo ou antes, a partir do bloco atual
+            uint32_t desde = (bloco == num_saltos) ? 0 : bloco;
+            const SaltoListaAutor* it = std::upper_bound(saltos + desde, saltos + num_saltos, alvo,
+                                                         [](uint64_t valor, const SaltoListaAutor& salto) { return valor < salto.primeiro_local; });
+            uint32_t b = static_cast<uint32_t>(it - saltos) - 1;
+
+            if (b != bloco) {
+
+                carregar(b);
+
+            }
+
+            while (posicao < valores.size() && valores[posicao] < alvo) {
+
+                posicao++;
+
+            }
+
+            return posicao < valores.size() && valores[posicao] == alvo;
+
+        }
+
+};
+
+void IndiceAutores::decodificar(uint32_t id_autor, std::vector<uint64_t>& locais) const {
+
+    const DescritorListaAutor& lista = descritor(id_autor);
+    CursorLista cursor(mapa + cabecalho->offset_dados + lista.offset, lista);
+
+    locais.clear();
+    locais.reserve(lista.registros);
+
+    for (uint32_t b = 0; b < cursor.getNumSaltos(); ++b) {
+
+        cursor.carregar(b);
+        locais.insert(locais.end(), cursor.getValores().begin(), cursor.getValores().end());
+
+    }
+
+}
+
+std::vector<uint64_t> IndiceAutores::intersectar(const std::vector<uint32_t>& ids_autores, long* blocos_decodificados) const {
+
+    std::vector<uint64_t> candidatos;
+
+    if (ids_autores.empty()) {
+
+        return candidatos;
+
+    }
+
+    // Da lista menor para a maior: os candidatos só diminuem
+    std::vector<uint32_t> ordem(ids_autores);
+    std::sort(ordem.begin(), ordem.end(), [&](uint32_t x, uint32_t y) { return numeroRegistros(x) < numeroRegistros(y); });
+
+    decodificar(ordem[0], candidatos);
+
+    long blocos = descritor(ordem[0]).num_saltos;
+
+    for (size_t i = 1; i < ordem.size() && !candidatos.empty(); ++i) {
+
+        const DescritorListaAutor& lista = descritor(ordem[i]);
+        CursorLista cursor(mapa + cabecalho->offset_dados + lista.offset, lista);
+        size_t mantidos = 0;
+
+        for (uint64_t local : candidatos) {
+
+            if (cursor.contem(local)) {
+
+                candidatos[mantidos++] = local;
+
+            }
+
+        }
+
+        candidatos.resize(mantidos);
+        blocos += cursor.getBlocosDecodificados();
+
+    }
+
+    if (blocos_decodificados != nullptr) {
+
+        *blocos_decodificados = blocos;
+
+    }
+
+    return candidatos;
+
+}
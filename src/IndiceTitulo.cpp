@@ -0,0 +1,119 @@
+#include <string>
+#include <vector>
+#include <stdexcept>
+
+#include "IndiceTitulo.hpp"
+
+IndiceTitulo::IndiceTitulo(const std::string& nomeArquivo, size_t tamanhoBloco, ModoIndiceTitulo modo, bool incluirCampos) : modo(modo) {
+
+    if (modo == ModoIndiceTitulo::HASH) {
+
+        if (incluirCampos) {
+
+            throw std::runtime_error("Erro: Campos incluidos exigem o indice de titulos no modo compacto.");
+
+        }
+
+        arvoreHash.reset(new BPlusTree<ChaveTituloNormalizada>(nomeArquivo, tamanhoBloco));
+
+    }
+
+    else {
+
+        arvoreCompacta.reset(new BPlusTreeTitulo(nomeArquivo, tamanhoBloco, incluirCampos));
+
+    }
+
+}
+
+void IndiceTitulo::insert(const std::string& titulo, long dataPointer, const CamposIncluidos* campos) {
+
+    if (arvoreHash) {
+
+        arvoreHash->insert(ChaveTituloNormalizada(titulo), dataPointer);
+
+    }
+
+    else {
+
+        arvoreCompacta->insert(titulo, dataPointer, campos);
+
+    }
+
+}
+
+std::vector<long> IndiceTitulo::search(const std::string& titulo, long* blocosLidos) {
+
+    if (arvoreHash) {
+
+        return arvoreHash->search(ChaveTituloNormalizada(titulo), blocosLidos);
+
+    }
+
+    return arvoreCompacta->search(titulo, blocosLidos);
+
+}
+
+std::vector<CamposIncluidos> IndiceTitulo::searchIncluidos(const std::string& titulo, long* blocosLidos) {
+
+    if (!temCamposIncluidos()) {
+
+        throw std::runtime_error("Erro: O indice de titulos nao tem campos incluidos. Refaca o upload com --indice-titulo-cobertura.");
+
+    }
+
+    return arvoreCompacta->searchIncluidos(titulo, blocosLidos);
+
+}
+
+BPlusTreeTitulo::Cursor IndiceTitulo::lowerBound(const std::string& chave, int leituraAntecipada) {
+
+    if (!arvoreCompacta) {
+
+        throw std::runtime_error("Erro: O indice de titulos no modo hash nao suporta varredura por prefixo. Refaca o upload com --indice-titulo compacto.");
+
+    }
+
+    return arvoreCompacta->lowerBound(chave, leituraAntecipada);
+
+}
+
+long IndiceTitulo::fixarNiveisSuperiores(int niveis) {
+
+    return arvoreHash ? arvoreHash->fixarNiveisSuperiores(niveis) : arvoreCompacta->fixarNiveisSuperiores(niveis);
+
+}
+
+long IndiceTitulo::getIndexBlocosLidos() const {
+
+    return arvoreHash ? arvoreHash->getIndexBlocosLidos() : arvoreCompacta->getIndexBlocosLidos();
+
+}
+
+long IndiceTitulo::getIndexBlocosEscritos() const {
+
+    return arvoreHash ? arvoreHash->getIndexBlocosEscritos() : arvoreCompacta->getIndexBlocosEscritos();
+
+}
+
+long IndiceTitulo::getIndexTotalBlocos() const {
+
+    return arvoreHash ? arvoreHash->getIndexTotalBlocos() : arvoreCompacta->getIndexTotalBlocos();
+
+}
+
+void IndiceTitulo::flush() {
+
+    if (arvoreHash) {
+
+        arvoreHash->flush();
+
+    }
+
+    else {
+
+        arvoreCompacta->flush();
+
+    }
+
+}
@@ -0,0 +1,271 @@
+#include <atomic>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <cstdlib>
+#include <cerrno>
+#include <csignal>
+#include <unistd.h>
+
+#include "Instrumentacao.hpp"
+#include "Log.hpp"
+
+// Métricas registradas (listas encadeadas; só crescem, como os avisos do Log)
+static std::atomic<HistogramaInstr*> g_histogramas{nullptr};
+static std::atomic<ContadorInstr*> g_contadores{nullptr};
+
+static std::once_flag g_iniciarRelatorios;
+static int g_pipeSinal[2] = {-1, -1};
+
+static void relatarEmStderr() {
+
+    // Mensagens do log pendentes saem antes do relatório
+    log_flush();
+    relatarInstrumentacao(std::cerr);
+
+}
+
+// Só escreve no pipe: a thread de relatório faz o resto fora do tratador de sinal
+static void tratarSIGUSR1(int) {
+
+    int erro_salvo = errno;
+    char byte = 1;
+    ssize_t escrito = write(g_pipeSinal[1], &byte, 1);
+    (void) escrito;
+    errno = erro_salvo;
+
+}
+
+static void threadRelatorio() {
+
+    char byte;
+
+    while (true) {
+
+        ssize_t lido = read(g_pipeSinal[0], &byte, 1);
+
+        if (lido == 1) {
+
+            relatarEmStderr();
+
+        }
+
+        else if (lido < 0 && errno == EINTR) {
+
+            continue;
+
+        }
+
+        else {
+
+            return;
+
+        }
+
+    }
+
+}
+
+// Chamada na primeira métrica: relatório no fim do programa e a cada SIGUSR1.
+// Sem instrumentação nenhuma métrica existe, e nada disso é instalado.
+static void iniciarRelatorios() {
+
+    std::call_once(g_iniciarRelatorios, []() {
+
+        std::atexit(relatarEmStderr);
+
+        if (pipe(g_pipeSinal) != 0) {
+
+            log_warn("[Instrumentacao] pipe() falhou; relatório por SIGUSR1 desativado.");
+
+            return;
+
+        }
+
+        std::thread(threadRelatorio).detach();
+
+        struct sigaction acao = {};
+        acao.sa_handler = tratarSIGUSR1;
+        sigemptyset(&acao.sa_mask);
+        acao.sa_flags = SA_RESTART; // não interrompe accept()/read() do programa
+        sigaction(SIGUSR1, &acao, nullptr);
+
+    });
+
+}
+
+HistogramaInstr::HistogramaInstr(const char* nome, const char* unidade)
+    : nome(nome), unidade(unidade), soma(0), maximo(0), contexto_maximo(-1), proximo(g_histogramas.load()) {
+
+    for (size_t f = 0; f < NUM_FAIXAS; ++f) {
+
+        faixas[f].store(0, std::memory_order_relaxed);
+
+    }
+
+    while (!g_histogramas.compare_exchange_weak(proximo, this)) {}
+
+    iniciarRelatorios();
+
+}
+
+uint64_t HistogramaInstr::limiteSuperior(size_t faixa) {
+
+    if (faixa < SUBFAIXAS) return faixa;
+
+    int expoente = static_cast<int>(faixa / SUBFAIXAS) + 2;
+    uint64_t inferior = static_cast<uint64_t>(SUBFAIXAS + faixa % SUBFAIXAS) << (expoente - 3);
+
+    return inferior + (uint64_t(1) << (expoente - 3)) - 1;
+
+}
+
+ContadorInstr::ContadorInstr(const char* nome) : nome(nome), valor(0), proximo(g_contadores.load()) {
+
+    while (!g_contadores.compare_exchange_weak(proximo, this)) {}
+
+    iniciarRelatorios();
+
+}
+
+// Soma dos histogramas com o mesmo nome (uma instância por ponto de chamada/instanciação)
+struct HistogramaAgregado {
+
+    std::string unidade;
+    std::vector<uint64_t> faixas = std::vector<uint64_t>(HistogramaInstr::NUM_FAIXAS, 0);
+    uint64_t contagem = 0;
+    uint64_t soma = 0;
+    uint64_t maximo = 0;
+    long contexto_maximo = -1;
+
+    uint64_t percentil(double fracao) const {
+
+        uint64_t alvo = static_cast<uint64_t>(fracao * contagem);
+        uint64_t acumulado = 0;
+
+        if (alvo == 0) alvo = 1;
+
+        for (size_t f = 0; f < faixas.size(); ++f) {
+
+            acumulado += faixas[f];
+
+            if (acumulado >= alvo) {
+
+                return std::min(HistogramaInstr::limiteSuperior(f), maximo);
+
+            }
+
+        }
+
+        return maximo;
+
+    }
+
+    // Eventos em faixas inteiramente acima do limite
+    uint64_t acimaDe(uint64_t limite) const {
+
+        uint64_t total = 0;
+
+        for (size_t f = 0; f < faixas.size(); ++f) {
+
+            if (f > 0 && HistogramaInstr::limiteSuperior(f - 1) >= limite) {
+
+                total += faixas[f];
+
+            }
+
+        }
+
+        return total;
+
+    }
+
+};
+
+void relatarInstrumentacao(std::ostream& saida) {
+
+    std::map<std::string, HistogramaAgregado> histogramas;
+    std::map<std::string, uint64_t> contadores;
+
+    for (const HistogramaInstr* h = g_histogramas.load(); h != nullptr; h = h->getProximo()) {
+
+        HistogramaAgregado& agregado = histogramas[h->getNome()];
+        agregado.unidade = h->getUnidade();
+
+        for (size_t f = 0; f < HistogramaInstr::NUM_FAIXAS; ++f) {
+
+            uint64_t n = h->getFaixa(f);
+            agregado.faixas[f] += n;
+            agregado.contagem += n;
+
+        }
+
+        agregado.soma += h->getSoma();
+
+        if (h->getMaximo() > agregado.maximo) {
+
+            agregado.maximo = h->getMaximo();
+            agregado.contexto_maximo = h->getContextoMaximo();
+
+        }
+
+    }
+
+    for (const ContadorInstr* c = g_contadores.load(); c != nullptr; c = c->getProximo()) {
+
+        contadores[c->getNome()] += c->getValor();
+
+    }
+
+    if (histogramas.empty() && contadores.empty()) {
+
+        return;
+
+    }
+
+    std::ostringstream texto;
+
+    texto << "\n=== Instrumentação (pid " << getpid() << ") ===\n";
+    texto << std::left << std::setw(28) << "metrica" << std::right << std::setw(7) << "unid" << std::setw(12) << "contagem"
+          << std::setw(12) << "media" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+          << std::setw(10) << "p99.9" << std::setw(12) << "max" << std::setw(12) << "ctx_max" << std::setw(9) << ">1ms" << "\n";
+
+    for (const auto& [nome, h] : histogramas) {
+
+        if (h.contagem == 0) {
+
+            continue;
+
+        }
+
+        texto << std::left << std::setw(28) << nome << std::right << std::setw(7) << h.unidade << std::setw(12) << h.contagem
+              << std::setw(12) << std::fixed << std::setprecision(1) << static_cast<double>(h.soma) / h.contagem
+              << std::setw(10) << h.percentil(0.50) << std::setw(10) << h.percentil(0.90) << std::setw(10) << h.percentil(0.99)
+              << std::setw(10) << h.percentil(0.999) << std::setw(12) << h.maximo << std::setw(12);
+
+        if (h.contexto_maximo >= 0) texto << h.contexto_maximo;
+        else texto << "-";
+
+        texto << std::setw(9);
+
+        if (h.unidade == "ns") texto << h.acimaDe(1000000);
+        else texto << "-";
+
+        texto << "\n";
+
+    }
+
+    for (const auto& [nome, valor] : contadores) {
+
+        texto << std::left << std::setw(28) << nome << std::right << std::setw(7) << "total" << std::setw(12) << valor << "\n";
+
+    }
+
+    saida << texto.str() << std::flush;
+
+}
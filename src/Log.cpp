@@ -2,26 +2,316 @@
 #include <iostream>
 #include <string>
 #include <cstdlib>
+#include <cstring>
+#include <cstdint>
 #include <algorithm>
 #include <cctype>
+#include <atomic>
+#include <thread>
+#include <mutex>
 
-static LogLevel g_currentLevel = LogLevel::INFO;
+LogLevel g_currentLevel = LogLevel::INFO;
+static std::ostream* g_saidaInfo = &std::cout;
+
+//#################################################################
+// Anel de mensagens (fila limitada MPMC de Vyukov, usada com um consumidor)
+//#################################################################
+
+static const size_t CAPACIDADE_ANEL = 1024;      // potência de 2
+static const size_t TAMANHO_TEXTO_ENTRADA = 240; // mensagens maiores são escritas na hora
+
+struct EntradaLog {
+
+    // == posição + 1: preenchida e pronta para a escritora; == posição: livre para o produtor
+    std::atomic<size_t> sequencia;
+    LogLevel nivel;
+    std::ostream* saida;
+    uint16_t tamanho;
+    char texto[TAMANHO_TEXTO_ENTRADA];
+
+};
+
+static EntradaLog g_anel[CAPACIDADE_ANEL];
+
+static std::atomic<size_t> g_posicaoEscrita{0};   // próxima posição a reservar (produtores)
+static std::atomic<size_t> g_posicaoImpressa{0};  // tudo antes dela já foi impresso (escritora)
+static std::atomic<uint32_t> g_sinal{0};          // acorda a escritora (atomic::wait/notify)
+static std::atomic<bool> g_escritoraDormindo{false};
+static std::atomic<bool> g_encerrar{false};
+
+static std::atomic<bool> g_assincrono{true};
+static std::once_flag g_iniciarEscritora;
+static std::thread g_escritora;
+static std::atomic<bool> g_escritoraIniciada{false};
+
+// Avisos limitados registrados (lista encadeada; só cresce)
+static std::atomic<AvisoLimitado*> g_avisos{nullptr};
+
+static const char* prefixoNivel(LogLevel nivel) {
+
+    switch (nivel) {
+
+        case LogLevel::ERROR: return "[ERROR] ";
+        case LogLevel::WARN: return "[WARN] ";
+        case LogLevel::INFO: return "[INFO] ";
+        case LogLevel::DEBUG: return "[DEBUG] ";
+
+    }
+
+    return "";
+
+}
+
+static void escritora() {
+
+    size_t lida = 0;
+
+    while (true) {
+
+        bool imprimiu = false;
+        bool usouCout = false;
+        bool usouCerr = false;
+
+        // Esvazia o que estiver pronto, sem flush linha a linha
+        while (true) {
+
+            EntradaLog& entrada = g_anel[lida & (CAPACIDADE_ANEL - 1)];
+
+            if (entrada.sequencia.load(std::memory_order_acquire) != lida + 1) {
+
+                break;
+
+            }
+
+            *entrada.saida << prefixoNivel(entrada.nivel);
+            entrada.saida->write(entrada.texto, entrada.tamanho);
+            *entrada.saida << '\n';
+
+            usouCout = usouCout || entrada.saida == &std::cout;
+            usouCerr = usouCerr || entrada.saida == &std::cerr;
+
+            entrada.sequencia.store(lida + CAPACIDADE_ANEL, std::memory_order_release);
+            ++lida;
+            imprimiu = true;
+
+        }
+
+        if (imprimiu) {
+
+            if (usouCout) std::cout.flush();
+            if (usouCerr) std::cerr.flush();
+
+            g_posicaoImpressa.store(lida, std::memory_order_release);
+            g_posicaoImpressa.notify_all();
+
+            continue;
+
+        }
+
+        if (g_encerrar.load(std::memory_order_acquire) && lida == g_posicaoEscrita.load(std::memory_order_acquire)) {
+
+            return;
+
+        }
+
+        // Anuncia que vai dormir e confere o anel de novo: um produtor que publicou antes
+        // do anúncio é visto aqui; um que publicou depois vê o anúncio e incrementa g_sinal.
+        uint32_t sinal = g_sinal.load();
+        g_escritoraDormindo.store(true);
+
+        if (g_anel[lida & (CAPACIDADE_ANEL - 1)].sequencia.load() == lida + 1 || g_encerrar.load()) {
+
+            g_escritoraDormindo.store(false);
+            continue;
+
+        }
+
+        g_sinal.wait(sinal);
+        g_escritoraDormindo.store(false);
+
+    }
+
+}
+
+static void acordarEscritora() {
+
+    if (g_escritoraDormindo.load() && g_escritoraDormindo.exchange(false)) {
+
+        g_sinal.fetch_add(1);
+        g_sinal.notify_one();
+
+    }
+
+}
+
+static void imprimirAvisosSuprimidos();
+
+// Encerra a escritora no fim do programa, depois de imprimir o que estiver no anel
+struct FinalizadorLog {
+
+    ~FinalizadorLog() {
+
+        if (g_escritora.joinable()) {
+
+            g_encerrar.store(true);
+            g_sinal.fetch_add(1);
+            g_sinal.notify_one();
+            g_escritora.join();
+
+        }
+
+        g_assincrono.store(false);
+        imprimirAvisosSuprimidos();
+
+    }
+
+};
+
+static FinalizadorLog g_finalizador;
+
+static void escreverSincrono(LogLevel nivel, std::ostream& saida, const std::string& msg) {
+
+    saida << prefixoNivel(nivel) << msg << std::endl;
+
+}
+
+static void registrar(LogLevel nivel, std::ostream& saida, const std::string& msg) {
+
+    if (!g_assincrono.load(std::memory_order_relaxed) || msg.size() > TAMANHO_TEXTO_ENTRADA) {
+
+        log_flush();
+        escreverSincrono(nivel, saida, msg);
+
+        return;
+
+    }
+
+    std::call_once(g_iniciarEscritora, []() {
+
+        for (size_t i = 0; i < CAPACIDADE_ANEL; ++i) {
+
+            g_anel[i].sequencia.store(i, std::memory_order_relaxed);
+
+        }
+
+        g_escritora = std::thread(escritora);
+        g_escritoraIniciada.store(true, std::memory_order_release);
+
+    });
+
+    size_t posicao = g_posicaoEscrita.load(std::memory_order_relaxed);
+    EntradaLog* entrada;
+
+    while (true) {
+
+        entrada = &g_anel[posicao & (CAPACIDADE_ANEL - 1)];
+        intptr_t diferenca = static_cast<intptr_t>(entrada->sequencia.load(std::memory_order_acquire)) - static_cast<intptr_t>(posicao);
+
+        if (diferenca == 0) {
+
+            if (g_posicaoEscrita.compare_exchange_weak(posicao, posicao + 1, std::memory_order_relaxed)) {
+
+                break;
+
+            }
+
+        }
+
+        else if (diferenca < 0) {
+
+            // Anel cheio: espera a escritora liberar espaço (nenhuma mensagem é descartada)
+            acordarEscritora();
+            std::this_thread::yield();
+            posicao = g_posicaoEscrita.load(std::memory_order_relaxed);
+
+        }
+
+        else {
+
+            posicao = g_posicaoEscrita.load(std::memory_order_relaxed);
+
+        }
+
+    }
+
+    entrada->nivel = nivel;
+    entrada->saida = &saida;
+    entrada->tamanho = static_cast<uint16_t>(msg.size());
+    std::memcpy(entrada->texto, msg.data(), msg.size());
+    entrada->sequencia.store(posicao + 1, std::memory_order_release);
+
+    acordarEscritora();
+
+}
+
+void log_flush() {
+
+    if (!g_escritoraIniciada.load(std::memory_order_acquire)) {
+
+        return;
+
+    }
+
+    size_t alvo = g_posicaoEscrita.load(std::memory_order_acquire);
+    size_t impressa = g_posicaoImpressa.load(std::memory_order_acquire);
+
+    while (impressa < alvo) {
+
+        acordarEscritora();
+        g_posicaoImpressa.wait(impressa, std::memory_order_acquire);
+        impressa = g_posicaoImpressa.load(std::memory_order_acquire);
+
+    }
+
+}
+
+AvisoLimitado::AvisoLimitado(const char* categoria) : categoria(categoria), ocorrencias(0), proximo(g_avisos.load()) {
+
+    while (!g_avisos.compare_exchange_weak(proximo, this)) {}
+
+}
+
+static void imprimirAvisosSuprimidos() {
+
+    for (const AvisoLimitado* aviso = g_avisos.load(); aviso != nullptr; aviso = aviso->getProximo()) {
+
+        long ocorrencias = aviso->getOcorrencias();
+
+        if (ocorrencias > AvisoLimitado::LIMITE && log_ativo(LogLevel::WARN)) {
+
+            escreverSincrono(LogLevel::WARN, std::cerr, std::string(aviso->getCategoria()) + ": " + std::to_string(ocorrencias) +
+                             " ocorrência(s), " + std::to_string(ocorrencias - AvisoLimitado::LIMITE) + " não impressa(s).");
+
+        }
+
+    }
+
+}
 
 void log_init() {
 
+    // LOG_ASYNC=0 desliga a escritora (mensagens impressas na hora, como antes)
+    const char* asyncStr = std::getenv("LOG_ASYNC");
+
+    if (asyncStr != nullptr && std::string(asyncStr) == "0") {
+
+        g_assincrono.store(false);
+
+    }
+
     // Lê a variável de ambiente "LOG_LEVEL"
     const char* levelStr = std::getenv("LOG_LEVEL");
 
     if (levelStr == nullptr) {
-    
+
         g_currentLevel = LogLevel::INFO;
-    
+
         return;
-    
+
     }
 
     std::string level(levelStr);
-    
+
     // Converte para minúsculo para ser case-insensitive
     std::transform(level.begin(), level.end(), level.begin(),[](unsigned char c){ return std::tolower(c); });
 
@@ -30,36 +320,37 @@ void log_init() {
         g_currentLevel = LogLevel::DEBUG;
 
     }
-    
+
     else if (level == "info") {
 
         g_currentLevel = LogLevel::INFO;
 
     }
-    
+
     else if (level == "warn") {
-        
+
         g_currentLevel = LogLevel::WARN;
     }
-    
+
     else if (level == "error") {
-        
+
         g_currentLevel = LogLevel::ERROR;
     }
-    
+
     else {
-        
+
         g_currentLevel = LogLevel::INFO;
-    
+
     }
 
 }
 
 void log_error(const std::string& msg) {
 
-    if (g_currentLevel >= LogLevel::ERROR) {
+    if (log_ativo(LogLevel::ERROR)) {
 
-        std::cerr << "[ERROR] " << msg << std::endl;
+        log_flush();
+        escreverSincrono(LogLevel::ERROR, std::cerr, msg);
 
     }
 
@@ -68,9 +359,9 @@ void log_error(const std::string& msg) {
 void log_warn(const std::string& msg) {
 
     // Avisos (nível 1)
-    if (g_currentLevel >= LogLevel::WARN) {
+    if (log_ativo(LogLevel::WARN)) {
 
-        std::cerr << "[WARN] " << msg << std::endl;
+        registrar(LogLevel::WARN, std::cerr, msg);
 
     }
 
@@ -79,21 +370,28 @@ void log_warn(const std::string& msg) {
 void log_info(const std::string& msg) {
 
     // Informações (nível 2)
-    if (g_currentLevel >= LogLevel::INFO) {
+    if (log_ativo(LogLevel::INFO)) {
 
-        std::cout << "[INFO] " << msg << std::endl;
+        registrar(LogLevel::INFO, *g_saidaInfo, msg);
 
     }
 
 }
 
 void log_debug(const std::string& msg) {
-    
+
     // Debug (nível 3)
-    if (g_currentLevel >= LogLevel::DEBUG) {
-    
-        std::cout << "[DEBUG] " << msg << std::endl;
-    
+    if (log_ativo(LogLevel::DEBUG)) {
+
+        registrar(LogLevel::DEBUG, *g_saidaInfo, msg);
+
     }
 
-}
\ No newline at end of file
+}
+
+void log_redirect_stderr() {
+
+    log_flush();
+    g_saidaInfo = &std::cerr;
+
+}
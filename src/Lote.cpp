@@ -0,0 +1,325 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <stdexcept>
+
+#include "Lote.hpp"
+#include "Log.hpp"
+
+// Remove as aspas delimitadoras de uma chave, desfazendo o escape "" -> ".
+static std::string removerAspas(const std::string& linha) {
+
+    if (linha.size() < 2 || linha.front() != '"' || linha.back() != '"') {
+
+        return linha;
+
+    }
+
+    std::string chave;
+
+    for (size_t i = 1; i + 1 < linha.size(); ++i) {
+
+        chave.push_back(linha[i]);
+
+        if (linha[i] == '"' && linha[i + 1] == '"' && i + 2 < linha.size()) {
+
+            ++i;
+
+        }
+
+    }
+
+    return chave;
+
+}
+
+bool lerChavesLote(const std::string& origem, std::vector<std::string>& chaves) {
+
+    std::ifstream arquivo;
+
+    if (origem != "-") {
+
+        arquivo.open(origem);
+
+        if (!arquivo.is_open()) {
+
+            return false;
+
+        }
+
+    }
+
+    std::istream& entrada = (origem == "-") ? std::cin : arquivo;
+    std::string linha;
+
+    while (std::getline(entrada, linha)) {
+
+        if (!linha.empty() && linha.back() == '\r') {
+
+            linha.pop_back();
+
+        }
+
+        if (!linha.empty()) {
+
+            chaves.push_back(removerAspas(linha));
+
+        }
+
+    }
+
+    return true;
+
+}
+
+void descartarIdsInvalidosLote(std::vector<std::string>& chaves) {
+
+    size_t validas = 0;
+
+    for (size_t i = 0; i < chaves.size(); ++i) {
+
+        size_t lidos = 0;
+        long id = 0;
+
+        try {
+
+            id = std::stol(chaves[i], &lidos);
+
+        }
+
+        catch (const std::exception& e) {
+
+            lidos = 0;
+
+        }
+
+        if (lidos != chaves[i].size() || id <= 0 || id > INT32_MAX) {
+
+            log_warn("Chave " + std::to_string(i + 1) + " ignorada: ID '" + chaves[i] + "' inválido.");
+
+            continue;
+
+        }
+
+        chaves[validas++] = chaves[i];
+
+    }
+
+    chaves.resize(validas);
+
+}
+
+std::vector<int> idsDeChavesLote(const std::vector<std::string>& chaves) {
+
+    std::vector<int> ids;
+    ids.reserve(chaves.size());
+
+    for (const std::string& chave : chaves) {
+
+        ids.push_back(std::stoi(chave));
+
+    }
+
+    return ids;
+
+}
+
+void escreverResultadoLote(EscritorRegistros& saida, const std::string& chave, const ResultadoConsulta& resultado, long latencia_ns) {
+
+    BufferSaida& buffer = saida.getBuffer();
+
+    switch (saida.getFormato()) {
+
+        case FormatoSaida::TSV:
+
+            if (resultado.registros.empty()) {
+
+                escaparCampoTSV(buffer, chave);
+                buffer.acrescentar(std::string(saida.numeroCampos(), '\t'));
+                buffer.acrescentar('\n');
+
+            }
+
+            for (const ArtigoView& artigo : resultado.registros) {
+
+                escaparCampoTSV(buffer, chave);
+                buffer.acrescentar('\t');
+                saida.escreverCamposTSV(artigo);
+                buffer.acrescentar('\n');
+
+            }
+
+            break;
+
+        case FormatoSaida::JSONL:
+
+            buffer.acrescentar("{\"chave\":");
+            escaparTextoJSON(buffer, chave);
+            buffer.acrescentar(",\"encontrados\":");
+            buffer.acrescentarInteiro(static_cast<long>(resultado.registros.size()));
+            buffer.acrescentar(",\"blocos_indice\":");
+            buffer.acrescentarInteiro(resultado.blocos_indice);
+            buffer.acrescentar(",\"blocos_dados\":");
+            buffer.acrescentarInteiro(resultado.blocos_dados);
+            buffer.acrescentar(",\"latencia_us\":");
+            buffer.acrescentarInteiro(latencia_ns / 1000);
+            buffer.acrescentar(",\"registros\":[");
+
+            for (size_t i = 0; i < resultado.registros.size(); ++i) {
+
+                if (i > 0) {
+
+                    buffer.acrescentar(',');
+
+                }
+
+                saida.escreverObjetoJSON(resultado.registros[i]);
+
+            }
+
+            buffer.acrescentar("]}\n");
+
+            break;
+
+        case FormatoSaida::TEXTO:
+
+            buffer.acrescentar("--- Chave \"");
+            buffer.acrescentar(chave);
+            buffer.acrescentar("\": ");
+            buffer.acrescentarInteiro(static_cast<long>(resultado.registros.size()));
+            buffer.acrescentar(" registro(s) ---\n");
+
+            for (const ArtigoView& artigo : resultado.registros) {
+
+                saida.escreverArtigo(artigo);
+
+            }
+
+            break;
+
+        case FormatoSaida::BINARIO: {
+
+            uint32_t quantidade = static_cast<uint32_t>(resultado.registros.size());
+            buffer.append(reinterpret_cast<const char*>(&quantidade), sizeof(quantidade));
+
+            for (const ArtigoView& artigo : resultado.registros) {
+
+                saida.escreverArtigo(artigo);
+
+            }
+
+            break;
+
+        }
+
+    }
+
+}
+
+void EstatisticasLote::registrar(const ResultadoConsulta& resultado, long latencia_ns) {
+
+    latencias_ns.push_back(latencia_ns);
+    blocos_indice.push_back(resultado.blocos_indice);
+    blocos_dados.push_back(resultado.blocos_dados);
+
+    if (!resultado.registros.empty()) {
+
+        encontradas++;
+
+    }
+
+}
+
+long percentil(const std::vector<long>& ordenado, double p) {
+
+    if (ordenado.empty()) {
+
+        return 0;
+
+    }
+
+    size_t posto = static_cast<size_t>(p / 100.0 * ordenado.size() + 0.999999);
+
+    return ordenado[std::min(std::max<size_t>(posto, 1), ordenado.size()) - 1];
+
+}
+
+// Total, média por consulta e (se comMaximo) máximo de um contador de blocos.
+static std::string resumoBlocos(const std::vector<long>& blocos, bool comMaximo) {
+
+    long total = 0;
+    long maximo = 0;
+
+    for (long b : blocos) {
+
+        total += b;
+        maximo = std::max(maximo, b);
+
+    }
+
+    char media[32];
+    std::snprintf(media, sizeof(media), "%.2f", blocos.empty() ? 0.0 : static_cast<double>(total) / blocos.size());
+
+    if (!comMaximo) {
+
+        return "total " + std::to_string(total) + ", média por consulta " + media;
+
+    }
+
+    return "total " + std::to_string(total) + ", média por consulta " + media + ", máximo " + std::to_string(maximo);
+
+}
+
+void EstatisticasLote::relatar(const std::string& programa, double duracao_s) const {
+
+    std::vector<long> ordenadas = latencias_ns;
+    std::sort(ordenadas.begin(), ordenadas.end());
+
+    auto us = [](long ns) {
+
+        char texto[32];
+        std::snprintf(texto, sizeof(texto), "%.1f", ns / 1000.0);
+
+        return std::string(texto);
+
+    };
+
+    log_info("\n--- Estatísticas do Lote (" + programa + ") ---");
+    log_info("Consultas: " + std::to_string(latencias_ns.size()) + " (" + std::to_string(encontradas) + " com registro encontrado)");
+
+    if (duracao_s > 0.0) {
+
+        log_info("Tempo total: " + std::to_string(static_cast<long>(duracao_s * 1000)) + " ms (" + std::to_string(static_cast<long>(latencias_ns.size() / duracao_s)) + " consultas/s)");
+
+    }
+
+    if (amortizado) {
+
+        // Tempo e blocos são dos grupos: por chave só faz sentido a média
+        long total_ns = 0;
+
+        for (long ns : latencias_ns) {
+
+            total_ns += ns;
+
+        }
+
+        log_info("Blocos lidos (Índice): " + resumoBlocos(blocos_indice, false) + " (amortizado no grupo)");
+        log_info("Blocos lidos (Dados): " + resumoBlocos(blocos_dados, false) + " (amortizado no grupo)");
+        log_info("Latência amortizada por consulta (us): " + us(latencias_ns.empty() ? 0 : total_ns / static_cast<long>(latencias_ns.size())) +
+                 " (tempo dos grupos / consultas; use --sem-agrupar para percentis por consulta)");
+
+        return;
+
+    }
+
+    log_info("Blocos lidos (Índice): " + resumoBlocos(blocos_indice, true));
+    log_info("Blocos lidos (Dados): " + resumoBlocos(blocos_dados, true));
+    log_info("Latência por consulta (us): p50 " + us(percentil(ordenadas, 50)) + ", p95 " + us(percentil(ordenadas, 95)) + ", p99 " + us(percentil(ordenadas, 99)) + ", máx " + us(ordenadas.empty() ? 0 : ordenadas.back()));
+
+}
@@ -0,0 +1,156 @@
+#include <fstream>
+#include <string>
+
+#include "MetaDados.hpp"
+#include "Log.hpp"
+
+bool lerMetaDados(const std::string& caminho, MetaDados& meta) {
+
+    std::ifstream meta_info(caminho, std::ios::binary);
+
+    if (!meta_info.is_open()) {
+
+        return false;
+
+    }
+
+    meta_info.read(reinterpret_cast<char*>(&meta.tamanho_bloco_dados), sizeof(size_t));
+    meta_info.read(reinterpret_cast<char*>(&meta.tamanho_bloco_btree), sizeof(size_t));
+
+    if (!meta_info || meta.tamanho_bloco_dados == 0 || meta.tamanho_bloco_btree == 0) {
+
+        return false;
+
+    }
+
+    // O modo do índice de títulos é obrigatório: sem ele, o banco foi gravado antes do
+    // formato atual de btree_titulo.idx e não pode ser aberto por estes programas.
+    int32_t modo = 0;
+
+    if (!meta_info.read(reinterpret_cast<char*>(&modo), sizeof(int32_t))) {
+
+        log_error("db.meta sem o modo do indice de titulos: banco gravado por uma versao anterior. Refaca o upload.");
+
+        return false;
+
+    }
+
+    if (modo < static_cast<int32_t>(ModoIndiceTitulo::COMPACTO) || modo > static_cast<int32_t>(ModoIndiceTitulo::HASH)) {
+
+        log_error("db.meta com modo do indice de titulos invalido: " + std::to_string(modo) + ".");
+
+        return false;
+
+    }
+
+    meta.modo_indice_titulo = static_cast<ModoIndiceTitulo>(modo);
+
+    // Campos opcionais: ausentes em arquivos gravados antes de cada recurso.
+    int32_t cobertura = 0;
+
+    if (meta_info.read(reinterpret_cast<char*>(&cobertura), sizeof(int32_t))) {
+
+        meta.indice_titulo_cobertura = (cobertura != 0);
+
+    }
+
+    int32_t indice_ano = 0;
+
+    if (meta_info.read(reinterpret_cast<char*>(&indice_ano), sizeof(int32_t))) {
+
+        meta.indice_ano = (indice_ano != 0);
+
+    }
+
+    int32_t colunas = 0;
+
+    if (meta_info.read(reinterpret_cast<char*>(&colunas), sizeof(int32_t))) {
+
+        meta.colunas = (colunas != 0);
+
+    }
+
+    int32_t colunas_atualizacao = 0;
+
+    if (meta_info.read(reinterpret_cast<char*>(&colunas_atualizacao), sizeof(int32_t))) {
+
+        meta.colunas_atualizacao = (colunas_atualizacao != 0);
+
+    }
+
+    int32_t indice_autores = 0;
+
+    if (meta_info.read(reinterpret_cast<char*>(&indice_autores), sizeof(int32_t))) {
+
+        meta.indice_autores = (indice_autores != 0);
+
+    }
+
+    return true;
+
+}
+
+bool escreverMetaDados(const std::string& caminho, const MetaDados& meta) {
+
+    std::ofstream meta_dados(caminho, std::ios::binary | std::ios::trunc);
+
+    if (!meta_dados.is_open()) {
+
+        return false;
+
+    }
+
+    int32_t modo = static_cast<int32_t>(meta.modo_indice_titulo);
+    int32_t cobertura = meta.indice_titulo_cobertura ? 1 : 0;
+    int32_t indice_ano = meta.indice_ano ? 1 : 0;
+    int32_t colunas = meta.colunas ? 1 : 0;
+    int32_t colunas_atualizacao = meta.colunas_atualizacao ? 1 : 0;
+    int32_t indice_autores = meta.indice_autores ? 1 : 0;
+
+    meta_dados.write(reinterpret_cast<const char*>(&meta.tamanho_bloco_dados), sizeof(size_t));
+    meta_dados.write(reinterpret_cast<const char*>(&meta.tamanho_bloco_btree), sizeof(size_t));
+    meta_dados.write(reinterpret_cast<const char*>(&modo), sizeof(int32_t));
+    meta_dados.write(reinterpret_cast<const char*>(&cobertura), sizeof(int32_t));
+    meta_dados.write(reinterpret_cast<const char*>(&indice_ano), sizeof(int32_t));
+    meta_dados.write(reinterpret_cast<const char*>(&colunas), sizeof(int32_t));
+    meta_dados.write(reinterpret_cast<const char*>(&colunas_atualizacao), sizeof(int32_t));
+    meta_dados.write(reinterpret_cast<const char*>(&indice_autores), sizeof(int32_t));
+
+    return static_cast<bool>(meta_dados);
+
+}
+
+bool modoIndiceTituloDeString(const std::string& nome, ModoIndiceTitulo& modo) {
+
+    if (nome == "compacto") {
+
+        modo = ModoIndiceTitulo::COMPACTO;
+
+        return true;
+
+    }
+
+    if (nome == "hash") {
+
+        modo = ModoIndiceTitulo::HASH;
+
+        return true;
+
+    }
+
+    return false;
+
+}
+
+std::string modoIndiceTituloParaString(ModoIndiceTitulo modo) {
+
+    switch (modo) {
+
+        case ModoIndiceTitulo::COMPACTO: return "compacto";
+        case ModoIndiceTitulo::HASH: return "hash";
+
+    }
+
+    return "desconhecido";
+
+}
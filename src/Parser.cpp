@@ -1,5 +1,6 @@
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <cstring>
@@ -9,23 +10,6 @@
 #include "Log.hpp"
 #include "Parser.hpp"
 
-void printArtigo(const Artigo& artigo) {
-
-    std::cout << "-------------------------------------\n";
-
-    std::cout << "ID: " << artigo.id << "\n";
-    std::cout << "Ano: " << artigo.ano << "\n";
-    std::cout << "Citacoes: " << artigo.citacoes << "\n";
-
-    std::cout << "Titulo: " << (artigo.titulo[0] == '\0' ? "[VAZIO]" : artigo.titulo) << "\n";
-    std::cout << "Autores: " << (artigo.autores[0] == '\0' ? "[VAZIO]" : artigo.autores) << "\n";
-    std::cout << "Atualizacao: " << (artigo.atualizacao[0] == '\0' ? "[VAZIO]" : artigo.atualizacao) << "\n";
-    std::cout << "Snippet: " << (artigo.snippet[0] == '\0' ? "[VAZIO]" : artigo.snippet) << "\n";
-
-    std::cout << "-------------------------------------\n";
-
-}
-
 void copiarStringSeguro(char* destino, const std::string& origem, size_t tamanhoDestino) {
     
     // Garante que o número máximo de caracteres copiado seja (tamanhoDestino - 1) para reservar 1 byte para o terminador nulo ('\0').
@@ -132,6 +116,15 @@ std::vector<std::string> divideCSVLinha(const std::string& linha) {
 
 }
 
+// Início da linha para os avisos (linhas com snippets longos têm kilobytes)
+static std::string inicioLinha(const std::string& linha) {
+
+    const size_t LIMITE = 120;
+
+    return linha.size() <= LIMITE ? linha : linha.substr(0, LIMITE) + "...";
+
+}
+
 bool parseCSVLinha(const std::string& linha, Artigo& artigo_saida) {
     
     // Passo 1: Usar o split de máquina de estados com limite.
@@ -143,7 +136,7 @@ bool parseCSVLinha(const std::string& linha, Artigo& artigo_saida) {
 
     if (campos.size() != 7) {
         
-        log_warn("[Parser] Linha ignorada (mal formatada, campos != 7): " + linha);
+        LOG_WARN_LIMITADO("[Parser] Linhas ignoradas (mal formatadas, campos != 7)", "[Parser] Linha ignorada (mal formatada, campos != 7): " + inicioLinha(linha));
 
         return false;
     
@@ -158,7 +151,7 @@ bool parseCSVLinha(const std::string& linha, Artigo& artigo_saida) {
         
         if (artigo_saida.id == 0) {
             
-            log_warn("[Parser] Linha ignorada (ID invalido ou zero): " + linha);
+            LOG_WARN_LIMITADO("[Parser] Linhas ignoradas (ID invalido ou zero)", "[Parser] Linha ignorada (ID invalido ou zero): " + inicioLinha(linha));
             
             return false;
         
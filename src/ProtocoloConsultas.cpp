@@ -0,0 +1,134 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+
+#include "ProtocoloConsultas.hpp"
+#include "Parser.hpp"
+#include "SaidaRegistros.hpp"
+
+bool ConexaoLinhas::lerLinha(std::string& linha) {
+
+    while (true) {
+
+        size_t fim = pendente.find('\n');
+
+        if (fim != std::string::npos) {
+
+            linha.assign(pendente, 0, fim);
+            pendente.erase(0, fim + 1);
+
+            return true;
+
+        }
+
+        char buffer[4096];
+        ssize_t lidos = recv(fd, buffer, sizeof(buffer), 0);
+
+        if (lidos < 0 && errno == EINTR) {
+
+            continue;
+
+        }
+
+        if (lidos <= 0) {
+
+            return false;
+
+        }
+
+        pendente.append(buffer, static_cast<size_t>(lidos));
+
+    }
+
+}
+
+bool ConexaoLinhas::enviar(const std::string& texto) {
+
+    size_t enviados = 0;
+
+    while (enviados < texto.size()) {
+
+        ssize_t escritos = send(fd, texto.data() + enviados, texto.size() - enviados, MSG_NOSIGNAL);
+
+        if (escritos < 0 && errno == EINTR) {
+
+            continue;
+
+        }
+
+        if (escritos <= 0) {
+
+            return false;
+
+        }
+
+        enviados += static_cast<size_t>(escritos);
+
+    }
+
+    return true;
+
+}
+
+std::string artigoParaLinhaTSV(const ArtigoView& artigo) {
+
+    std::string linha = std::to_string(artigo.id);
+
+    linha.push_back('\t');
+    escaparCampoTSV(linha, artigo.titulo);
+    linha += "\t" + std::to_string(artigo.ano) + "\t";
+    escaparCampoTSV(linha, artigo.autores);
+    linha += "\t" + std::to_string(artigo.citacoes) + "\t";
+    escaparCampoTSV(linha, artigo.atualizacao);
+    linha.push_back('\t');
+    escaparCampoTSV(linha, artigo.snippet);
+    linha.push_back('\n');
+
+    return linha;
+
+}
+
+bool artigoDeLinhaTSV(const std::string& linha, Artigo& artigo) {
+
+    std::vector<std::string> campos;
+    size_t inicio = 0;
+
+    while (true) {
+
+        size_t fim = linha.find('\t', inicio);
+
+        campos.push_back(linha.substr(inicio, fim == std::string::npos ? std::string::npos : fim - inicio));
+
+        if (fim == std::string::npos) {
+
+            break;
+
+        }
+
+        inicio = fim + 1;
+
+    }
+
+    if (campos.size() != 7) {
+
+        return false;
+
+    }
+
+    std::memset(&artigo, 0, sizeof(Artigo));
+
+    artigo.id = stringParaIntSeguro(campos[0]);
+    copiarStringSeguro(artigo.titulo, desescaparCampoTSV(campos[1]), sizeof(artigo.titulo));
+    artigo.ano = stringParaIntSeguro(campos[2]);
+    copiarStringSeguro(artigo.autores, desescaparCampoTSV(campos[3]), sizeof(artigo.autores));
+    artigo.citacoes = stringParaIntSeguro(campos[4]);
+    copiarStringSeguro(artigo.atualizacao, desescaparCampoTSV(campos[5]), sizeof(artigo.atualizacao));
+    copiarStringSeguro(artigo.snippet, desescaparCampoTSV(campos[6]), sizeof(artigo.snippet));
+
+    return true;
+
+}
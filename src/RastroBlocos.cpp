@@ -0,0 +1,245 @@
+#include <string>
+#include <vector>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "RastroBlocos.hpp"
+#include "Log.hpp"
+
+std::atomic<bool> g_rastroAtivo{false};
+
+static const char ASSINATURA_RASTRO[8] = {'R', 'A', 'S', 'T', 'R', 'O', 'B', '1'};
+static const uint32_t VERSAO_RASTRO = 1;
+static const size_t TAMANHO_BUFFER_RASTRO = 1 << 20;
+
+static std::once_flag g_abrirRastro;
+static std::mutex g_mutexRastro;
+static FILE* g_arquivoRastro = nullptr;
+static std::vector<char> g_bufferRastro;
+static uint16_t g_proximoArquivo = 0;
+static std::chrono::steady_clock::time_point g_inicioRastro;
+
+// Com o mutex: grava o buffer no arquivo
+static void descarregarRastro() {
+
+    if (g_arquivoRastro != nullptr && !g_bufferRastro.empty()) {
+
+        std::fwrite(g_bufferRastro.data(), 1, g_bufferRastro.size(), g_arquivoRastro);
+        g_bufferRastro.clear();
+
+    }
+
+}
+
+// Com o mutex: acrescenta bytes ao buffer
+static void acrescentarRastro(const void* dados, size_t tamanho) {
+
+    if (g_bufferRastro.size() + tamanho > TAMANHO_BUFFER_RASTRO) {
+
+        descarregarRastro();
+
+    }
+
+    const char* bytes = static_cast<const char*>(dados);
+    g_bufferRastro.insert(g_bufferRastro.end(), bytes, bytes + tamanho);
+
+}
+
+// Fecha o rastro no fim do programa
+struct FinalizadorRastro {
+
+    ~FinalizadorRastro() {
+
+        std::lock_guard<std::mutex> trava(g_mutexRastro);
+
+        g_rastroAtivo.store(false);
+
+        if (g_arquivoRastro != nullptr) {
+
+            descarregarRastro();
+            std::fclose(g_arquivoRastro);
+            g_arquivoRastro = nullptr;
+
+        }
+
+    }
+
+};
+
+static FinalizadorRastro g_finalizadorRastro;
+
+static void abrirRastro() {
+
+    const char* nome = std::getenv("RASTRO_BLOCOS");
+
+    if (nome == nullptr || *nome == '\0') {
+
+        return;
+
+    }
+
+    std::string caminho = nome;
+    size_t marcador = caminho.find("%p");
+
+    if (marcador != std::string::npos) {
+
+        caminho.replace(marcador, 2, std::to_string(getpid()));
+
+    }
+
+    if (caminho[0] != '/') {
+
+        caminho = "/data/" + caminho;
+
+    }
+
+    g_arquivoRastro = std::fopen(caminho.c_str(), "wb");
+
+    if (g_arquivoRastro == nullptr) {
+
+        log_warn("[Rastro] Nao foi possivel criar " + caminho + ": " + std::strerror(errno) + ". Rastro desligado.");
+
+        return;
+
+    }
+
+    CabecalhoRastro cabecalho;
+    std::memcpy(cabecalho.assinatura, ASSINATURA_RASTRO, sizeof(cabecalho.assinatura));
+    cabecalho.versao = VERSAO_RASTRO;
+    cabecalho.reservado = 0;
+
+    g_bufferRastro.reserve(TAMANHO_BUFFER_RASTRO);
+    acrescentarRastro(&cabecalho, sizeof(cabecalho));
+
+    g_inicioRastro = std::chrono::steady_clock::now();
+    g_rastroAtivo.store(true);
+
+    log_info("[Rastro] Gravando acessos a blocos em " + caminho);
+
+}
+
+uint16_t rastro_registrar_arquivo(const std::string& caminho, size_t tamanho_bloco) {
+
+    std::call_once(g_abrirRastro, abrirRastro);
+
+    if (!rastro_ativo()) {
+
+        return 0;
+
+    }
+
+    std::lock_guard<std::mutex> trava(g_mutexRastro);
+
+    RegistroRastro registro = {};
+    registro.tempo_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_inicioRastro).count());
+    registro.arquivo = g_proximoArquivo;
+    registro.tipo = static_cast<uint8_t>(TipoAcessoBloco::ACESSO_ARQUIVO);
+
+    DeclaracaoArquivoRastro declaracao;
+    declaracao.tamanho_bloco = static_cast<uint32_t>(tamanho_bloco);
+    declaracao.tamanho_nome = static_cast<uint16_t>(std::min<size_t>(caminho.size(), UINT16_MAX));
+
+    acrescentarRastro(&registro, sizeof(registro));
+    acrescentarRastro(&declaracao, sizeof(declaracao));
+    acrescentarRastro(caminho.data(), declaracao.tamanho_nome);
+
+    return g_proximoArquivo++;
+
+}
+
+void rastro_acesso(uint16_t arquivo, size_t bloco, TipoAcessoBloco tipo) {
+
+    RegistroRastro registro;
+    registro.bloco = static_cast<uint32_t>(bloco);
+    registro.arquivo = arquivo;
+    registro.tipo = static_cast<uint8_t>(tipo);
+    registro.reservado = 0;
+
+    std::lock_guard<std::mutex> trava(g_mutexRastro);
+
+    if (g_arquivoRastro == nullptr) {
+
+        return;
+
+    }
+
+    // Dentro do mutex: os tempos saem em ordem crescente no arquivo
+    registro.tempo_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - g_inicioRastro).count());
+
+    acrescentarRastro(&registro, sizeof(registro));
+
+}
+
+//#################################################################
+// Leitura
+//#################################################################
+
+LeitorRastro::LeitorRastro(const std::string& caminho) : entrada(caminho, std::ios::binary) {
+
+    if (!entrada.is_open()) {
+
+        throw std::runtime_error("[Rastro] Nao foi possivel abrir " + caminho);
+
+    }
+
+    CabecalhoRastro cabecalho;
+
+    if (!entrada.read(reinterpret_cast<char*>(&cabecalho), sizeof(cabecalho)) ||
+        std::memcmp(cabecalho.assinatura, ASSINATURA_RASTRO, sizeof(cabecalho.assinatura)) != 0) {
+
+        throw std::runtime_error("[Rastro] " + caminho + " nao e um rastro de blocos (RASTRO_BLOCOS).");
+
+    }
+
+    if (cabecalho.versao != VERSAO_RASTRO) {
+
+        throw std::runtime_error("[Rastro] Versao de rastro nao suportada: " + std::to_string(cabecalho.versao));
+
+    }
+
+}
+
+bool LeitorRastro::proximo(RegistroRastro& registro) {
+
+    while (entrada.read(reinterpret_cast<char*>(&registro), sizeof(registro))) {
+
+        if (registro.tipo != static_cast<uint8_t>(TipoAcessoBloco::ACESSO_ARQUIVO)) {
+
+            return true;
+
+        }
+
+        DeclaracaoArquivoRastro declaracao;
+        ArquivoRastro arquivo;
+
+        if (!entrada.read(reinterpret_cast<char*>(&declaracao), sizeof(declaracao))) {
+
+            throw std::runtime_error("[Rastro] Rastro truncado em uma declaracao de arquivo.");
+
+        }
+
+        arquivo.nome.resize(declaracao.tamanho_nome);
+        arquivo.tamanho_bloco = declaracao.tamanho_bloco;
+
+        if (!entrada.read(arquivo.nome.data(), declaracao.tamanho_nome)) {
+
+            throw std::runtime_error("[Rastro] Rastro truncado em uma declaracao de arquivo.");
+
+        }
+
+        arquivos.resize(std::max<size_t>(arquivos.size(), registro.arquivo + 1));
+        arquivos[registro.arquivo] = arquivo;
+
+    }
+
+    // Fim do arquivo (um registro incompleto no fim, de um processo interrompido, é ignorado)
+    return false;
+
+}
@@ -0,0 +1,335 @@
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <iostream>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <cstdint>
+#include <stdexcept>
+#include <unistd.h>
+
+#include "SaidaRegistros.hpp"
+#include "Log.hpp"
+
+bool formatoSaidaDeString(const std::string& nome, FormatoSaida& formato) {
+
+    if (nome == "text") formato = FormatoSaida::TEXTO;
+    else if (nome == "tsv") formato = FormatoSaida::TSV;
+    else if (nome == "jsonl") formato = FormatoSaida::JSONL;
+    else if (nome == "binary") formato = FormatoSaida::BINARIO;
+    else return false;
+
+    return true;
+
+}
+
+bool selecaoCamposDeString(const std::string& lista, SelecaoCampos& selecao) {
+
+    selecao = SelecaoCampos();
+    selecao.id = selecao.titulo = selecao.ano = selecao.autores = false;
+    selecao.citacoes = selecao.atualizacao = selecao.snippet = false;
+
+    std::stringstream ss(lista);
+    std::string nome;
+    bool algum = false;
+
+    while (std::getline(ss, nome, ',')) {
+
+        if (nome == "id") selecao.id = true;
+        else if (nome == "titulo") selecao.titulo = true;
+        else if (nome == "ano") selecao.ano = true;
+        else if (nome == "autores") selecao.autores = true;
+        else if (nome == "citacoes") selecao.citacoes = true;
+        else if (nome == "atualizacao") selecao.atualizacao = true;
+        else if (nome == "snippet") selecao.snippet = true;
+        else return false;
+
+        algum = true;
+
+    }
+
+    return algum;
+
+}
+
+std::string desescaparCampoTSV(std::string_view campo) {
+
+    std::string texto;
+    texto.reserve(campo.size());
+
+    for (size_t i = 0; i < campo.size(); ++i) {
+
+        if (campo[i] != '\\' || i + 1 == campo.size()) {
+
+            texto.push_back(campo[i]);
+
+            continue;
+
+        }
+
+        switch (campo[i + 1]) {
+
+            case '\\': texto.push_back('\\'); break;
+            case 't': texto.push_back('\t'); break;
+            case 'n': texto.push_back('\n'); break;
+            case 'r': texto.push_back('\r'); break;
+
+            default:
+
+                texto.push_back('\\');
+                texto.push_back(campo[i + 1]);
+
+        }
+
+        ++i;
+
+    }
+
+    return texto;
+
+}
+
+//#################################################################
+// BufferSaida
+//#################################################################
+
+BufferSaida::BufferSaida(int fd, size_t capacidade) : fd(fd), dados(new char[capacidade]), usados(0), capacidade(capacidade) {}
+
+BufferSaida::~BufferSaida() {
+
+    try {
+
+        descarregar();
+
+    }
+
+    catch (const std::exception& e) {
+
+        log_error(e.what());
+
+    }
+
+    delete[] dados;
+
+}
+
+void BufferSaida::escreverTudo(const char* texto, size_t tamanho) {
+
+    size_t escritos = 0;
+
+    while (escritos < tamanho) {
+
+        ssize_t n = write(fd, texto + escritos, tamanho - escritos);
+
+        if (n < 0 && errno == EINTR) {
+
+            continue;
+
+        }
+
+        if (n <= 0) {
+
+            throw std::runtime_error(std::string("[SaidaRegistros] Falha ao escrever a saida: ") + std::strerror(errno));
+
+        }
+
+        escritos += static_cast<size_t>(n);
+
+    }
+
+}
+
+void BufferSaida::acrescentarGrande(const char* texto, size_t tamanho) {
+
+    descarregar();
+
+    if (tamanho <= capacidade) {
+
+        std::memcpy(dados, texto, tamanho);
+        usados = tamanho;
+
+        return;
+
+    }
+
+    // Maior que o buffer inteiro: vai direto para o descritor
+    escreverTudo(texto, tamanho);
+
+}
+
+void BufferSaida::descarregar() {
+
+    if (usados == 0) {
+
+        return;
+
+    }
+
+    // O log é assíncrono: as mensagens anteriores saem antes dos registros
+    log_flush();
+    std::cout.flush();
+
+    size_t tamanho = usados;
+    usados = 0;
+
+    escreverTudo(dados, tamanho);
+
+}
+
+//#################################################################
+// EscritorRegistros
+//#################################################################
+
+// Campo de texto ou "[VAZIO]"
+static std::string_view textoOuVazio(std::string_view texto) {
+
+    return texto.empty() ? std::string_view("[VAZIO]") : texto;
+
+}
+
+static const std::string_view SEPARADOR_TEXTO = "-------------------------------------\n";
+
+EscritorRegistros::EscritorRegistros(FormatoSaida formato, const SelecaoCampos& selecao, int fd) : buffer(fd), formato(formato), selecao(selecao) {}
+
+void EscritorRegistros::escreverCabecalho() {
+
+    if (formato == FormatoSaida::BINARIO && !cabecalho_escrito) {
+
+        buffer.append(ASSINATURA_SAIDA_BINARIA, sizeof(ASSINATURA_SAIDA_BINARIA));
+        cabecalho_escrito = true;
+
+    }
+
+}
+
+size_t EscritorRegistros::numeroCampos() const {
+
+    return selecao.id + selecao.titulo + selecao.ano + selecao.autores + selecao.citacoes + selecao.atualizacao + selecao.snippet;
+
+}
+
+void EscritorRegistros::escreverCamposTSV(const ArtigoView& artigo) {
+
+    bool primeiro = true;
+
+    // Separador antes de cada campo, menos o primeiro
+    auto separar = [&]() {
+
+        if (!primeiro) {
+
+            buffer.acrescentar('\t');
+
+        }
+
+        primeiro = false;
+
+    };
+
+    if (selecao.id) { separar(); buffer.acrescentarInteiro(artigo.id); }
+    if (selecao.titulo) { separar(); escaparCampoTSV(buffer, artigo.titulo); }
+    if (selecao.ano) { separar(); buffer.acrescentarInteiro(artigo.ano); }
+    if (selecao.autores) { separar(); escaparCampoTSV(buffer, artigo.autores); }
+    if (selecao.citacoes) { separar(); buffer.acrescentarInteiro(artigo.citacoes); }
+    if (selecao.atualizacao) { separar(); escaparCampoTSV(buffer, artigo.atualizacao); }
+    if (selecao.snippet) { separar(); escaparCampoTSV(buffer, artigo.snippet); }
+
+}
+
+void EscritorRegistros::escreverObjetoJSON(const ArtigoView& artigo) {
+
+    char separador = '{';
+
+    // Abre o objeto no primeiro campo e separa os seguintes com vírgula
+    auto chave = [&](std::string_view nome) {
+
+        buffer.acrescentar(separador);
+        buffer.acrescentar(nome);
+        separador = ',';
+
+    };
+
+    if (selecao.id) { chave("\"id\":"); buffer.acrescentarInteiro(artigo.id); }
+    if (selecao.titulo) { chave("\"titulo\":"); escaparTextoJSON(buffer, artigo.titulo); }
+    if (selecao.ano) { chave("\"ano\":"); buffer.acrescentarInteiro(artigo.ano); }
+    if (selecao.autores) { chave("\"autores\":"); escaparTextoJSON(buffer, artigo.autores); }
+    if (selecao.citacoes) { chave("\"citacoes\":"); buffer.acrescentarInteiro(artigo.citacoes); }
+    if (selecao.atualizacao) { chave("\"atualizacao\":"); escaparTextoJSON(buffer, artigo.atualizacao); }
+    if (selecao.snippet) { chave("\"snippet\":"); escaparTextoJSON(buffer, artigo.snippet); }
+
+    if (separador == '{') {
+
+        buffer.acrescentar('{');
+
+    }
+
+    buffer.acrescentar('}');
+
+}
+
+void EscritorRegistros::escreverArtigo(const ArtigoView& artigo) {
+
+    switch (formato) {
+
+        case FormatoSaida::TEXTO:
+
+            buffer.acrescentar(SEPARADOR_TEXTO);
+
+            if (selecao.id) { buffer.acrescentar("ID: "); buffer.acrescentarInteiro(artigo.id); buffer.acrescentar('\n'); }
+            if (selecao.ano) { buffer.acrescentar("Ano: "); buffer.acrescentarInteiro(artigo.ano); buffer.acrescentar('\n'); }
+            if (selecao.citacoes) { buffer.acrescentar("Citacoes: "); buffer.acrescentarInteiro(artigo.citacoes); buffer.acrescentar('\n'); }
+
+            if (selecao.titulo) { buffer.acrescentar("Titulo: "); buffer.acrescentar(textoOuVazio(artigo.titulo)); buffer.acrescentar('\n'); }
+            if (selecao.autores) { buffer.acrescentar("Autores: "); buffer.acrescentar(textoOuVazio(artigo.autores)); buffer.acrescentar('\n'); }
+            if (selecao.atualizacao) { buffer.acrescentar("Atualizacao: "); buffer.acrescentar(textoOuVazio(artigo.atualizacao)); buffer.acrescentar('\n'); }
+            if (selecao.snippet) { buffer.acrescentar("Snippet: "); buffer.acrescentar(textoOuVazio(artigo.snippet)); buffer.acrescentar('\n'); }
+
+            buffer.acrescentar(SEPARADOR_TEXTO);
+
+            break;
+
+        case FormatoSaida::TSV:
+
+            escreverCamposTSV(artigo);
+            buffer.acrescentar('\n');
+
+            break;
+
+        case FormatoSaida::JSONL:
+
+            escreverObjetoJSON(artigo);
+            buffer.acrescentar('\n');
+
+            break;
+
+        case FormatoSaida::BINARIO: {
+
+            escreverCabecalho();
+
+            std::string_view titulo = selecao.titulo ? artigo.titulo.substr(0, UINT16_MAX) : std::string_view();
+            std::string_view autores = selecao.autores ? artigo.autores.substr(0, UINT16_MAX) : std::string_view();
+            std::string_view atualizacao = selecao.atualizacao ? artigo.atualizacao.substr(0, UINT16_MAX) : std::string_view();
+            std::string_view snippet = selecao.snippet ? artigo.snippet.substr(0, UINT16_MAX) : std::string_view();
+
+            CabecalhoRegistroBinario cabecalho;
+            cabecalho.id = selecao.id ? artigo.id : 0;
+            cabecalho.ano = selecao.ano ? artigo.ano : 0;
+            cabecalho.citacoes = selecao.citacoes ? artigo.citacoes : 0;
+            cabecalho.tamanho_titulo = static_cast<uint16_t>(titulo.size());
+            cabecalho.tamanho_autores = static_cast<uint16_t>(autores.size());
+            cabecalho.tamanho_atualizacao = static_cast<uint16_t>(atualizacao.size());
+            cabecalho.tamanho_snippet = static_cast<uint16_t>(snippet.size());
+
+            buffer.append(reinterpret_cast<const char*>(&cabecalho), sizeof(cabecalho));
+            buffer.acrescentar(titulo);
+            buffer.acrescentar(autores);
+            buffer.acrescentar(atualizacao);
+            buffer.acrescentar(snippet);
+
+            break;
+
+        }
+
+    }
+
+}
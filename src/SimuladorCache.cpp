@@ -0,0 +1,242 @@
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+
+#include "SimuladorCache.hpp"
+
+//#################################################################
+// LRU
+//#################################################################
+
+CacheLRU::CacheLRU(size_t capacidade) : capacidade(capacidade) {
+
+    if (capacidade == 0) {
+
+        throw std::invalid_argument("[SimuladorCache] A capacidade deve ser positiva.");
+
+    }
+
+    posicoes.reserve(capacidade);
+
+}
+
+bool CacheLRU::acessar(uint64_t chave) {
+
+    auto it = posicoes.find(chave);
+
+    if (it != posicoes.end()) {
+
+        ordem.splice(ordem.begin(), ordem, it->second);
+
+        return true;
+
+    }
+
+    if (posicoes.size() == capacidade) {
+
+        posicoes.erase(ordem.back());
+        ordem.pop_back();
+
+    }
+
+    ordem.push_front(chave);
+    posicoes.emplace(chave, ordem.begin());
+
+    return false;
+
+}
+
+//#################################################################
+// CLOCK
+//#################################################################
+
+CacheCLOCK::CacheCLOCK(size_t capacidade) : capacidade(capacidade), ponteiro(0) {
+
+    if (capacidade == 0) {
+
+        throw std::invalid_argument("[SimuladorCache] A capacidade deve ser positiva.");
+
+    }
+
+    quadros.reserve(capacidade);
+    referenciado.reserve(capacidade);
+    posicoes.reserve(capacidade);
+
+}
+
+bool CacheCLOCK::acessar(uint64_t chave) {
+
+    auto it = posicoes.find(chave);
+
+    if (it != posicoes.end()) {
+
+        referenciado[it->second] = 1;
+
+        return true;
+
+    }
+
+    if (quadros.size() < capacidade) {
+
+        posicoes.emplace(chave, quadros.size());
+        quadros.push_back(chave);
+        referenciado.push_back(0);
+
+        return false;
+
+    }
+
+    // Segunda chance: limpa os bits até achar um quadro não referenciado
+    while (referenciado[ponteiro]) {
+
+        referenciado[ponteiro] = 0;
+        ponteiro = (ponteiro + 1) % capacidade;
+
+    }
+
+    posicoes.erase(quadros[ponteiro]);
+    posicoes.emplace(chave, ponteiro);
+    quadros[ponteiro] = chave;
+    ponteiro = (ponteiro + 1) % capacidade;
+
+    return false;
+
+}
+
+//#################################################################
+// ARC
+//#################################################################
+
+CacheARC::CacheARC(size_t capacidade) : capacidade(capacidade), alvo_t1(0) {
+
+    if (capacidade == 0) {
+
+        throw std::invalid_argument("[SimuladorCache] A capacidade deve ser positiva.");
+
+    }
+
+    entradas.reserve(2 * capacidade);
+
+}
+
+void CacheARC::mover(Entrada& entrada, Lista destino) {
+
+    listas[destino].splice(listas[destino].begin(), listas[entrada.lista], entrada.posicao);
+    entrada.lista = destino;
+    entrada.posicao = listas[destino].begin();
+
+}
+
+void CacheARC::descartarMaisAntigo(Lista lista) {
+
+    entradas.erase(listas[lista].back());
+    listas[lista].pop_back();
+
+}
+
+// REPLACE(x, p): expulsa o mais antigo de T1 ou de T2 para o fantasma correspondente
+void CacheARC::substituir(bool chave_em_b2) {
+
+    size_t tamanho_t1 = listas[T1].size();
+
+    if (tamanho_t1 == 0 && listas[T2].empty()) {
+
+        return;
+
+    }
+
+    if (tamanho_t1 > 0 && (tamanho_t1 > alvo_t1 || (chave_em_b2 && tamanho_t1 == alvo_t1) || listas[T2].empty())) {
+
+        uint64_t vitima = listas[T1].back();
+        mover(entradas[vitima], B1);
+
+    }
+
+    else {
+
+        uint64_t vitima = listas[T2].back();
+        mover(entradas[vitima], B2);
+
+    }
+
+}
+
+bool CacheARC::acessar(uint64_t chave) {
+
+    auto it = entradas.find(chave);
+
+    // Caso I: acerto em T1 ou T2
+    if (it != entradas.end() && (it->second.lista == T1 || it->second.lista == T2)) {
+
+        mover(it->second, T2);
+
+        return true;
+
+    }
+
+    // Caso II: fantasma em B1, T1 merecia mais espaço
+    if (it != entradas.end() && it->second.lista == B1) {
+
+        size_t delta = std::max<size_t>(listas[B2].size() / listas[B1].size(), 1);
+        alvo_t1 = std::min(capacidade, alvo_t1 + delta);
+
+        substituir(false);
+        mover(it->second, T2);
+
+        return false;
+
+    }
+
+    // Caso III: fantasma em B2, T2 merecia mais espaço
+    if (it != entradas.end() && it->second.lista == B2) {
+
+        size_t delta = std::max<size_t>(listas[B1].size() / listas[B2].size(), 1);
+        alvo_t1 = alvo_t1 > delta ? alvo_t1 - delta : 0;
+
+        substituir(true);
+        mover(it->second, T2);
+
+        return false;
+
+    }
+
+    // Caso IV: chave nova
+    size_t l1 = listas[T1].size() + listas[B1].size();
+    size_t total = l1 + listas[T2].size() + listas[B2].size();
+
+    if (l1 == capacidade) {
+
+        if (listas[T1].size() < capacidade) {
+
+            descartarMaisAntigo(B1);
+            substituir(false);
+
+        }
+
+        else {
+
+            descartarMaisAntigo(T1);
+
+        }
+
+    }
+
+    else if (total >= capacidade) {
+
+        if (total == 2 * capacidade) {
+
+            descartarMaisAntigo(B2);
+
+        }
+
+        substituir(false);
+
+    }
+
+    listas[T1].push_front(chave);
+    entradas[chave] = Entrada{T1, listas[T1].begin()};
+
+    return false;
+
+}
@@ -0,0 +1,129 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+#include "VarreduraTabela.hpp"
+#include "BlocoDeDados.hpp"
+
+// Texto de um campo fixo até o primeiro '\0'
+static std::string_view campoTexto(const char* texto, size_t tamanho) {
+
+    return std::string_view(texto, strnlen(texto, tamanho));
+
+}
+
+bool PredicadoVarredura::aceita(const Artigo& artigo) const {
+
+    if (artigo.ano < ano_min || artigo.ano > ano_max || artigo.citacoes < citacoes_min) {
+
+        return false;
+
+    }
+
+    if (!titulo_contem.empty() && campoTexto(artigo.titulo, sizeof(artigo.titulo)).find(titulo_contem) == std::string_view::npos) {
+
+        return false;
+
+    }
+
+    if (!autores_contem.empty() && campoTexto(artigo.autores, sizeof(artigo.autores)).find(autores_contem) == std::string_view::npos) {
+
+        return false;
+
+    }
+
+    return true;
+
+}
+
+void EstatisticasVarredura::somar(const EstatisticasVarredura& outra) {
+
+    buckets_primarios += outra.buckets_primarios;
+    blocos_overflow += outra.blocos_overflow;
+    registros += outra.registros;
+    aceitos += outra.aceitos;
+
+}
+
+// Avalia os registros de um bloco e devolve o próximo bloco da cadeia (-1 no fim)
+static long varrerBloco(const BlocoDeDados* bloco, const PredicadoVarredura& predicado, std::vector<ArtigoView>* aceitos,
+                        EstatisticasVarredura& estatisticas) {
+
+    size_t registros = std::min(bloco->contador_registros, CAPACIDADE_BUCKET);
+
+    for (size_t i = 0; i < registros; ++i) {
+
+        if (predicado.aceita(bloco->registros[i])) {
+
+            estatisticas.aceitos++;
+
+            if (aceitos != nullptr) {
+
+                aceitos->emplace_back(bloco->registros[i]);
+
+            }
+
+        }
+
+    }
+
+    estatisticas.registros += static_cast<long>(registros);
+
+    return bloco->proximo_bloco_overflow;
+
+}
+
+void varrerParticao(GerenciadorArquivoDados& dados, const PredicadoVarredura& predicado, size_t bucket_inicio, size_t bucket_fim,
+                    std::vector<ArtigoView>* aceitos, EstatisticasVarredura& estatisticas) {
+
+    const long total_blocos = static_cast<long>(dados.obterNumeroTotalBlocos());
+
+    bucket_fim = std::min(bucket_fim, static_cast<size_t>(total_blocos));
+
+    if (bucket_inicio >= bucket_fim) {
+
+        return;
+
+    }
+
+    // Os primários da partição são contíguos: leitura antecipada agressiva só sobre eles
+    dados.sugerirLeituraSequencial(bucket_inicio, bucket_fim - bucket_inicio);
+
+    for (size_t bucket = bucket_inicio; bucket < bucket_fim; ++bucket) {
+
+        const BlocoDeDados* primario = static_cast<const BlocoDeDados*>(dados.getPonteiroBloco(bucket));
+        long proximo = varrerBloco(primario, predicado, aceitos, estatisticas);
+
+        estatisticas.buckets_primarios++;
+
+        // Cadeia de overflow: blocos espalhados no fim do arquivo, lidos só por esta partição
+        long passos = 0;
+
+        while (proximo != -1) {
+
+            if (proximo < 0 || proximo >= total_blocos || ++passos > total_blocos) {
+
+                throw std::runtime_error("[VarreduraTabela] Cadeia de overflow invalida a partir do bucket " + std::to_string(bucket) + ".");
+
+            }
+
+            const BlocoDeDados* overflow = static_cast<const BlocoDeDados*>(dados.getPonteiroBloco(static_cast<size_t>(proximo)));
+
+            // Pede o bloco seguinte da cadeia antes de avaliar este
+            if (overflow->proximo_bloco_overflow != -1) {
+
+                dados.anteciparBloco(static_cast<size_t>(overflow->proximo_bloco_overflow));
+
+            }
+
+            proximo = varrerBloco(overflow, predicado, aceitos, estatisticas);
+            estatisticas.blocos_overflow++;
+
+        }
+
+    }
+
+}
@@ -0,0 +1,335 @@
+// Módulos C++
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "Argumentos.hpp"
+#include "MetaDados.hpp"
+#include "Colunas.hpp"
+#include "ExecutorConsultas.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * @brief Programa agrega: filtra e agrega os registros lendo só as colunas de /data/db/colunas.
+ *
+ * "agrega" sem filtros conta os registros e soma as citações de cada ano; --ano, --anos,
+ * --citacoes-min e --atualizado-desde restringem as linhas. Nada de artigos.dat ou dos
+ * índices é lido: a varredura percorre vetores densos (2 + 4 bytes por linha, mais 8
+ * com --atualizado-desde), dividida entre as threads em faixas contíguas de linhas.
+ */
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada.
+    //#################################################################
+
+    FiltroColunas filtro;
+    bool por_ano = true;
+    bool listar = false;
+    long long num_threads = 1;
+
+    bool argumentos_validos = true;
+
+    for (int i = 1; i < argc && argumentos_validos; ++i) {
+
+        std::string opcao = argv[i];
+        long long valor = 0, fim = 0;
+
+        if (opcao == "--listar") {
+
+            listar = true;
+
+        }
+
+        else if (opcao == "--anos" && i + 2 < argc) {
+
+            argumentos_validos = lerInteiroArgumento(argv[i + 1], "Ano inicial", INT16_MIN, INT16_MAX, valor) &&
+                                 lerInteiroArgumento(argv[i + 2], "Ano final", INT16_MIN, INT16_MAX, fim);
+            filtro.ano_min = static_cast<int16_t>(valor);
+            filtro.ano_max = static_cast<int16_t>(fim);
+            i += 2;
+
+        }
+
+        else if (i + 1 >= argc) {
+
+            argumentos_validos = false;
+
+        }
+
+        else if (opcao == "--ano") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Ano", INT16_MIN, INT16_MAX, valor);
+            filtro.ano_min = filtro.ano_max = static_cast<int16_t>(valor);
+
+        }
+
+        else if (opcao == "--citacoes-min") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Minimo de citacoes", INT32_MIN, INT32_MAX, valor);
+            filtro.citacoes_min = static_cast<int32_t>(valor);
+
+        }
+
+        else if (opcao == "--atualizado-desde") {
+
+            int64_t segundos = 0;
+
+            argumentos_validos = epochDeData(argv[++i], segundos);
+            filtro.atualizado_desde = segundos;
+
+            if (!argumentos_validos) {
+
+                log_error("Data '" + std::string(argv[i]) + "' inválida. Use AAAA-MM-DD ou 'AAAA-MM-DD hh:mm:ss'.");
+
+            }
+
+        }
+
+        else if (opcao == "--por") {
+
+            std::string grupo = argv[++i];
+
+            argumentos_validos = (grupo == "ano" || grupo == "nenhum");
+            por_ano = (grupo == "ano");
+
+        }
+
+        else if (opcao == "--threads") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Número de threads", 1, 256, num_threads);
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (argumentos_validos && filtro.ano_min > filtro.ano_max) {
+
+        log_error("Faixa de anos vazia: o ano inicial deve ser menor ou igual ao final.");
+
+        return 1;
+
+    }
+
+    if (!argumentos_validos) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " [--ano A | --anos INI FIM] [--citacoes-min N] [--atualizado-desde AAAA-MM-DD] [--por ano|nenhum] [--threads N] [--listar]");
+        log_error("Comando esperado: docker compose run --rm agrega --anos 2000 2010 --citacoes-min 10");
+        return 1;
+
+    }
+
+    // --listar escreve as linhas na saída padrão; o log vai para std::cerr
+    if (listar) {
+
+        log_redirect_stderr();
+
+    }
+
+    //#################################################################
+    // 2. Abertura das colunas.
+    //#################################################################
+
+    const std::string dataDir = "/data/db";
+    const std::string metaDir = dataDir + "/db.meta";
+    const std::string colunasDir = dataDir + "/colunas";
+
+    MetaDados meta;
+
+    if (!lerMetaDados(metaDir, meta)) {
+
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
+        log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
+
+        return 1;
+
+    }
+
+    if (!meta.colunas) {
+
+        log_error("O banco não tem colunas. Refaça o upload com --colunas (ou --colunas-atualizacao).");
+
+        return 1;
+
+    }
+
+    if (filtro.usaAtualizacao() && !meta.colunas_atualizacao) {
+
+        log_error("--atualizado-desde exige a coluna atualizacao. Refaça o upload com --colunas-atualizacao.");
+
+        return 1;
+
+    }
+
+    try {
+
+        LeitorColunas colunas(colunasDir);
+        const uint64_t linhas = colunas.getLinhas();
+
+        colunas.aconselharSequencial(Coluna::ANO);
+        colunas.aconselharSequencial(Coluna::CITACOES);
+
+        if (filtro.usaAtualizacao()) {
+
+            colunas.aconselharSequencial(Coluna::ATUALIZACAO);
+
+        }
+
+    //#################################################################
+    // 3. Varredura: uma faixa contígua de linhas por tarefa.
+    //#################################################################
+
+        ExecutorConsultas executor(static_cast<int>(num_threads));
+
+        const size_t partes = static_cast<size_t>(num_threads);
+        const uint64_t linhas_por_parte = (linhas + partes - 1) / partes;
+
+        // Acumuladores por parte, somados no fim (nenhuma escrita compartilhada na varredura)
+        std::vector<std::vector<AgregadoAno>> agregados(partes, std::vector<AgregadoAno>(NUM_ANOS_AGREGADOS));
+        std::vector<std::vector<uint64_t>> aceitas(listar ? partes : 0);
+
+        auto inicio = std::chrono::steady_clock::now();
+
+        executor.paraCada(partes, [&](size_t p) {
+
+            uint64_t de = std::min(linhas, p * linhas_por_parte);
+            uint64_t ate = std::min(linhas, de + linhas_por_parte);
+
+            agregarColunas(colunas, filtro, de, ate, agregados[p].data(), listar ? &aceitas[p] : nullptr);
+
+        });
+
+        double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+        std::vector<AgregadoAno>& total = agregados[0];
+
+        for (size_t p = 1; p < partes; ++p) {
+
+            for (size_t a = 0; a < NUM_ANOS_AGREGADOS; ++a) {
+
+                total[a].registros += agregados[p][a].registros;
+                total[a].soma_citacoes += agregados[p][a].soma_citacoes;
+                total[a].max_citacoes = std::max(total[a].max_citacoes, agregados[p][a].max_citacoes);
+
+            }
+
+        }
+
+        const uint64_t bytes_lidos = linhas * (larguraColuna(Coluna::ANO) + larguraColuna(Coluna::CITACOES) +
+                                               (filtro.usaAtualizacao() ? larguraColuna(Coluna::ATUALIZACAO) : 0));
+
+        std::ostringstream resumo;
+        resumo << "Linhas varridas: " << linhas << " em " << std::fixed << std::setprecision(3) << segundos * 1000.0 << " ms ("
+               << std::setprecision(2) << (segundos > 0 ? bytes_lidos / segundos / 1e9 : 0.0) << " GB/s, "
+               << bytes_lidos / (1024.0 * 1024.0) << " MB lidos, " << num_threads << " thread(s))";
+        log_info(resumo.str());
+
+    //#################################################################
+    // 4. Resultado.
+    //#################################################################
+
+        if (listar) {
+
+            // id, ano, citacoes e bucket de artigos.dat das linhas aceitas, na ordem de inserção
+            BufferSaida saida;
+
+            const int32_t* ids = colunas.ids();
+            const int16_t* anos = colunas.anos();
+            const int32_t* citacoes = colunas.citacoes();
+            const uint32_t* buckets = colunas.buckets();
+
+            for (const std::vector<uint64_t>& parte : aceitas) {
+
+                for (uint64_t linha : parte) {
+
+                    saida.acrescentarInteiro(ids[linha]);
+                    saida.acrescentar('\t');
+                    saida.acrescentarInteiro(anos[linha]);
+                    saida.acrescentar('\t');
+                    saida.acrescentarInteiro(citacoes[linha]);
+                    saida.acrescentar('\t');
+                    saida.acrescentarInteiro(static_cast<long>(buckets[linha]));
+                    saida.acrescentar('\n');
+
+                }
+
+            }
+
+            saida.descarregar();
+
+            return 0;
+
+        }
+
+        AgregadoAno geral;
+
+        for (const AgregadoAno& grupo : total) {
+
+            geral.registros += grupo.registros;
+            geral.soma_citacoes += grupo.soma_citacoes;
+            geral.max_citacoes = std::max(geral.max_citacoes, grupo.max_citacoes);
+
+        }
+
+        log_flush();
+
+        std::cout << std::setw(8) << "ano" << std::setw(14) << "registros" << std::setw(18) << "soma_citacoes"
+                  << std::setw(12) << "media" << std::setw(12) << "max" << "\n";
+
+        auto imprimir = [](const std::string& rotulo, const AgregadoAno& grupo) {
+
+            std::cout << std::setw(8) << rotulo << std::setw(14) << grupo.registros << std::setw(18) << grupo.soma_citacoes
+                      << std::setw(12) << std::fixed << std::setprecision(2)
+                      << (grupo.registros > 0 ? static_cast<double>(grupo.soma_citacoes) / grupo.registros : 0.0)
+                      << std::setw(12) << (grupo.registros > 0 ? std::to_string(grupo.max_citacoes) : std::string("-")) << "\n";
+
+        };
+
+        if (por_ano) {
+
+            for (size_t a = 0; a < NUM_ANOS_AGREGADOS; ++a) {
+
+                if (total[a].registros > 0) {
+
+                    imprimir(std::to_string(static_cast<long>(a) + INT16_MIN), total[a]);
+
+                }
+
+            }
+
+        }
+
+        imprimir("total", geral);
+
+    }
+
+    catch (const std::exception& e) {
+
+        log_error(e.what());
+
+        return 1;
+
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,216 @@
+// Módulos C++
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <chrono>
+#include <cstring>
+#include <cerrno>
+
+// Sistema
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "Artigo.hpp"
+#include "Parser.hpp"
+#include "ProtocoloConsultas.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * @brief Programa cliente: envia pedidos findrec/seek1/seek2 ao servidor de consultas.
+ *
+ * Com um comando na linha de argumentos, faz um único pedido. Sem comando, lê um pedido
+ * por linha da entrada padrão, todos pela mesma conexão. Para cada pedido imprime os
+ * registros no formato escolhido com --format (como nos programas de busca), os blocos
+ * lidos, a latência medida no servidor e a latência de ida e volta vista pelo cliente.
+ */
+
+// Envia um pedido, lê a resposta e imprime registros e estatísticas. Retorna 'false' se a conexão caiu.
+static bool executarPedido(ConexaoLinhas& conexao, const std::string& pedido, EscritorRegistros& saida) {
+
+    auto inicio = std::chrono::steady_clock::now();
+
+    std::string linha;
+
+    if (!conexao.enviar(pedido + "\n") || !conexao.lerLinha(linha)) {
+
+        log_error("Conexão encerrada pelo servidor.");
+
+        return false;
+
+    }
+
+    if (linha.compare(0, 5, "ERRO ") == 0) {
+
+        log_error(linha.substr(5));
+
+        return true;
+
+    }
+
+    std::istringstream cabecalho(linha);
+    std::string ok;
+    long registros = 0, blocos_indice = 0, blocos_dados = 0, latencia_servidor_us = 0;
+
+    if (!(cabecalho >> ok >> registros >> blocos_indice >> blocos_dados >> latencia_servidor_us) || ok != "OK") {
+
+        log_error("Resposta inválida do servidor: " + linha);
+
+        return false;
+
+    }
+
+    log_info("--- " + pedido + " ---");
+
+    for (long i = 0; i < registros; ++i) {
+
+        Artigo artigo;
+
+        if (!conexao.lerLinha(linha) || !artigoDeLinhaTSV(linha, artigo)) {
+
+            log_error("Registro inválido na resposta do servidor.");
+
+            return false;
+
+        }
+
+        saida.escreverArtigo(artigo);
+
+    }
+
+    // Um pedido por vez: os registros saem antes das estatísticas e do próximo pedido
+    saida.descarregar();
+
+    long latencia_total_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inicio).count();
+
+    log_info(std::to_string(registros) + " Registro(s) Encontrado(s)");
+    log_info("  - Blocos lidos (Índice): " + std::to_string(blocos_indice));
+    log_info("  - Blocos lidos (Dados): " + std::to_string(blocos_dados));
+    log_info("  - Latência no servidor: " + std::to_string(latencia_servidor_us) + " us");
+    log_info("  - Latência total (ida e volta): " + std::to_string(latencia_total_us) + " us");
+
+    return true;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada
+    //#################################################################
+
+    std::string caminho_socket = SOCKET_CONSULTAS_PADRAO;
+    std::string pedido;
+    FormatoSaida formato = FormatoSaida::TEXTO;
+
+    for (int i = 1; i < argc; ++i) {
+
+        const std::string arg = argv[i];
+
+        if (pedido.empty() && arg == "--socket" && i + 1 < argc) {
+
+            caminho_socket = argv[++i];
+
+            continue;
+
+        }
+
+        if (pedido.empty() && arg == "--format" && i + 1 < argc) {
+
+            if (!formatoSaidaDeString(argv[++i], formato)) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+                return 1;
+
+            }
+
+            continue;
+
+        }
+
+        // O restante da linha de argumentos forma o pedido ("seek2 Um Titulo")
+        pedido += (pedido.empty() ? "" : " ") + arg;
+
+    }
+
+    //#################################################################
+    // 2. Conexão
+    //#################################################################
+
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+    std::strncpy(endereco.sun_path, caminho_socket.c_str(), sizeof(endereco.sun_path) - 1);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd == -1 || connect(fd, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) == -1) {
+
+        log_error("Não foi possível conectar ao servidor em " + caminho_socket + " (" + std::strerror(errno) + ")");
+        log_error("Inicie o servidor primeiro: docker compose run --rm servidor");
+
+        if (fd != -1) {
+
+            close(fd);
+
+        }
+
+        return 1;
+
+    }
+
+    ConexaoLinhas conexao(fd);
+
+    if (formato != FormatoSaida::TEXTO) {
+
+        // Os registros vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
+    }
+
+    EscritorRegistros saida(formato);
+
+    //#################################################################
+    // 3. Pedidos
+    //#################################################################
+
+    bool conectado = true;
+
+    if (!pedido.empty()) {
+
+        conectado = executarPedido(conexao, pedido, saida);
+
+    }
+
+    else {
+
+        std::string linha;
+
+        while (conectado && std::getline(std::cin, linha)) {
+
+            if (!linha.empty()) {
+
+                conectado = executarPedido(conexao, linha, saida);
+
+            }
+
+        }
+
+    }
+
+    if (conectado) {
+
+        conexao.enviar("sair\n");
+
+    }
+
+    close(fd);
+
+    return conectado ? 0 : 1;
+
+}
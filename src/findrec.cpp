@@ -6,6 +6,8 @@
 #include <optional>
 #include <iomanip>
 #include <fstream>
+#include <vector>
+#include <cstdlib>
 
 // Nossos módulos
 #include "Log.hpp"
@@ -14,8 +16,12 @@
 #include "OSInfo.hpp"
 #include "BlocoDeDados.hpp"
 #include "config.hpp"
+#include "MetaDados.hpp"
 #include "GerenciadorArquivoDados.hpp"
 #include "ArquivoHashEstatico.hpp"
+#include "Consultas.hpp"
+#include "Lote.hpp"
+#include "SaidaRegistros.hpp"
 
 /**
  * @brief Programa findrec: Busca um registro pelo ID no arquivo de hash.
@@ -34,35 +40,136 @@ int main(int argc, char* argv[]) {
     // 1. Verificação de entrada
     //#################################################################
 
-    if (argc != 2) {
+    // Modo único: findrec <ID> [--format text|tsv|jsonl|binary]
+    // Modo lote:  findrec --batch [arquivo] [--format text|tsv|jsonl|binary] [--sem-agrupar | --intercalar G] (IDs um por linha; sem arquivo, lê da entrada padrão)
+    bool modo_lote = false;
+    bool agrupar_lote = true;
+    int largura_intercalada = 0;
+    std::string origem_lote = "-";
+    std::optional<FormatoSaida> formato_saida;
+    std::vector<std::string> chaves_lote;
+    std::vector<std::string> argumentos;
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg == "--batch") {
+
+            modo_lote = true;
+
+            if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+
+                origem_lote = argv[++i];
+
+            }
+
+        }
+
+        else if (arg == "--sem-agrupar") {
+
+            agrupar_lote = false;
+
+        }
+
+        else if (arg == "--intercalar" && i + 1 < argc) {
+
+            largura_intercalada = std::atoi(argv[++i]);
+
+            if (largura_intercalada <= 0) {
+
+                log_error("Número de sondagens inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+        }
+
+        else if (arg == "--format" && i + 1 < argc) {
+
+            FormatoSaida formato;
+
+            if (!formatoSaidaDeString(argv[++i], formato)) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+                return 1;
+
+            }
+
+            formato_saida = formato;
+
+        }
+
+        else {
+
+            argumentos.push_back(arg);
+
+        }
+
+    }
+
+    if (modo_lote ? !argumentos.empty() : argumentos.size() != 1) {
 
         log_error("Uso incorreto.");
-        log_error("Uso: " + std::string(argv[0]) + " <ID>");
+        log_error("Uso: " + std::string(argv[0]) + " <ID> [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --batch [arquivo] [--format text|tsv|jsonl|binary] [--sem-agrupar | --intercalar G]");
         log_error("Exemplo Docker: docker compose run --rm findrec 12345");
         return 1;
 
     }
 
-    int id_busca;
+    int id_busca = 0;
 
-    try {
+    // Padrão: blocos de texto para um registro, TSV para o lote
+    FormatoSaida formato = formato_saida.value_or(modo_lote ? FormatoSaida::TSV : FormatoSaida::TEXTO);
 
-        id_busca = std::stoi(argv[1]);
+    if (modo_lote || formato != FormatoSaida::TEXTO) {
 
-    } catch (const std::exception& e) {
+        // Os resultados vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
 
-        log_error("ID '" + std::string(argv[1]) + "' inválido. Deve ser um número inteiro.");
+    }
 
-        return 1;
+    EscritorRegistros saida(formato);
+
+    if (modo_lote) {
+
+        if (!lerChavesLote(origem_lote, chaves_lote)) {
+
+            log_error("Não foi possível abrir o arquivo de chaves: " + origem_lote);
+
+            return 1;
+
+        }
+
+        descartarIdsInvalidosLote(chaves_lote);
 
     }
 
-    if (id_busca <= 0) {
-        
-        log_error("ID '" + std::string(argv[1]) + "' inválido. O ID deve ser um número positivo maior que zero.");
-        
-        return 1;
-    
+    else {
+
+        try {
+
+            id_busca = std::stoi(argumentos[0]);
+
+        } catch (const std::exception& e) {
+
+            log_error("ID '" + argumentos[0] + "' inválido. Deve ser um número inteiro.");
+
+            return 1;
+
+        }
+
+        if (id_busca <= 0) {
+
+            log_error("ID '" + argumentos[0] + "' inválido. O ID deve ser um número positivo maior que zero.");
+
+            return 1;
+
+        }
+
     }
 
     //#################################################################
@@ -73,7 +180,18 @@ int main(int argc, char* argv[]) {
     const std::string diretorio_hash_dados = dataDir + "/artigos.dat";
 
     log_info("--- Iniciando Busca (findrec) ---");
-    log_info("Buscando ID: " + std::to_string(id_busca));
+    if (modo_lote) {
+
+        log_info("Buscando " + std::to_string(chaves_lote.size()) + " IDs em lote (" + (origem_lote == "-" ? std::string("entrada padrão") : origem_lote) + ")");
+
+    }
+
+    else {
+
+        log_info("Buscando ID: " + std::to_string(id_busca));
+
+    }
+
     log_info("Arquivo de Dados (Hash): " + diretorio_hash_dados);
     
     //#################################################################
@@ -81,14 +199,11 @@ int main(int argc, char* argv[]) {
     //#################################################################
 
     const std::string metaDir = dataDir + "/db.meta";
-    size_t TAMANHO_BLOCO_LOGICO_DADOS = 0;
-    size_t TAMANHO_BLOCO_BTREE = 0;
+    MetaDados meta;
 
-    std::ifstream meta_info(metaDir, std::ios::binary);
-    
-    if (!meta_info.is_open()) {
+    if (!lerMetaDados(metaDir, meta)) {
     
-        log_error("Falha fatal ao ler arquivo de metadados: " + metaDir);
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
     
         log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
 
@@ -96,26 +211,20 @@ int main(int argc, char* argv[]) {
     
     }
 
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_LOGICO_DADOS), sizeof(size_t));
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_BTREE), sizeof(size_t));
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+    const size_t TAMANHO_BLOCO_BTREE = meta.tamanho_bloco_btree;
 
-    meta_info.close();
+    LOG_DEBUG("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
+    LOG_DEBUG("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
 
-    if (TAMANHO_BLOCO_LOGICO_DADOS == 0 || TAMANHO_BLOCO_BTREE == 0) {
-        
-        log_error("Arquivo de metadados inválido ou corrompido: " + metaDir);
-    
-        return 1;
-    
-    }
-
-    log_debug("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
-    log_debug("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
-
-    std::optional<Artigo> resultado;
+    // Declarado fora do try: o resultado é uma visão do bucket mapeado e é impresso depois
+    std::optional<GerenciadorArquivoDados> dados;
+    std::optional<ArtigoView> resultado;
     long blocos_lidos = 0;
     size_t total_blocos_dados = 0;
     long duration_ms = 0;
+    EstatisticasLote estatisticas_lote;
+    double duracao_lote_s = 0.0;
 
     //#################################################################
     // 4. Execução da Busca
@@ -123,16 +232,45 @@ int main(int argc, char* argv[]) {
 
     try {
 
-        GerenciadorArquivoDados gerenciador_dados_hash(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
+        GerenciadorArquivoDados& gerenciador_dados_hash = dados.emplace(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
 
         ArquivoHashEstatico arquivo_hash(gerenciador_dados_hash, NUM_BUCKETS_PRIMARIOS);
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        resultado = arquivo_hash.buscar(id_busca);
+        if (modo_lote && largura_intercalada > 0) {
+
+            // Até G buscas em andamento, cada uma suspensa enquanto o seu bucket é lido
+            estatisticas_lote = processarLoteAgrupado(chaves_lote, saida, paraCadaSequencial, 1,
+                [&](const std::vector<std::string>& chaves) { return consultarPorHashIntercalado(arquivo_hash, idsDeChavesLote(chaves), largura_intercalada); });
+
+        }
+
+        else if (modo_lote && agrupar_lote) {
+
+            // Cada bloco do lote é ordenado por bucket e cada cadeia é percorrida uma vez
+            estatisticas_lote = processarLoteAgrupado(chaves_lote, saida, paraCadaSequencial, 1,
+                [&](const std::vector<std::string>& chaves) { return consultarPorHashLote(arquivo_hash, idsDeChavesLote(chaves)); });
+
+        }
+
+        else if (modo_lote) {
+
+            estatisticas_lote = processarLote(chaves_lote, saida,
+                paraCadaSequencial,
+                [&](const std::string& chave) { return consultarPorHash(arquivo_hash, std::stoi(chave)); });
+
+        }
+
+        else {
+
+            resultado = arquivo_hash.buscar(id_busca);
+
+        }
 
         auto endTime = std::chrono::high_resolution_clock::now();
         duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+        duracao_lote_s = std::chrono::duration<double>(endTime - startTime).count();
 
         blocos_lidos = gerenciador_dados_hash.obterBlocosLidos();
         total_blocos_dados = gerenciador_dados_hash.obterNumeroTotalBlocos();
@@ -151,10 +289,22 @@ int main(int argc, char* argv[]) {
     // 5. Relatório de Resultados
     //#################################################################
 
+    if (modo_lote) {
+
+        estatisticas_lote.relatar("findrec", duracao_lote_s);
+
+        log_info("Arquivo de Dados: " + diretorio_hash_dados);
+        log_info("  - Total de blocos (Dados): " + std::to_string(total_blocos_dados));
+
+        return 0;
+
+    }
+
     if (resultado) {
     
         log_info("--- Registro Encontrado ---");
-        printArtigo(resultado.value());
+        saida.escreverArtigo(resultado.value());
+        saida.descarregar();
     
     }
     
@@ -0,0 +1,252 @@
+// Módulos C++
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <chrono>
+#include <stdexcept>
+#include <type_traits>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "GeradorCSV.hpp"
+
+/**
+ * @brief Converte o valor de uma opção numérica; 'false' se não for um número completo.
+ */
+template <typename T>
+static bool lerNumero(const std::string& texto, T& valor) {
+
+    try {
+
+        size_t lidos = 0;
+
+        if constexpr (std::is_floating_point_v<T>) {
+
+            valor = static_cast<T>(std::stod(texto, &lidos));
+
+        }
+
+        else {
+
+            valor = static_cast<T>(std::stoll(texto, &lidos));
+
+        }
+
+        return lidos == texto.size();
+
+    }
+
+    catch (const std::exception&) {
+
+        return false;
+
+    }
+
+}
+
+// Linha de uso, registrada como erro (uso incorreto) ou como informação (--help).
+static void imprimirUso(const std::string& programa, void (*registrar)(const std::string&)) {
+
+    registrar("Uso: " + programa + " <arquivo_saida.csv|-> [--linhas N] [--seed S] [--ordem sequencial|embaralhada|agrupada] [--primeiro-id N] [--grupo G] [--lacuna L] [--titulos-distintos D] [--zipf s] [--malformadas taxa] [--ano-min A] [--ano-max B]");
+    registrar("Comando esperado: docker compose run --rm gerarcsv sintetico.csv --linhas 1000000");
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada.
+    //#################################################################
+
+    ConfiguracaoGerador config;
+
+    const std::string primeiro = (argc >= 2) ? argv[1] : "";
+
+    if (primeiro == "--help" || primeiro == "-h") {
+
+        imprimirUso(argv[0], log_info);
+        return 0;
+
+    }
+
+    // O nome do arquivo vem antes das opções: "--linhas" ali é uma opção fora do lugar
+    bool argumentos_validos = !primeiro.empty() && (primeiro == "-" || primeiro[0] != '-');
+
+    for (int i = 2; i < argc && argumentos_validos; ++i) {
+
+        std::string opcao = argv[i];
+
+        if (i + 1 >= argc) {
+
+            argumentos_validos = false;
+
+        }
+
+        else if (opcao == "--linhas") {
+
+            argumentos_validos = lerNumero(argv[++i], config.linhas);
+
+        }
+
+        else if (opcao == "--seed") {
+
+            argumentos_validos = lerNumero(argv[++i], config.semente);
+
+        }
+
+        else if (opcao == "--ordem") {
+
+            argumentos_validos = ordemIdsDeString(argv[++i], config.ordem);
+
+        }
+
+        else if (opcao == "--primeiro-id") {
+
+            argumentos_validos = lerNumero(argv[++i], config.primeiro_id);
+
+        }
+
+        else if (opcao == "--grupo") {
+
+            argumentos_validos = lerNumero(argv[++i], config.tamanho_grupo);
+
+        }
+
+        else if (opcao == "--lacuna") {
+
+            argumentos_validos = lerNumero(argv[++i], config.lacuna_media);
+
+        }
+
+        else if (opcao == "--titulos-distintos") {
+
+            argumentos_validos = lerNumero(argv[++i], config.titulos_distintos);
+
+        }
+
+        else if (opcao == "--zipf") {
+
+            argumentos_validos = lerNumero(argv[++i], config.expoente_zipf);
+
+        }
+
+        else if (opcao == "--malformadas") {
+
+            argumentos_validos = lerNumero(argv[++i], config.taxa_malformadas);
+
+        }
+
+        else if (opcao == "--ano-min") {
+
+            argumentos_validos = lerNumero(argv[++i], config.ano_minimo);
+
+        }
+
+        else if (opcao == "--ano-max") {
+
+            argumentos_validos = lerNumero(argv[++i], config.ano_maximo);
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (!argumentos_validos) {
+
+        log_error("Uso incorreto.");
+        imprimirUso(argv[0], log_error);
+        return 1;
+
+    }
+
+    //#################################################################
+    // 2. Saída: arquivo em /data (como o upload lê) ou stdout com "-".
+    //#################################################################
+
+    std::string nome_arquivo = argv[1];
+    bool para_stdout = (nome_arquivo == "-");
+    std::string caminho_saida = para_stdout ? "(stdout)" : "/data/" + nome_arquivo;
+
+    if (para_stdout) {
+
+        // O CSV vai para std::cout; o log não pode se misturar a ele
+        log_redirect_stderr();
+
+    }
+
+    std::ofstream arquivo;
+
+    if (!para_stdout) {
+
+        arquivo.open(caminho_saida, std::ios::out | std::ios::trunc);
+
+        if (!arquivo.is_open()) {
+
+            log_error("Nao foi possivel criar o arquivo de saida: " + caminho_saida);
+            return 1;
+
+        }
+
+    }
+
+    std::ostream& saida = para_stdout ? std::cout : arquivo;
+
+    //#################################################################
+    // 3. Geração.
+    //#################################################################
+
+    auto startTime = std::chrono::high_resolution_clock::now();
+
+    try {
+
+        GeradorCSV gerador(config);
+
+        log_info("--- Gerando CSV Sintetico ---");
+        log_info("Arquivo de saida: " + caminho_saida);
+        log_info("Linhas: " + std::to_string(config.linhas) + " | Semente: " + std::to_string(config.semente));
+
+        std::string linha;
+        size_t bytes = 0;
+
+        while (gerador.proximaLinha(linha)) {
+
+            saida << linha << '\n';
+            bytes += linha.size() + 1;
+
+        }
+
+        saida.flush();
+
+        if (!saida) {
+
+            log_error("Erro ao escrever em " + caminho_saida);
+            return 1;
+
+        }
+
+        std::chrono::duration<double> duracao = std::chrono::high_resolution_clock::now() - startTime;
+
+        log_info("--- Geracao concluida ---");
+        log_info("Linhas geradas: " + std::to_string(gerador.getLinhasGeradas()) + " (malformadas: " + std::to_string(gerador.getLinhasMalformadas()) + ")");
+        log_info("Bytes escritos: " + std::to_string(bytes));
+        log_info("Tempo total: " + std::to_string(duracao.count()) + " segundos");
+
+    }
+
+    catch (const std::exception& e) {
+
+        log_error("Falha na geracao: " + std::string(e.what()));
+        return 1;
+
+    }
+
+    return 0;
+
+}
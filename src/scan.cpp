@@ -0,0 +1,300 @@
+// Módulos C++
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <stdexcept>
+#include <cstring>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "Argumentos.hpp"
+#include "config.hpp"
+#include "MetaDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "ExecutorConsultas.hpp"
+#include "VarreduraTabela.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * @brief Programa scan: varredura completa de artigos.dat com filtros por ano, citações e
+ * trechos do título ou dos autores, para consultas que nenhum índice responde.
+ *
+ * Os buckets primários são divididos em partições de BUCKETS_POR_PARTICAO_VARREDURA; cada
+ * thread varre uma partição por vez, seguindo as cadeias de overflow dos seus primários
+ * (VarreduraTabela.hpp). As partições rodam em rodadas de PARTICOES_POR_THREAD_RODADA por
+ * thread e os resultados de cada rodada são escritos na ordem dos buckets antes da próxima,
+ * então a saída começa logo e a memória usada não cresce com o arquivo.
+ */
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada
+    //#################################################################
+
+    // scan [--ano A | --anos INI FIM] [--citacoes-min N] [--titulo-contem T] [--autores-contem T]
+    //      [--threads N] [--contar] [--fields lista] [--format text|tsv|jsonl|binary]
+    PredicadoVarredura predicado;
+    int num_threads = 1;
+    bool so_contar = false;
+    SelecaoCampos campos_saida;
+    FormatoSaida formato = FormatoSaida::TEXTO;
+
+    bool argumentos_validos = true;
+
+    for (int i = 1; i < argc && argumentos_validos; ++i) {
+
+        const std::string arg = argv[i];
+
+        if (arg == "--contar") {
+
+            so_contar = true;
+
+        }
+
+        else if (arg == "--anos" && i + 2 < argc) {
+
+            argumentos_validos = lerInteiroArgumento(argv[i + 1], "Ano", predicado.ano_min) && lerInteiroArgumento(argv[i + 2], "Ano", predicado.ano_max);
+            i += 2;
+
+        }
+
+        else if (i + 1 >= argc) {
+
+            argumentos_validos = false;
+
+        }
+
+        else if (arg == "--ano") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Ano", predicado.ano_min);
+            predicado.ano_max = predicado.ano_min;
+
+        }
+
+        else if (arg == "--citacoes-min") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Mínimo de citações", predicado.citacoes_min);
+
+        }
+
+        else if (arg == "--titulo-contem") {
+
+            predicado.titulo_contem = argv[++i];
+
+        }
+
+        else if (arg == "--autores-contem") {
+
+            predicado.autores_contem = argv[++i];
+
+        }
+
+        else if (arg == "--threads") {
+
+            argumentos_validos = lerInteiroArgumento(argv[++i], "Número de threads", num_threads) && num_threads > 0;
+
+        }
+
+        else if (arg == "--fields") {
+
+            argumentos_validos = selecaoCamposDeString(argv[++i], campos_saida);
+
+            if (!argumentos_validos) {
+
+                log_error("Lista de campos inválida: " + std::string(argv[i]));
+                log_error("Campos aceitos: id, titulo, ano, autores, citacoes, atualizacao, snippet");
+
+            }
+
+        }
+
+        else if (arg == "--format") {
+
+            argumentos_validos = formatoSaidaDeString(argv[++i], formato);
+
+            if (!argumentos_validos) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+            }
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (!argumentos_validos) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " [--ano A | --anos INI FIM] [--citacoes-min N] [--titulo-contem T] [--autores-contem T] [--threads N] [--contar] [--fields lista] [--format text|tsv|jsonl|binary]");
+        log_error("Exemplo Docker: docker compose run --rm scan --anos 2010 2015 --autores-contem \"Silva\" --threads 4");
+
+        return 1;
+
+    }
+
+    if (predicado.ano_max < predicado.ano_min) {
+
+        log_error("Faixa inválida: o ano final deve ser maior ou igual ao inicial.");
+
+        return 1;
+
+    }
+
+    if (!so_contar && formato != FormatoSaida::TEXTO) {
+
+        // Os registros vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
+    }
+
+    EscritorRegistros saida(formato, campos_saida);
+
+    //#################################################################
+    // 2. Definição dos caminhos e metadados
+    //#################################################################
+
+    const std::string dataDir = "/data/db";
+    const std::string metaDir = dataDir + "/db.meta";
+    const std::string diretorio_hash_dados = dataDir + "/artigos.dat";
+
+    MetaDados meta;
+
+    if (!lerMetaDados(metaDir, meta)) {
+
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
+        log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
+
+        return 1;
+
+    }
+
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+
+    log_info("--- Iniciando Varredura (scan) ---");
+    log_info("Arquivo de Dados (Hash): " + diretorio_hash_dados);
+    log_info("Threads: " + std::to_string(num_threads));
+
+    EstatisticasVarredura total;
+    long duration_ms = 0;
+    double segundos_varredura = 0.0;
+    long blocos_arquivo = 0;
+
+    //#################################################################
+    // 3. Varredura em rodadas de partições
+    //#################################################################
+
+    try {
+
+        GerenciadorArquivoDados dados(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
+        ExecutorConsultas executor(num_threads);
+
+        blocos_arquivo = static_cast<long>(dados.obterNumeroTotalBlocos());
+
+        const size_t num_primarios = std::min(static_cast<size_t>(NUM_BUCKETS_PRIMARIOS), dados.obterNumeroTotalBlocos());
+        const size_t num_particoes = (num_primarios + BUCKETS_POR_PARTICAO_VARREDURA - 1) / BUCKETS_POR_PARTICAO_VARREDURA;
+        const size_t particoes_por_rodada = static_cast<size_t>(num_threads) * PARTICOES_POR_THREAD_RODADA;
+
+        std::vector<std::vector<ArtigoView>> aceitos(particoes_por_rodada);
+        std::vector<EstatisticasVarredura> estatisticas(particoes_por_rodada);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        if (!so_contar) {
+
+            log_info("--- Registros Encontrados ---");
+            saida.escreverCabecalho();
+
+        }
+
+        for (size_t primeira = 0; primeira < num_particoes; primeira += particoes_por_rodada) {
+
+            const size_t nesta_rodada = std::min(particoes_por_rodada, num_particoes - primeira);
+
+            auto inicio_rodada = std::chrono::steady_clock::now();
+
+            executor.paraCada(nesta_rodada, [&](size_t p) {
+
+                size_t bucket_inicio = (primeira + p) * BUCKETS_POR_PARTICAO_VARREDURA;
+
+                aceitos[p].clear();
+                estatisticas[p] = EstatisticasVarredura();
+
+                varrerParticao(dados, predicado, bucket_inicio, std::min(num_primarios, bucket_inicio + BUCKETS_POR_PARTICAO_VARREDURA),
+                               so_contar ? nullptr : &aceitos[p], estatisticas[p]);
+
+            });
+
+            segundos_varredura += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio_rodada).count();
+
+            // Escreve a rodada na ordem dos buckets enquanto a próxima ainda não começou
+            for (size_t p = 0; p < nesta_rodada; ++p) {
+
+                total.somar(estatisticas[p]);
+
+                for (const ArtigoView& artigo : aceitos[p]) {
+
+                    saida.escreverArtigo(artigo);
+
+                }
+
+            }
+
+            saida.descarregar();
+
+        }
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro Fatal durante a varredura: " << e.what() << std::endl;
+
+        return 1;
+
+    }
+
+    //#################################################################
+    // 4. Relatório de Resultados e Estatísticas
+    //#################################################################
+
+    saida.descarregar();
+
+    const long blocos_lidos = total.buckets_primarios + total.blocos_overflow;
+    const double mb_lidos = blocos_lidos * static_cast<double>(TAMANHO_BLOCO_LOGICO_DADOS) / (1024.0 * 1024.0);
+
+    log_info("--- " + std::to_string(total.aceitos) + " Registro(s) Encontrado(s) ---");
+
+    log_info("\n--- Estatísticas da Operação (scan) ---");
+    log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+    log_info("Registros examinados: " + std::to_string(total.registros));
+
+    std::ostringstream banda;
+    banda << "Varredura: " << std::fixed << std::setprecision(1) << mb_lidos << " MB em " << std::setprecision(3)
+          << segundos_varredura * 1000.0 << " ms (" << std::setprecision(1)
+          << (segundos_varredura > 0 ? mb_lidos / segundos_varredura : 0.0) << " MB/s, sem a escrita dos resultados)";
+    log_info(banda.str());
+
+    log_info("Arquivo de Dados: " + diretorio_hash_dados);
+    log_info("  - Buckets primários lidos: " + std::to_string(total.buckets_primarios));
+    log_info("  - Blocos de overflow lidos: " + std::to_string(total.blocos_overflow));
+    log_info("  - Total de blocos (Dados): " + std::to_string(blocos_arquivo));
+
+    return 0;
+
+}
@@ -6,6 +6,9 @@
 #include <optional>
 #include <iomanip>
 #include <fstream>
+#include <vector>
+#include <cstdlib>
+#include <functional>
 
 // Nossos módulos
 #include "Log.hpp"
@@ -14,8 +17,15 @@
 #include "OSInfo.hpp"
 #include "BlocoDeDados.hpp"
 #include "config.hpp"
+#include "MetaDados.hpp"
 #include "GerenciadorArquivoDados.hpp"
 #include "ArvoreBMais.hpp"
+#include "ArvoreBMaisFixa.hpp"
+#include "VarreduraIndice.hpp"
+#include "Consultas.hpp"
+#include "ExecutorConsultas.hpp"
+#include "Lote.hpp"
+#include "SaidaRegistros.hpp"
 
 /**
  * @brief Programa seek1: Busca um registro pelo ID usando o Índice Primário B+Tree.
@@ -26,6 +36,35 @@
  * no arquivo de índice e a quantidade total de blocos do arquivo de índice primário"
  */
 
+// Converte o argumento para um ID positivo, registrando o erro caso seja inválido.
+static bool lerIdPositivo(const char* texto, int& id) {
+
+    try {
+    
+        id = std::stoi(texto);
+    
+    }
+    
+    catch (const std::exception& e) {
+        
+        log_error("ID '" + std::string(texto) + "' inválido. Deve ser um número inteiro.");
+        
+        return false;
+    
+    }
+
+    if (id <= 0) {
+        
+        log_error("ID '" + std::string(texto) + "' inválido. O ID deve ser um número positivo maior que zero.");
+        
+        return false;
+    
+    }
+
+    return true;
+
+}
+
 int main(int argc, char* argv[]) {
 
     log_init();
@@ -33,40 +72,193 @@ int main(int argc, char* argv[]) {
     //#################################################################
     // 1. Verificação de entrada
     //#################################################################
-    if (argc != 2) {
 
-        log_error("Uso incorreto.");
-        log_error("Uso: " + std::string(argv[0]) + " <ID>");
-        log_error("Exemplo Docker: docker compose run --rm seek1 12345");
+    // Modo faixa: seek1 --range <ID inicial> <ID final> [--format F]
+    // Modo lista: seek1 <ID> [<ID> ...] [--threads N] [--format F]
+    // Modo lote:  seek1 --batch [arquivo] [--format F] [--threads N] [--sem-agrupar | --intercalar G] (IDs um por linha)
+    // F: text (padrão fora do lote), tsv (padrão no lote), jsonl ou binary
+    bool modo_faixa = false;
+    int id_busca = 0;
+    int id_fim = 0;
+    int num_threads = 1;
+    std::vector<int> ids_busca;
+    bool modo_lote = false;
+    bool agrupar_lote = true;
+    int largura_intercalada = 0;
+    std::string origem_lote = "-";
+    std::optional<FormatoSaida> formato_saida;
+    std::vector<std::string> chaves_lote;
+
+    for (int i = 1; i < argc; ++i) {
+
+        if (std::string(argv[i]) == "--range" && i + 2 < argc) {
+
+            modo_faixa = true;
+
+            if (!lerIdPositivo(argv[i + 1], id_busca) || !lerIdPositivo(argv[i + 2], id_fim)) {
+
+                return 1;
+
+            }
+
+            if (id_fim < id_busca) {
+
+                log_error("Faixa inválida: o ID final deve ser maior ou igual ao inicial.");
+
+                return 1;
+
+            }
+
+            i += 2;
+
+            continue;
+
+        }
+
+        if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+
+            num_threads = std::atoi(argv[++i]);
+
+            if (num_threads <= 0) {
+
+                log_error("Número de threads inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+            continue;
+
+        }
+
+        if (std::string(argv[i]) == "--batch") {
+
+            modo_lote = true;
+
+            if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+
+                origem_lote = argv[++i];
+
+            }
+
+            continue;
+
+        }
+
+        if (std::string(argv[i]) == "--sem-agrupar") {
+
+            agrupar_lote = false;
+
+            continue;
+
+        }
+
+        if (std::string(argv[i]) == "--intercalar" && i + 1 < argc) {
+
+            largura_intercalada = std::atoi(argv[++i]);
+
+            if (largura_intercalada <= 0) {
+
+                log_error("Número de sondagens inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+            continue;
+
+        }
+
+        if (std::string(argv[i]) == "--format" && i + 1 < argc) {
+
+            FormatoSaida formato;
+
+            if (!formatoSaidaDeString(argv[++i], formato)) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+                return 1;
+
+            }
+
+            formato_saida = formato;
+
+            continue;
+
+        }
+
+        int id = 0;
+
+        if (!lerIdPositivo(argv[i], id)) {
+
+            return 1;
+
+        }
+
+        ids_busca.push_back(id);
 
-        return 1;
-    
     }
 
-    int id_busca;
-    
-    try {
-    
-        id_busca = std::stoi(argv[1]);
-    
+    // Padrão: blocos de texto para leitura humana, TSV para o lote
+    FormatoSaida formato = formato_saida.value_or(modo_lote ? FormatoSaida::TSV : FormatoSaida::TEXTO);
+
+    if (modo_lote || formato != FormatoSaida::TEXTO) {
+
+        // Os resultados vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
     }
-    
-    catch (const std::exception& e) {
-        
-        log_error("ID '" + std::string(argv[1]) + "' inválido. Deve ser um número inteiro.");
-        
+
+    EscritorRegistros saida(formato);
+
+    if (modo_faixa && (modo_lote || !ids_busca.empty())) {
+
+        log_error("Uso incorreto: --range não aceita IDs avulsos nem --batch.");
+
         return 1;
-    
+
     }
 
-    if (id_busca <= 0) {
-        
-        log_error("ID '" + std::string(argv[1]) + "' inválido. O ID deve ser um número positivo maior que zero.");
-        
+    if (modo_lote) {
+
+        if (!ids_busca.empty()) {
+
+            log_error("Uso incorreto: no modo --batch os IDs vêm do arquivo ou da entrada padrão.");
+
+            return 1;
+
+        }
+
+        if (!lerChavesLote(origem_lote, chaves_lote)) {
+
+            log_error("Não foi possível abrir o arquivo de chaves: " + origem_lote);
+
+            return 1;
+
+        }
+
+        descartarIdsInvalidosLote(chaves_lote);
+
+    }
+
+    else if (!modo_faixa && ids_busca.empty()) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " <ID> [<ID> ...] [--threads N] [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --range <ID inicial> <ID final> [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --batch [arquivo] [--format text|tsv|jsonl|binary] [--threads N] [--sem-agrupar | --intercalar G]");
+        log_error("Exemplo Docker: docker compose run --rm seek1 12345");
+
         return 1;
     
     }
 
+    if (!modo_faixa && !modo_lote) {
+
+        id_busca = ids_busca[0];
+
+    }
+
     //#################################################################
     // 2. Definição dos caminhos e início dos logs
     //#################################################################
@@ -76,7 +268,30 @@ int main(int argc, char* argv[]) {
     const std::string btreeIdPath = dataDir + "/btree_id.idx";
 
     log_info("--- Iniciando Busca (seek1) ---");
-    log_info("Buscando ID: " + std::to_string(id_busca));
+    if (modo_faixa) {
+
+        log_info("Buscando IDs na faixa: [" + std::to_string(id_busca) + ", " + std::to_string(id_fim) + "]");
+
+    }
+
+    else if (modo_lote) {
+
+        log_info("Buscando " + std::to_string(chaves_lote.size()) + " IDs em lote (" + (origem_lote == "-" ? std::string("entrada padrão") : origem_lote) + ") com " + std::to_string(num_threads) + " thread(s)");
+
+    }
+
+    else if (ids_busca.size() == 1) {
+
+        log_info("Buscando ID: " + std::to_string(id_busca));
+
+    }
+
+    else {
+
+        log_info("Buscando " + std::to_string(ids_busca.size()) + " IDs com " + std::to_string(num_threads) + " thread(s)");
+
+    }
+
     log_info("Usando Índice Primário (B+Tree): " + btreeIdPath);
     log_info("Lendo de Arquivo de Dados (Hash): " + diretorio_hash_dados);
 
@@ -85,14 +300,11 @@ int main(int argc, char* argv[]) {
     //#################################################################
 
     const std::string metaDir = dataDir + "/db.meta";
-    size_t TAMANHO_BLOCO_LOGICO_DADOS = 0;
-    size_t TAMANHO_BLOCO_BTREE = 0;
+    MetaDados meta;
 
-    std::ifstream meta_info(metaDir, std::ios::binary);
-    
-    if (!meta_info.is_open()) {
+    if (!lerMetaDados(metaDir, meta)) {
     
-        log_error("Falha fatal ao ler arquivo de metadados: " + metaDir);
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
     
         log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
 
@@ -100,26 +312,22 @@ int main(int argc, char* argv[]) {
     
     }
 
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_LOGICO_DADOS), sizeof(size_t));
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_BTREE), sizeof(size_t));
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+    const size_t TAMANHO_BLOCO_BTREE = meta.tamanho_bloco_btree;
 
-    meta_info.close();
+    LOG_DEBUG("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
+    LOG_DEBUG("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
 
-    if (TAMANHO_BLOCO_LOGICO_DADOS == 0 || TAMANHO_BLOCO_BTREE == 0) {
-        
-        log_error("Arquivo de metadados inválido ou corrompido: " + metaDir);
-    
-        return 1;
-    
-    }
-
-    log_debug("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
-    log_debug("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
-
-    std::optional<Artigo> resultado;
+    // Declarado fora do try: os resultados são visões dos buckets mapeados e são impressos depois
+    std::optional<GerenciadorArquivoDados> dados;
+    std::vector<ResultadoConsulta> resultados;
+    long registros_faixa = 0;
+    long blocos_lidos_dados = 0;
     long blocos_lidos_indice = 0;
     long total_blocos_indice = 0;
     long duration_ms = 0;
+    double duracao_s = 0.0;
+    EstatisticasLote estatisticas_lote;
 
     //#################################################################
     // 4. Execução da Busca
@@ -127,44 +335,91 @@ int main(int argc, char* argv[]) {
 
     try {
         
-        BPlusTree<int> btree_id(btreeIdPath, TAMANHO_BLOCO_BTREE);
+        GerenciadorArquivoDados& gerenciador_dados_hash = dados.emplace(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
 
-        GerenciadorArquivoDados gerenciador_dados_hash(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
-        
-        auto startTime = std::chrono::high_resolution_clock::now();
+        // Abre o índice com a variante de página fixa do tamanho de bloco gravado em db.meta
+        abrirArvoreLeitura<int>(btreeIdPath, TAMANHO_BLOCO_BTREE, [&](auto& btree_id) {
 
-        std::vector<long> ids_bucket = btree_id.search(id_busca);
+            LOG_DEBUG("Ordem do índice primário: " + std::to_string(btree_id.getOrdem()));
 
-        // 2. Se o índice encontrou a localização o bucket ID
-        if (!ids_bucket.empty()) {
-            
-            long id_bucket = ids_bucket[0];
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            if (modo_faixa) {
+
+                // Varre as folhas a partir do primeiro ID >= inicial, imprimindo os registros à medida que os lotes de buckets chegam
+                log_info("--- Registros na Faixa ---");
+
+                auto cursor = btree_id.lowerBound(id_busca, LEITURA_ANTECIPADA_FOLHAS);
+
+                blocos_lidos_dados = varrerFaixaEmLotes(cursor, gerenciador_dados_hash,
+                    [&](int chave) { return chave <= id_fim; },
+                    [&](int chave, BlocoDeDados* bucket) {
 
-            // 3. Busca o bucket no arquivo de DADOS
-            BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados_hash.getPonteiroBloco(id_bucket));
+                        for (size_t i = 0; i < bucket->contador_registros; ++i) {
 
-            // 4. Procura registro no bucket
-            for (size_t i = 0; i < bucket->contador_registros; ++i) {
+                            if (bucket->registros[i].id == chave) {
 
-                if (bucket->registros[i].id == id_busca) {
+                                saida.escreverArtigo(bucket->registros[i]);
+                                registros_faixa++;
 
-                    resultado = bucket->registros[i];
+                            }
 
-                    break;
+                        }
+
+                    },
+                    TAMANHO_LOTE_VARREDURA);
+
+            }
+
+            else if (modo_lote) {
+
+                ExecutorConsultas executor(num_threads);
+                auto paraCada = [&](size_t total, const std::function<void(size_t)>& f) { executor.paraCada(total, f); };
+
+                if (largura_intercalada > 0) {
+
+                    // Em cada fatia, até G descidas em andamento, cada uma suspensa enquanto o seu nó ou bucket é lido
+                    estatisticas_lote = processarLoteAgrupado(chaves_lote, saida, paraCada, num_threads,
+                        [&](const std::vector<std::string>& chaves) { return consultarPorIdIntercalado(btree_id, gerenciador_dados_hash, idsDeChavesLote(chaves), largura_intercalada); });
+
+                }
+
+                else if (agrupar_lote) {
+
+                    // Uma descida compartilhada por fatia do lote (uma fatia por thread)
+                    estatisticas_lote = processarLoteAgrupado(chaves_lote, saida, paraCada, num_threads,
+                        [&](const std::vector<std::string>& chaves) { return consultarPorIdLote(btree_id, gerenciador_dados_hash, idsDeChavesLote(chaves)); });
+
+                }
+
+                else {
+
+                    estatisticas_lote = processarLote(chaves_lote, saida, paraCada,
+                        [&](const std::string& chave) { return consultarPorId(btree_id, gerenciador_dados_hash, std::stoi(chave)); });
 
                 }
 
             }
 
-        }
-        
-        auto endTime = std::chrono::high_resolution_clock::now();
-        duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+            else {
 
-        // Coleta as estatísticas
-        
-        blocos_lidos_indice = btree_id.getIndexBlocosLidos();
-        total_blocos_indice = btree_id.getIndexTotalBlocos();
+                // Todas as consultas compartilham a mesma árvore e o mesmo mapeamento do arquivo de dados
+                ExecutorConsultas executor(num_threads);
+
+                resultados = executor.executar(ids_busca, [&](int id) { return consultarPorId(btree_id, gerenciador_dados_hash, id); });
+
+            }
+            
+            auto endTime = std::chrono::high_resolution_clock::now();
+            duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+            duracao_s = std::chrono::duration<double>(endTime - startTime).count();
+
+            // Coleta as estatísticas
+            
+            blocos_lidos_indice = btree_id.getIndexBlocosLidos();
+            total_blocos_indice = btree_id.getIndexTotalBlocos();
+
+        });
         
     }
     
@@ -180,26 +435,70 @@ int main(int argc, char* argv[]) {
     // 5. Relatório de Resultados e Estatísticas
     //#################################################################
 
-    if (resultado) {
+    if (modo_lote) {
+
+        estatisticas_lote.relatar("seek1", duracao_s);
+
+        log_info("Arquivo de Índice Primário: " + btreeIdPath);
+        log_info("  - Total de blocos (Índice): " + std::to_string(total_blocos_indice));
+
+        return 0;
+
+    }
+
+    if (modo_faixa) {
+
+        saida.descarregar();
+
+        log_info("--- " + std::to_string(registros_faixa) + " Registro(s) Encontrado(s) na faixa ---");
+
+    }
+
+    for (size_t i = 0; i < resultados.size(); ++i) {
+
+        // Com vários IDs, os blocos de cada consulta (o total do índice vem no relatório final)
+        const std::string blocos_consulta = (resultados.size() > 1) ? " (blocos lidos: " + std::to_string(resultados[i].blocos_indice) +
+            " de índice, " + std::to_string(resultados[i].blocos_dados) + " de dados)" : "";
+
+        if (!resultados[i].registros.empty()) {
     
-        log_info("--- Registro Encontrado ---");
+            log_info("--- Registro Encontrado ---" + blocos_consulta);
     
-        printArtigo(resultado.value());
+            saida.escreverArtigo(resultados[i].registros[0]);
+
+            // Antes da próxima mensagem do log, que pode estar na mesma saída (text)
+            saida.descarregar();
     
-    }
+        }
     
-    else {
+        else {
     
-        log_info("--- Registro com ID " + std::to_string(id_busca) + " não encontrado. ---");
+            log_info("--- Registro com ID " + std::to_string(ids_busca[i]) + " não encontrado. ---" + blocos_consulta);
     
+        }
+
     }
 
     log_info("\n--- Estatísticas da Operação (seek1) ---");
     log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+
+    if (resultados.size() > 1 && duracao_s > 0.0) {
+
+        log_info("Consultas: " + std::to_string(resultados.size()) + " (" + std::to_string(static_cast<long>(resultados.size() / duracao_s)) + " consultas/s com " + std::to_string(num_threads) + " thread(s))");
+
+    }
+
     log_info("Arquivo de Índice Primário: " + btreeIdPath);
     
     log_info("  - Blocos lidos (Índice): " + std::to_string(blocos_lidos_indice));
     log_info("  - Total de blocos (Índice): " + std::to_string(total_blocos_indice));
+
+    if (modo_faixa) {
+
+        log_info("Arquivo de Dados: " + diretorio_hash_dados);
+        log_info("  - Blocos lidos (Dados, sem repetição): " + std::to_string(blocos_lidos_dados));
+
+    }
     
     return 0;
 
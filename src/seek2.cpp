@@ -5,19 +5,25 @@
 #include <chrono>
 #include <optional>
 #include <vector>
+#include <cstdlib>
 #include <cstring>
-#include <set>
 #include <fstream>
+#include <functional>
 
 // Nossos módulos
 #include "Log.hpp"
 #include "Artigo.hpp"
-#include "Parser.hpp"
 #include "OSInfo.hpp"
 #include "BlocoDeDados.hpp"
 #include "config.hpp"
+#include "MetaDados.hpp"
 #include "GerenciadorArquivoDados.hpp"
-#include "ArvoreBMais.hpp"
+#include "IndiceTitulo.hpp"
+#include "VarreduraIndice.hpp"
+#include "Consultas.hpp"
+#include "ExecutorConsultas.hpp"
+#include "Lote.hpp"
+#include "SaidaRegistros.hpp"
 
 /**
  * @brief Programa seek2: Busca registros por Título usando o Índice Secundário B+Tree.
@@ -37,25 +43,159 @@ int main(int argc, char* argv[]) {
     // 1. Verificação de entrada
     //#################################################################
 
-    if (argc != 2) {
+    // Modo prefixo: seek2 --prefix "<Inicio do titulo>" [--fields lista] [--format F]
+    // Modo lista:   seek2 "<Titulo>" ["<Titulo>" ...] [--threads N] [--fields lista] [--format F]
+    // Modo lote:    seek2 --batch [arquivo] [--format F] [--threads N] [--fields lista] (títulos um por linha)
+    // F: text (padrão fora do lote), tsv (padrão no lote), jsonl ou binary
+    bool modo_prefixo = false;
+    bool modo_lote = false;
+    std::string origem_lote = "-";
+    std::optional<FormatoSaida> formato_saida;
+    int num_threads = 1;
+    SelecaoCampos campos_saida;
+    bool campos_informados = false;
+    std::vector<std::string> titulos_busca;
+
+    for (int i = 1; i < argc; ++i) {
+
+        std::string arg = argv[i];
+
+        if (arg == "--prefix" && i + 1 < argc) {
+
+            modo_prefixo = true;
+            titulos_busca.push_back(argv[++i]);
+
+        }
+
+        else if (arg == "--threads" && i + 1 < argc) {
+
+            num_threads = std::atoi(argv[++i]);
+
+            if (num_threads <= 0) {
+
+                log_error("Número de threads inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+        }
+
+        else if (arg == "--batch") {
+
+            modo_lote = true;
+
+            if (i + 1 < argc && std::string(argv[i + 1]).rfind("--", 0) != 0) {
+
+                origem_lote = argv[++i];
+
+            }
+
+        }
+
+        else if (arg == "--format" && i + 1 < argc) {
+
+            FormatoSaida formato;
+
+            if (!formatoSaidaDeString(argv[++i], formato)) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+                return 1;
+
+            }
+
+            formato_saida = formato;
+
+        }
+
+        else if (arg == "--fields" && i + 1 < argc) {
+
+            campos_informados = true;
+
+            if (!selecaoCamposDeString(argv[++i], campos_saida)) {
+
+                log_error("Lista de campos inválida: " + std::string(argv[i]) + " (use id,titulo,ano,autores,citacoes,atualizacao,snippet)");
+
+                return 1;
+
+            }
+
+        }
+
+        else {
+
+            titulos_busca.push_back(arg);
+
+        }
+
+    }
+
+    if ((modo_prefixo && titulos_busca.size() != 1) || (modo_lote && (modo_prefixo || !titulos_busca.empty()))) {
+
+        titulos_busca.clear();
+        modo_lote = false;
+
+    }
+
+    // Padrão: blocos de texto para leitura humana, TSV para o lote
+    FormatoSaida formato = formato_saida.value_or(modo_lote ? FormatoSaida::TSV : FormatoSaida::TEXTO);
+
+    if (modo_lote || formato != FormatoSaida::TEXTO) {
+
+        // Os resultados vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
+    }
+
+    EscritorRegistros saida(formato, campos_saida);
+
+    if (modo_lote) {
+
+        if (!lerChavesLote(origem_lote, titulos_busca)) {
+
+            log_error("Não foi possível abrir o arquivo de chaves: " + origem_lote);
+
+            return 1;
+
+        }
+
+        if (titulos_busca.empty()) {
+
+            log_error("Nenhum título no lote: " + origem_lote);
+
+            return 1;
+
+        }
+
+    }
+
+    if (titulos_busca.empty()) {
     
         log_error("Uso incorreto.");
-        log_error("Uso: " + std::string(argv[0]) + " \"<Titulo a ser buscado>\"");
+        log_error("Uso: " + std::string(argv[0]) + " \"<Titulo a ser buscado>\" [\"<Titulo>\" ...] [--threads N] [--fields id,ano,citacoes] [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --prefix \"<Inicio do titulo>\" [--fields id,ano,citacoes] [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --batch [arquivo] [--format text|tsv|jsonl|binary] [--threads N] [--fields id,ano,citacoes]");
         log_error("Exemplo Docker: docker compose run --rm seek2 \"Um Titulo Exato\"");
 
         return 1;
     
     }
 
-    const std::string titulo_busca = argv[1];
-    if (titulo_busca.length() > 299) {
+    for (const std::string& titulo : titulos_busca) {
 
-        log_error("Erro: Título muito longo. Máximo de 299 caracteres.");
+        if (titulo.length() > 299 && !modo_lote) {
+
+            log_error("Erro: Título muito longo. Máximo de 299 caracteres.");
         
-        return 1;
+            return 1;
     
+        }
+
     }
 
+    const std::string titulo_busca = titulos_busca[0];
+
     //#################################################################
     // 2. Definição dos caminhos e início dos logs
     //#################################################################
@@ -64,23 +204,40 @@ int main(int argc, char* argv[]) {
     const std::string btreeTituloPath = dataDir + "/btree_titulo.idx";
 
     log_info("--- Iniciando Busca (seek2) ---");
-    log_info("Buscando Título: \"" + titulo_busca + "\"");
+    if (modo_lote) {
+
+        log_info("Buscando " + std::to_string(titulos_busca.size()) + " Títulos em lote (" + (origem_lote == "-" ? std::string("entrada padrão") : origem_lote) + ") com " + std::to_string(num_threads) + " thread(s)");
+
+    }
+
+    else if (titulos_busca.size() > 1) {
+
+        log_info("Buscando " + std::to_string(titulos_busca.size()) + " Títulos com " + std::to_string(num_threads) + " thread(s)");
+
+    }
+
+    else {
+
+        log_info(std::string(modo_prefixo ? "Buscando Títulos com prefixo: \"" : "Buscando Título: \"") + titulo_busca + "\"");
+
+    }
     log_info("Usando Índice Secundário (B+Tree): " + btreeTituloPath);
-    log_info("Lendo de Arquivo de Dados (Hash): " + diretorio_hash_dados);
+    if (!campos_informados || !campos_saida.somenteCamposIndexados()) {
+
+        log_info("Lendo de Arquivo de Dados (Hash): " + diretorio_hash_dados);
+
+    }
 
     //#################################################################
     // 3. Configuração dos Gerenciadores
     //#################################################################
 
     const std::string metaDir = dataDir + "/db.meta";
-    size_t TAMANHO_BLOCO_LOGICO_DADOS = 0;
-    size_t TAMANHO_BLOCO_BTREE = 0;
+    MetaDados meta;
 
-    std::ifstream meta_info(metaDir, std::ios::binary);
+    if (!lerMetaDados(metaDir, meta)) {
     
-    if (!meta_info.is_open()) {
-    
-        log_error("Falha fatal ao ler arquivo de metadados: " + metaDir);
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
     
         log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
 
@@ -88,26 +245,23 @@ int main(int argc, char* argv[]) {
     
     }
 
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_LOGICO_DADOS), sizeof(size_t));
-    meta_info.read(reinterpret_cast<char*>(&TAMANHO_BLOCO_BTREE), sizeof(size_t));
-
-    meta_info.close();
-
-    if (TAMANHO_BLOCO_LOGICO_DADOS == 0 || TAMANHO_BLOCO_BTREE == 0) {
-        
-        log_error("Arquivo de metadados inválido ou corrompido: " + metaDir);
-    
-        return 1;
-    
-    }
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+    const size_t TAMANHO_BLOCO_BTREE = meta.tamanho_bloco_btree;
 
-    log_debug("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
-    log_debug("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
+    LOG_DEBUG("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
+    LOG_DEBUG("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
 
-    std::vector<Artigo> resultados;
+    // Declarado fora do try: os resultados são visões dos buckets mapeados e são impressos depois
+    std::optional<GerenciadorArquivoDados> dados;
+    std::vector<ResultadoConsulta> resultados;
+    long registros_prefixo = 0;
+    long blocos_lidos_dados = 0;
     long blocos_lidos_indice = 0;
     long total_blocos_indice = 0;
     long duration_ms = 0;
+    double duracao_s = 0.0;
+    bool somente_indice = false;
+    EstatisticasLote estatisticas_lote;
 
     //#################################################################
     // 4. Execução da Busca
@@ -115,43 +269,113 @@ int main(int argc, char* argv[]) {
 
     try {
         
-        BPlusTree<ChaveTitulo> btree_titulo(btreeTituloPath, TAMANHO_BLOCO_BTREE);
+        IndiceTitulo btree_titulo(btreeTituloPath, TAMANHO_BLOCO_BTREE, meta.modo_indice_titulo, meta.indice_titulo_cobertura);
 
-        GerenciadorArquivoDados gerenciador_dados_hash(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
-        
-        ChaveTitulo chave_busca;
-        strncpy(chave_busca.titulo, titulo_busca.c_str(), 300);
-        chave_busca.titulo[299] = '\0';
+        LOG_DEBUG("Modo do índice de títulos: " + modoIndiceTituloParaString(btree_titulo.getModo()));
+
+        // Campos cobertos pelo índice (id, titulo, ano, citacoes): artigos.dat nem é aberto
+        somente_indice = campos_informados && campos_saida.somenteCamposIndexados() && btree_titulo.temCamposIncluidos();
+
+        if (campos_informados && campos_saida.somenteCamposIndexados() && !somente_indice) {
+
+            log_info("O índice de títulos não tem campos incluídos (upload sem --indice-titulo-cobertura); lendo do arquivo de dados.");
+
+        }
+
+        if (!somente_indice) {
+
+            dados.emplace(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
+
+        }
 
         auto startTime = std::chrono::high_resolution_clock::now();
 
-        // 1. Busca no Índice B+Tree. Retorna um VETOR de IDs de bucket.
-        std::vector<long> ids_buckets_brutos = btree_titulo.search(chave_busca);
+        if (modo_prefixo && somente_indice) {
 
-        // 2. Remove duplicatas usando um std::set. (ex: [1, 1] vira {1})
-        std::set<long> ids_buckets_unicos(ids_buckets_brutos.begin(), ids_buckets_brutos.end());
+            log_info("--- Registros com o Prefixo ---");
 
-        // 2. Para cada bucket ID encontrado, busca no arquivo de dados
-        for (long id_bucket : ids_buckets_unicos) {
-            
-            BlocoDeDados* bucket = static_cast<BlocoDeDados*>(gerenciador_dados_hash.getPonteiroBloco(id_bucket));
+            BPlusTreeTitulo::Cursor cursor = btree_titulo.lowerBound(titulo_busca, LEITURA_ANTECIPADA_FOLHAS);
 
-            // 3. Varre o bucket para encontrar o(s) registro(s) com o título exato
-            for (size_t i = 0; i < bucket->contador_registros; ++i) {
+            for (; cursor.valido() && cursor.chave().compare(0, titulo_busca.size(), titulo_busca) == 0; cursor.next()) {
+
+                const std::string& titulo = cursor.chave();
+                ArtigoView artigo;
+
+                artigo.id = cursor.camposIncluidos().id;
+                artigo.ano = cursor.camposIncluidos().ano;
+                artigo.citacoes = cursor.camposIncluidos().citacoes;
+                artigo.titulo = titulo;
+
+                saida.escreverArtigo(artigo);
+                registros_prefixo++;
 
-                // Compara o título do registro com a busca
-                if (std::strcmp(bucket->registros[i].titulo, titulo_busca.c_str()) == 0) {
-                
-                    resultados.push_back(bucket->registros[i]);
-                
-                }
-            
             }
-        
+
+        }
+
+        else if (modo_prefixo) {
+
+            // Varre as folhas a partir do primeiro título >= prefixo, imprimindo os registros à medida que os lotes de buckets chegam
+            BPlusTreeTitulo::Cursor cursor = btree_titulo.lowerBound(titulo_busca, LEITURA_ANTECIPADA_FOLHAS);
+
+            log_info("--- Registros com o Prefixo ---");
+
+            blocos_lidos_dados = varrerFaixaEmLotes(cursor, *dados,
+                [&](const std::string& chave) { return chave.compare(0, titulo_busca.size(), titulo_busca) == 0; },
+                [&](const std::string& chave, BlocoDeDados* bucket) {
+
+                    for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+                        if (chave == bucket->registros[i].titulo) {
+
+                            saida.escreverArtigo(bucket->registros[i]);
+                            registros_prefixo++;
+
+                        }
+
+                    }
+
+                },
+                TAMANHO_LOTE_VARREDURA);
+
+        }
+
+        else if (modo_lote) {
+
+            ExecutorConsultas executor(num_threads);
+
+            estatisticas_lote = processarLote(titulos_busca, saida,
+                [&](size_t total, const std::function<void(size_t)>& f) { executor.paraCada(total, f); },
+                [&](const std::string& titulo) {
+
+                    return somente_indice ? consultarCamposPorTitulo(btree_titulo, titulo) : consultarPorTitulo(btree_titulo, *dados, titulo);
+
+                });
+
+        }
+
+        else {
+
+            // Todas as consultas compartilham o mesmo índice e o mesmo mapeamento do arquivo de dados
+            ExecutorConsultas executor(num_threads);
+
+            resultados = executor.executar(titulos_busca, [&](const std::string& titulo) {
+
+                return somente_indice ? consultarCamposPorTitulo(btree_titulo, titulo) : consultarPorTitulo(btree_titulo, *dados, titulo);
+
+            });
+
+            for (const ResultadoConsulta& resultado : resultados) {
+
+                blocos_lidos_dados += resultado.blocos_dados;
+
+            }
+
         }
         
         auto endTime = std::chrono::high_resolution_clock::now();
         duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+        duracao_s = std::chrono::duration<double>(endTime - startTime).count();
 
         // Estatísticas
         blocos_lidos_indice = btree_titulo.getIndexBlocosLidos();
@@ -171,30 +395,86 @@ int main(int argc, char* argv[]) {
     // 5. Relatório de Resultados e Estatísticas
     //#################################################################
 
-    if (!resultados.empty()) {
+    if (modo_lote) {
+
+        estatisticas_lote.relatar("seek2", duracao_s);
+
+        log_info("Arquivo de Índice Secundário: " + btreeTituloPath);
+        log_info("  - Total de blocos (Índice): " + std::to_string(total_blocos_indice));
+
+        if (somente_indice) {
+
+            log_info("Arquivo de Dados: não acessado (consulta respondida pelo índice de cobertura)");
+
+        }
+
+        return 0;
+
+    }
+
+    if (modo_prefixo) {
+
+        saida.descarregar();
+
+        log_info("--- " + std::to_string(registros_prefixo) + " Registro(s) Encontrado(s) com o prefixo ---");
+
+    }
+
+    for (size_t i = 0; i < resultados.size(); ++i) {
+
+        // Com vários títulos, os blocos de cada consulta (o total do índice vem no relatório final)
+        const std::string blocos_consulta = (resultados.size() > 1) ? " (blocos lidos: " + std::to_string(resultados[i].blocos_indice) +
+            " de índice, " + std::to_string(resultados[i].blocos_dados) + " de dados)" : "";
+
+        if (!resultados[i].registros.empty()) {
     
-        log_info("--- " + std::to_string(resultados.size()) + " Registro(s) Encontrado(s) ---");
+            log_info("--- " + std::to_string(resultados[i].registros.size()) + " Registro(s) Encontrado(s) ---" + blocos_consulta);
     
-        for (const auto& artigo : resultados) {
+            for (const auto& artigo : resultados[i].registros) {
     
-            printArtigo(artigo);
+                saida.escreverArtigo(artigo);
     
-        }
+            }
+
+            // Antes da próxima mensagem do log, que pode estar na mesma saída (text)
+            saida.descarregar();
     
-    }
+        }
     
-    else {
+        else {
     
-        log_info("--- Nenhum registro com o Título \"" + titulo_busca + "\" foi encontrado. ---");
+            log_info("--- Nenhum registro com o Título \"" + titulos_busca[i] + "\" foi encontrado. ---" + blocos_consulta);
     
+        }
+
     }
 
     log_info("\n--- Estatísticas da Operação (seek2) ---");
     log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+
+    if (resultados.size() > 1 && duracao_s > 0.0) {
+
+        log_info("Consultas: " + std::to_string(resultados.size()) + " (" + std::to_string(static_cast<long>(resultados.size() / duracao_s)) + " consultas/s com " + std::to_string(num_threads) + " thread(s))");
+
+    }
+
     log_info("Arquivo de Índice Secundário: " + btreeTituloPath);
     log_info("  - Blocos lidos (Índice): " + std::to_string(blocos_lidos_indice));
     log_info("  - Total de blocos (Índice): " + std::to_string(total_blocos_indice));
 
+    if (somente_indice) {
+
+        log_info("Arquivo de Dados: não acessado (consulta respondida pelo índice de cobertura)");
+
+    }
+
+    else {
+
+        log_info("Arquivo de Dados: " + diretorio_hash_dados);
+        log_info("  - Blocos lidos (Dados" + std::string(modo_prefixo ? ", sem repetição" : "") + "): " + std::to_string(blocos_lidos_dados));
+
+    }
+
     return 0;
 
 }
\ No newline at end of file
@@ -0,0 +1,471 @@
+// Módulos C++
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <queue>
+#include <cstring>
+#include <cstdlib>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "Argumentos.hpp"
+#include "Artigo.hpp"
+#include "OSInfo.hpp"
+#include "BlocoDeDados.hpp"
+#include "config.hpp"
+#include "MetaDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisFixa.hpp"
+#include "VarreduraIndice.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * @brief Programa seekano: Busca artigos por ano (ou faixa de anos) usando o índice (ano, citacoes DESC, id).
+ *
+ * Dentro de cada ano as chaves estão em ordem decrescente de citações, então:
+ *  - "seekano <ano>" e "seekano --range <ini> <fim>" varrem só as folhas da faixa;
+ *  - "--top K" de um único ano lê apenas as K primeiras chaves do ano;
+ *  - "--top K" de uma faixa intercala um cursor por ano (K-way merge por citações).
+ * Com "--fields" restrito a id, ano e citacoes a resposta sai só do índice e artigos.dat não é aberto.
+ */
+
+// Entrada do índice escolhida para a saída: a chave já traz id, ano e citacoes.
+struct EntradaAno {
+
+    ChaveAnoCitacoes chave;
+    long bucket;
+
+};
+
+// Seleciona as K chaves com mais citações em [ano_ini, ano_fim].
+// Cada ano com registros recebe um cursor na sua primeira chave; anos vazios são pulados
+// porque o lowerBound de um ano vazio já cai na primeira chave do próximo ano existente.
+template <typename Arvore>
+static std::vector<EntradaAno> selecionarTopK(Arvore& arvore, int ano_ini, int ano_fim, long k) {
+
+    using Cursor = typename Arvore::Cursor;
+
+    std::vector<Cursor> cursores;
+    long ano = ano_ini;
+
+    while (ano <= ano_fim) {
+
+        Cursor cursor = arvore.lowerBound(ChaveAnoCitacoes::inicioDoAno(static_cast<int32_t>(ano)));
+
+        if (!cursor.valido() || cursor.chave().ano > ano_fim) {
+
+            break;
+
+        }
+
+        ano = static_cast<long>(cursor.chave().ano) + 1;
+        cursores.push_back(cursor);
+
+        // Um único ano: as K primeiras chaves já são a resposta, sem intercalação
+        if (ano_ini == ano_fim) {
+
+            break;
+
+        }
+
+    }
+
+    // Heap de máximo por citações; empate pelo menor id, como na ordem da chave
+    auto menorPrioridade = [&](size_t a, size_t b) {
+
+        const ChaveAnoCitacoes& ca = cursores[a].chave();
+        const ChaveAnoCitacoes& cb = cursores[b].chave();
+
+        if (ca.citacoes != cb.citacoes) return ca.citacoes < cb.citacoes;
+
+        return ca.id > cb.id;
+
+    };
+
+    std::priority_queue<size_t, std::vector<size_t>, decltype(menorPrioridade)> heap(menorPrioridade);
+
+    for (size_t i = 0; i < cursores.size(); ++i) {
+
+        heap.push(i);
+
+    }
+
+    std::vector<EntradaAno> selecionadas;
+
+    while (!heap.empty() && static_cast<long>(selecionadas.size()) < k) {
+
+        size_t i = heap.top();
+        heap.pop();
+
+        const int32_t ano_cursor = cursores[i].chave().ano;
+        selecionadas.push_back({cursores[i].chave(), cursores[i].apontador()});
+
+        cursores[i].next();
+
+        if (cursores[i].valido() && cursores[i].chave().ano == ano_cursor) {
+
+            heap.push(i);
+
+        }
+
+    }
+
+    return selecionadas;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada
+    //#################################################################
+
+    // Modo ano:   seekano <ano> [--top K] [--fields lista] [--format text|tsv|jsonl|binary]
+    // Modo faixa: seekano --range <ano inicial> <ano final> [--top K] [--fields lista] [--format text|tsv|jsonl|binary]
+    int ano_ini = 0;
+    int ano_fim = 0;
+    int top_k = 0;
+    bool ano_informado = false;
+    bool campos_informados = false;
+    SelecaoCampos campos_saida;
+    FormatoSaida formato = FormatoSaida::TEXTO;
+
+    for (int i = 1; i < argc; ++i) {
+
+        const std::string arg = argv[i];
+
+        if (arg == "--range" && i + 2 < argc && !ano_informado) {
+
+            if (!lerInteiroArgumento(argv[i + 1], "Ano", ano_ini) || !lerInteiroArgumento(argv[i + 2], "Ano", ano_fim)) {
+
+                return 1;
+
+            }
+
+            i += 2;
+            ano_informado = true;
+
+        }
+
+        else if (arg == "--top" && i + 1 < argc) {
+
+            if (!lerInteiroArgumento(argv[++i], "K", top_k) || top_k <= 0) {
+
+                log_error("O valor de --top deve ser um inteiro positivo.");
+
+                return 1;
+
+            }
+
+        }
+
+        else if (arg == "--fields" && i + 1 < argc) {
+
+            if (!selecaoCamposDeString(argv[++i], campos_saida)) {
+
+                log_error("Lista de campos inválida: " + std::string(argv[i]));
+                log_error("Campos aceitos: id, titulo, ano, autores, citacoes, atualizacao, snippet");
+
+                return 1;
+
+            }
+
+            campos_informados = true;
+
+        }
+
+        else if (arg == "--format" && i + 1 < argc) {
+
+            if (!formatoSaidaDeString(argv[++i], formato)) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+                return 1;
+
+            }
+
+        }
+
+        else if (!ano_informado && arg.rfind("--", 0) != 0) {
+
+            if (!lerInteiroArgumento(argv[i], "Ano", ano_ini)) {
+
+                return 1;
+
+            }
+
+            ano_fim = ano_ini;
+            ano_informado = true;
+
+        }
+
+        else {
+
+            ano_informado = false;
+
+            break;
+
+        }
+
+    }
+
+    if (!ano_informado) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " <ano> [--top K] [--fields lista] [--format text|tsv|jsonl|binary]");
+        log_error("     " + std::string(argv[0]) + " --range <ano inicial> <ano final> [--top K] [--fields lista] [--format text|tsv|jsonl|binary]");
+        log_error("Exemplo Docker: docker compose run --rm seekano 2015 --top 10");
+
+        return 1;
+
+    }
+
+    if (ano_fim < ano_ini) {
+
+        log_error("Faixa inválida: o ano final deve ser maior ou igual ao inicial.");
+
+        return 1;
+
+    }
+
+    if (formato != FormatoSaida::TEXTO) {
+
+        // Os registros vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
+    }
+
+    EscritorRegistros saida(formato, campos_saida);
+
+    // A chave do índice já traz id, ano e citacoes
+    const bool somente_indice = campos_informados && !campos_saida.titulo && campos_saida.somenteCamposIndexados();
+
+    //#################################################################
+    // 2. Definição dos caminhos e início dos logs
+    //#################################################################
+
+    const std::string dataDir = "/data/db";
+    const std::string diretorio_hash_dados = dataDir + "/artigos.dat";
+    const std::string btreeAnoPath = dataDir + "/btree_ano.idx";
+
+    log_info("--- Iniciando Busca (seekano) ---");
+
+    if (ano_ini == ano_fim) {
+
+        log_info("Buscando ano: " + std::to_string(ano_ini));
+
+    }
+
+    else {
+
+        log_info("Buscando anos na faixa: [" + std::to_string(ano_ini) + ", " + std::to_string(ano_fim) + "]");
+
+    }
+
+    if (top_k > 0) {
+
+        log_info("Limitando aos " + std::to_string(top_k) + " artigo(s) mais citado(s)");
+
+    }
+
+    log_info("Usando Índice por Ano (B+Tree): " + btreeAnoPath);
+
+    if (!somente_indice) {
+
+        log_info("Lendo de Arquivo de Dados (Hash): " + diretorio_hash_dados);
+
+    }
+
+    //#################################################################
+    // 3. Configuração dos Gerenciadores
+    //#################################################################
+
+    const std::string metaDir = dataDir + "/db.meta";
+    MetaDados meta;
+
+    if (!lerMetaDados(metaDir, meta)) {
+
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
+
+        log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
+
+        return 1;
+
+    }
+
+    if (!meta.indice_ano) {
+
+        log_error("O banco não tem índice por ano. Refaça o upload com --indice-ano.");
+
+        return 1;
+
+    }
+
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+    const size_t TAMANHO_BLOCO_BTREE = meta.tamanho_bloco_btree;
+
+    LOG_DEBUG("Tamanho do Bloco de Dados lido de .meta: " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS));
+    LOG_DEBUG("Tamanho do Bloco de Índice lido de .meta: " + std::to_string(TAMANHO_BLOCO_BTREE));
+
+    long registros_encontrados = 0;
+    long blocos_lidos_dados = 0;
+    long blocos_lidos_indice = 0;
+    long total_blocos_indice = 0;
+    long duration_ms = 0;
+
+    //#################################################################
+    // 4. Execução da Busca
+    //#################################################################
+
+    try {
+
+        std::optional<GerenciadorArquivoDados> dados;
+
+        if (!somente_indice) {
+
+            dados.emplace(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
+
+        }
+
+        // Escreve o registro da chave, lido do bucket ou montado só com os campos da chave
+        auto imprimir = [&](const ChaveAnoCitacoes& chave, BlocoDeDados* bucket) {
+
+            if (bucket == nullptr) {
+
+                ArtigoView artigo;
+
+                artigo.id = chave.id;
+                artigo.ano = chave.ano;
+                artigo.citacoes = chave.citacoes;
+
+                saida.escreverArtigo(artigo);
+                registros_encontrados++;
+
+                return;
+
+            }
+
+            for (size_t i = 0; i < bucket->contador_registros; ++i) {
+
+                if (bucket->registros[i].id == chave.id) {
+
+                    saida.escreverArtigo(bucket->registros[i]);
+                    registros_encontrados++;
+
+                }
+
+            }
+
+        };
+
+        abrirArvoreLeitura<ChaveAnoCitacoes>(btreeAnoPath, TAMANHO_BLOCO_BTREE, [&](auto& btree_ano) {
+
+            LOG_DEBUG("Ordem do índice por ano: " + std::to_string(btree_ano.getOrdem()));
+
+            auto startTime = std::chrono::high_resolution_clock::now();
+
+            log_info("--- Registros Encontrados ---");
+
+            if (top_k > 0) {
+
+                std::vector<EntradaAno> selecionadas = selecionarTopK(btree_ano, ano_ini, ano_fim, top_k);
+
+                for (const EntradaAno& entrada : selecionadas) {
+
+                    BlocoDeDados* bucket = nullptr;
+
+                    if (dados) {
+
+                        bucket = static_cast<BlocoDeDados*>(dados->getPonteiroBloco(entrada.bucket));
+                        blocos_lidos_dados++;
+
+                    }
+
+                    imprimir(entrada.chave, bucket);
+
+                }
+
+            }
+
+            else {
+
+                // Varre só as folhas da faixa de anos
+                auto cursor = btree_ano.lowerBound(ChaveAnoCitacoes::inicioDoAno(ano_ini), LEITURA_ANTECIPADA_FOLHAS);
+                auto dentroDaFaixa = [&](const ChaveAnoCitacoes& chave) { return chave.ano <= ano_fim; };
+
+                if (dados) {
+
+                    blocos_lidos_dados = varrerFaixaEmLotes(cursor, *dados, dentroDaFaixa, imprimir, TAMANHO_LOTE_VARREDURA);
+
+                }
+
+                else {
+
+                    for (; cursor.valido() && dentroDaFaixa(cursor.chave()); cursor.next()) {
+
+                        imprimir(cursor.chave(), nullptr);
+
+                    }
+
+                }
+
+            }
+
+            auto endTime = std::chrono::high_resolution_clock::now();
+            duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+            // Coleta as estatísticas
+
+            blocos_lidos_indice = btree_ano.getIndexBlocosLidos();
+            total_blocos_indice = btree_ano.getIndexTotalBlocos();
+
+        });
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro Fatal durante a busca: " << e.what() << std::endl;
+
+        return 1;
+
+    }
+
+    //#################################################################
+    // 5. Relatório de Resultados e Estatísticas
+    //#################################################################
+
+    saida.descarregar();
+
+    log_info("--- " + std::to_string(registros_encontrados) + " Registro(s) Encontrado(s) ---");
+
+    log_info("\n--- Estatísticas da Operação (seekano) ---");
+    log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+
+    log_info("Arquivo de Índice por Ano: " + btreeAnoPath);
+
+    log_info("  - Blocos lidos (Índice): " + std::to_string(blocos_lidos_indice));
+    log_info("  - Total de blocos (Índice): " + std::to_string(total_blocos_indice));
+
+    if (somente_indice) {
+
+        log_info("Arquivo de Dados: não acessado (campos respondidos pelo índice)");
+
+    }
+
+    else {
+
+        log_info("Arquivo de Dados: " + diretorio_hash_dados);
+        log_info("  - Blocos lidos (Dados): " + std::to_string(blocos_lidos_dados));
+
+    }
+
+    return 0;
+
+}
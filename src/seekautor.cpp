@@ -0,0 +1,248 @@
+// Módulos C++
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <stdexcept>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "MetaDados.hpp"
+#include "BlocoDeDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "IndiceAutores.hpp"
+#include "SaidaRegistros.hpp"
+
+/**
+ * @brief Programa seekautor: Busca os artigos de um autor pelo índice invertido autores.idx.
+ *
+ * Com um nome, escreve todos os registros do autor; com dois ou mais, só os registros em
+ * que todos aparecem juntos (coautoria), pela interseção das listas (IndiceAutores::intersectar).
+ * As listas estão em ordem de local, então os buckets de artigos.dat são lidos em ordem crescente.
+ */
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada
+    //#################################################################
+
+    // seekautor "<Autor>" ["<Autor>" ...] [--contar] [--fields lista] [--format text|tsv|jsonl|binary]
+    std::vector<std::string> nomes;
+    bool so_contar = false;
+    SelecaoCampos campos_saida;
+    FormatoSaida formato = FormatoSaida::TEXTO;
+
+    bool argumentos_validos = true;
+
+    for (int i = 1; i < argc && argumentos_validos; ++i) {
+
+        const std::string arg = argv[i];
+
+        if (arg == "--contar") {
+
+            so_contar = true;
+
+        }
+
+        else if (arg == "--fields" && i + 1 < argc) {
+
+            argumentos_validos = selecaoCamposDeString(argv[++i], campos_saida);
+
+            if (!argumentos_validos) {
+
+                log_error("Lista de campos inválida: " + std::string(argv[i]));
+                log_error("Campos aceitos: id, titulo, ano, autores, citacoes, atualizacao, snippet");
+
+            }
+
+        }
+
+        else if (arg == "--format" && i + 1 < argc) {
+
+            argumentos_validos = formatoSaidaDeString(argv[++i], formato);
+
+            if (!argumentos_validos) {
+
+                log_error("Formato inválido: " + std::string(argv[i]) + " (use text, tsv, jsonl ou binary)");
+
+            }
+
+        }
+
+        else if (arg.rfind("--", 0) != 0) {
+
+            nomes.push_back(arg);
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (!argumentos_validos || nomes.empty()) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " \"<Autor>\" [\"<Autor>\" ...] [--contar] [--fields lista] [--format text|tsv|jsonl|binary]");
+        log_error("Exemplo Docker: docker compose run --rm seekautor \"Erik Cambria\" \"Daniel Olsher\"");
+
+        return 1;
+
+    }
+
+    if (!so_contar && formato != FormatoSaida::TEXTO) {
+
+        // Os registros vão para a saída padrão; o log passa para a saída de erro
+        log_redirect_stderr();
+
+    }
+
+    EscritorRegistros saida(formato, campos_saida);
+
+    //#################################################################
+    // 2. Definição dos caminhos e metadados
+    //#################################################################
+
+    const std::string dataDir = "/data/db";
+    const std::string metaDir = dataDir + "/db.meta";
+    const std::string diretorio_hash_dados = dataDir + "/artigos.dat";
+    const std::string autoresPath = dataDir + "/autores.idx";
+
+    MetaDados meta;
+
+    if (!lerMetaDados(metaDir, meta)) {
+
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
+        log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
+
+        return 1;
+
+    }
+
+    if (!meta.indice_autores) {
+
+        log_error("O banco não tem índice de autores. Refaça o upload com --indice-autores.");
+
+        return 1;
+
+    }
+
+    log_info("--- Iniciando Busca (seekautor) ---");
+
+    for (const std::string& nome : nomes) {
+
+        log_info("Buscando autor: " + nome);
+
+    }
+
+    log_info("Usando Índice de Autores: " + autoresPath);
+
+    long registros_encontrados = 0;
+    long blocos_lidos_dados = 0;
+    long blocos_decodificados = 0;
+    uint64_t bytes_listas = 0;
+    long duration_ms = 0;
+
+    //#################################################################
+    // 3. Execução da Busca
+    //#################################################################
+
+    try {
+
+        IndiceAutores indice(autoresPath);
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        std::vector<uint32_t> ids_autores;
+
+        for (const std::string& nome : nomes) {
+
+            uint32_t id_autor = 0;
+
+            if (!indice.buscar(nome, id_autor)) {
+
+                log_info("Autor não encontrado: " + nome);
+
+                ids_autores.clear();
+
+                break;
+
+            }
+
+            log_info("  - " + nome + ": autor " + std::to_string(id_autor) + ", " + std::to_string(indice.numeroRegistros(id_autor)) +
+                     " registro(s), lista de " + std::to_string(indice.bytesLista(id_autor)) + " bytes");
+
+            ids_autores.push_back(id_autor);
+            bytes_listas += indice.bytesLista(id_autor);
+
+        }
+
+        std::vector<uint64_t> locais = indice.intersectar(ids_autores, &blocos_decodificados);
+
+        if (!so_contar && !locais.empty()) {
+
+            GerenciadorArquivoDados dados(diretorio_hash_dados, meta.tamanho_bloco_dados);
+
+            log_info("--- Registros Encontrados ---");
+            saida.escreverCabecalho();
+
+            for (uint64_t local : locais) {
+
+                const BlocoDeDados* bucket = static_cast<const BlocoDeDados*>(dados.getPonteiroBloco(bucketDoLocal(local)));
+
+                if (posicaoDoLocal(local) < bucket->contador_registros) {
+
+                    saida.escreverArtigo(bucket->registros[posicaoDoLocal(local)]);
+
+                }
+
+            }
+
+            saida.descarregar();
+
+            blocos_lidos_dados = dados.obterBlocosLidos();
+
+        }
+
+        registros_encontrados = static_cast<long>(locais.size());
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro Fatal durante a busca: " << e.what() << std::endl;
+
+        return 1;
+
+    }
+
+    //#################################################################
+    // 4. Relatório de Resultados e Estatísticas
+    //#################################################################
+
+    saida.descarregar();
+
+    log_info("--- " + std::to_string(registros_encontrados) + " Registro(s) Encontrado(s) ---");
+
+    log_info("\n--- Estatísticas da Operação (seekautor) ---");
+    log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+
+    log_info("Arquivo de Índice de Autores: " + autoresPath);
+    log_info("  - Bytes das listas consultadas: " + std::to_string(bytes_listas));
+    log_info("  - Blocos de " + std::to_string(POSTAGENS_POR_SALTO) + " postagens decodificados: " + std::to_string(blocos_decodificados));
+
+    log_info("Arquivo de Dados: " + diretorio_hash_dados);
+    log_info("  - Blocos lidos (Dados): " + std::to_string(blocos_lidos_dados));
+
+    return 0;
+
+}
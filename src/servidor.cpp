@@ -0,0 +1,528 @@
+// Módulos C++
+#include <iostream>
+#include <string>
+#include <stdexcept>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <set>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+
+// Sistema
+#include <unistd.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "Artigo.hpp"
+#include "config.hpp"
+#include "MetaDados.hpp"
+#include "GerenciadorArquivoDados.hpp"
+#include "ArquivoHashEstatico.hpp"
+#include "ArvoreBMais.hpp"
+#include "ArvoreBMaisFixa.hpp"
+#include "IndiceTitulo.hpp"
+#include "Consultas.hpp"
+#include "ProtocoloConsultas.hpp"
+
+/**
+ * @brief Programa servidor: mantém o banco aberto e atende findrec/seek1/seek2 por um socket Unix.
+ *
+ * Cada processo findrec/seek1/seek2 lê db.meta, mapeia artigos.dat e abre os índices
+ * para uma única busca. O servidor faz isso uma vez: artigos.dat continua mapeado, os
+ * nós internos dos primeiros níveis das árvores ficam fixados em memória e cada conexão
+ * é atendida por uma thread usando os caminhos de leitura thread-safe de Consultas, com
+ * no máximo --max-conexoes threads; além disso, novas conexões esperam na fila do listen.
+ * O protocolo está descrito em ProtocoloConsultas.hpp; o cliente é o programa 'cliente'.
+ */
+
+static volatile std::sig_atomic_t encerrar_servidor = 0;
+
+static void tratarSinal(int) {
+
+    encerrar_servidor = 1;
+
+}
+
+// Converte o argumento do pedido em um ID positivo.
+static bool lerIdPedido(const std::string& texto, int& id) {
+
+    try {
+
+        size_t lidos = 0;
+        id = std::stoi(texto, &lidos);
+
+        return lidos == texto.size() && id > 0;
+
+    }
+
+    catch (const std::exception& e) {
+
+        return false;
+
+    }
+
+}
+
+// Libera o caminho do socket para o bind. Só remove um socket que sobrou de uma execução
+// anterior: recusa arquivos que não são sockets e sockets com um servidor respondendo.
+static bool liberarCaminhoSocket(const sockaddr_un& endereco) {
+
+    const std::string caminho = endereco.sun_path;
+    struct stat info;
+
+    if (lstat(caminho.c_str(), &info) == -1) {
+
+        if (errno == ENOENT) {
+
+            return true;
+
+        }
+
+        log_error("Não foi possível verificar " + caminho + " (" + std::strerror(errno) + ")");
+
+        return false;
+
+    }
+
+    if (!S_ISSOCK(info.st_mode)) {
+
+        log_error(caminho + " já existe e não é um socket. Escolha outro caminho com --socket.");
+
+        return false;
+
+    }
+
+    int fd_teste = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (fd_teste == -1) {
+
+        log_error("Não foi possível criar o socket (" + std::string(std::strerror(errno)) + ")");
+
+        return false;
+
+    }
+
+    int conectou = connect(fd_teste, reinterpret_cast<const sockaddr*>(&endereco), sizeof(endereco));
+    int erro_conexao = errno;
+
+    close(fd_teste);
+
+    if (conectou == 0) {
+
+        log_error("Já existe um servidor escutando em " + caminho + ".");
+
+        return false;
+
+    }
+
+    if (erro_conexao != ECONNREFUSED) {
+
+        log_error("Não foi possível verificar o socket " + caminho + " (" + std::strerror(erro_conexao) + ")");
+
+        return false;
+
+    }
+
+    // Ninguém escuta: socket abandonado por um servidor que não terminou normalmente
+    log_warn("Removendo socket abandonado: " + caminho);
+
+    return unlink(caminho.c_str()) == 0 || errno == ENOENT;
+
+}
+
+// Remove o socket no encerramento, desde que o caminho ainda seja o socket criado por este
+// processo (outro servidor pode tê-lo substituído depois que este foi removido à mão).
+static void removerSocketProprio(const std::string& caminho, const struct stat& criado) {
+
+    struct stat atual;
+
+    if (lstat(caminho.c_str(), &atual) == 0 && S_ISSOCK(atual.st_mode) && atual.st_dev == criado.st_dev && atual.st_ino == criado.st_ino) {
+
+        unlink(caminho.c_str());
+
+    }
+
+}
+
+/**
+ * @brief Estruturas abertas uma única vez e compartilhadas por todas as conexões.
+ */
+struct BancoAberto {
+
+    GerenciadorArquivoDados& dados;
+    ArquivoHashEstatico& arquivo_hash;
+    IndiceTitulo& indice_titulo;
+
+    std::atomic<long> pedidos{0};
+    std::atomic<long> latencia_total_us{0};
+
+};
+
+// Executa um pedido e devolve a resposta completa (cabeçalho e registros).
+template <typename ArvoreId>
+static std::string responder(ArvoreId& btree_id, BancoAberto& banco, const std::string& pedido) {
+
+    size_t espaco = pedido.find(' ');
+    const std::string comando = pedido.substr(0, espaco);
+    const std::string argumento = (espaco == std::string::npos) ? "" : pedido.substr(espaco + 1);
+
+    ResultadoConsulta resultado;
+    int id = 0;
+
+    auto inicio = std::chrono::steady_clock::now();
+
+    if (comando == "findrec" || comando == "seek1") {
+
+        if (!lerIdPedido(argumento, id)) {
+
+            return "ERRO ID '" + argumento + "' inválido. O ID deve ser um número positivo maior que zero.\n";
+
+        }
+
+        resultado = (comando == "findrec") ? consultarPorHash(banco.arquivo_hash, id) : consultarPorId(btree_id, banco.dados, id);
+
+    }
+
+    else if (comando == "seek2") {
+
+        if (argumento.empty()) {
+
+            return "ERRO O seek2 exige um título.\n";
+
+        }
+
+        resultado = consultarPorTitulo(banco.indice_titulo, banco.dados, argumento);
+
+    }
+
+    else {
+
+        return "ERRO Comando desconhecido: '" + comando + "'. Use findrec, seek1, seek2 ou sair.\n";
+
+    }
+
+    long latencia_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - inicio).count();
+
+    banco.pedidos.fetch_add(1, std::memory_order_relaxed);
+    banco.latencia_total_us.fetch_add(latencia_us, std::memory_order_relaxed);
+
+    LOG_DEBUG(comando + " " + argumento + ": " + std::to_string(resultado.registros.size()) + " registro(s) em " + std::to_string(latencia_us) + " us");
+
+    std::string resposta = "OK " + std::to_string(resultado.registros.size()) + " " + std::to_string(resultado.blocos_indice) + " " + std::to_string(resultado.blocos_dados) + " " + std::to_string(latencia_us) + "\n";
+
+    for (const ArtigoView& artigo : resultado.registros) {
+
+        resposta += artigoParaLinhaTSV(artigo);
+
+    }
+
+    return resposta;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada
+    //#################################################################
+
+    std::string caminho_socket = SOCKET_CONSULTAS_PADRAO;
+    int niveis_cache = NIVEIS_FIXADOS_SERVIDOR;
+    int max_conexoes = MAX_CONEXOES_SERVIDOR;
+
+    for (int i = 1; i < argc; ++i) {
+
+        const std::string arg = argv[i];
+
+        if (arg == "--socket" && i + 1 < argc) {
+
+            caminho_socket = argv[++i];
+
+        }
+
+        else if (arg == "--niveis-cache" && i + 1 < argc) {
+
+            niveis_cache = std::atoi(argv[++i]);
+
+            if (niveis_cache < 0) {
+
+                log_error("Número de níveis inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+        }
+
+        else if (arg == "--max-conexoes" && i + 1 < argc) {
+
+            max_conexoes = std::atoi(argv[++i]);
+
+            if (max_conexoes <= 0) {
+
+                log_error("Número de conexões inválido: " + std::string(argv[i]));
+
+                return 1;
+
+            }
+
+        }
+
+        else {
+
+            log_error("Uso incorreto.");
+            log_error("Uso: " + std::string(argv[0]) + " [--socket <caminho>] [--niveis-cache N] [--max-conexoes N]");
+            log_error("Exemplo Docker: docker compose run --rm servidor");
+
+            return 1;
+
+        }
+
+    }
+
+    //#################################################################
+    // 2. Definição dos caminhos e metadados
+    //#################################################################
+
+    const std::string dataDir = "/data/db";
+    const std::string diretorio_hash_dados = dataDir + "/artigos.dat";
+    const std::string btreeIdPath = dataDir + "/btree_id.idx";
+    const std::string btreeTituloPath = dataDir + "/btree_titulo.idx";
+    const std::string metaDir = dataDir + "/db.meta";
+
+    MetaDados meta;
+
+    if (!lerMetaDados(metaDir, meta)) {
+
+        log_error("Falha fatal ao ler arquivo de metadados (ausente ou corrompido): " + metaDir);
+
+        log_error("Execute o 'upload' primeiro para criar os arquivos de banco de dados.");
+
+        return 1;
+
+    }
+
+    const size_t TAMANHO_BLOCO_LOGICO_DADOS = meta.tamanho_bloco_dados;
+    const size_t TAMANHO_BLOCO_BTREE = meta.tamanho_bloco_btree;
+
+    //#################################################################
+    // 3. Socket Unix
+    //#################################################################
+
+    sockaddr_un endereco;
+    std::memset(&endereco, 0, sizeof(endereco));
+    endereco.sun_family = AF_UNIX;
+
+    if (caminho_socket.size() >= sizeof(endereco.sun_path)) {
+
+        log_error("Caminho do socket longo demais: " + caminho_socket);
+
+        return 1;
+
+    }
+
+    std::strncpy(endereco.sun_path, caminho_socket.c_str(), sizeof(endereco.sun_path) - 1);
+
+    if (!liberarCaminhoSocket(endereco)) {
+
+        return 1;
+
+    }
+
+    int fd_servidor = socket(AF_UNIX, SOCK_STREAM, 0);
+    struct stat socket_criado;
+
+    if (fd_servidor == -1 || bind(fd_servidor, reinterpret_cast<sockaddr*>(&endereco), sizeof(endereco)) == -1) {
+
+        log_error("Não foi possível escutar em " + caminho_socket + " (" + std::strerror(errno) + ")");
+
+        return 1;
+
+    }
+
+    // Identidade do socket criado: no encerramento só ele é removido
+    if (lstat(caminho_socket.c_str(), &socket_criado) == -1 || listen(fd_servidor, 64) == -1) {
+
+        log_error("Não foi possível escutar em " + caminho_socket + " (" + std::strerror(errno) + ")");
+
+        close(fd_servidor);
+        unlink(caminho_socket.c_str());
+
+        return 1;
+
+    }
+
+    std::signal(SIGINT, tratarSinal);
+    std::signal(SIGTERM, tratarSinal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    //#################################################################
+    // 4. Abertura do banco e laço de atendimento
+    //#################################################################
+
+    std::mutex mutex_conexoes;
+    std::condition_variable cv_conexoes;
+    std::set<int> conexoes;
+
+    try {
+
+        GerenciadorArquivoDados gerenciador_dados_hash(diretorio_hash_dados, TAMANHO_BLOCO_LOGICO_DADOS);
+        ArquivoHashEstatico arquivo_hash(gerenciador_dados_hash, NUM_BUCKETS_PRIMARIOS);
+        IndiceTitulo btree_titulo(btreeTituloPath, TAMANHO_BLOCO_BTREE, meta.modo_indice_titulo, meta.indice_titulo_cobertura);
+
+        BancoAberto banco{gerenciador_dados_hash, arquivo_hash, btree_titulo};
+
+        abrirArvoreLeitura<int>(btreeIdPath, TAMANHO_BLOCO_BTREE, [&](auto& btree_id) {
+
+            // Fixa os níveis superiores antes de qualquer leitura concorrente
+            long fixados_id = btree_id.fixarNiveisSuperiores(niveis_cache);
+            long fixados_titulo = btree_titulo.fixarNiveisSuperiores(niveis_cache);
+
+            log_info("--- Servidor de Consultas ---");
+            log_info("Escutando em: " + caminho_socket + " (até " + std::to_string(max_conexoes) + " conexões simultâneas)");
+            log_info("Blocos fixados em memória: " + std::to_string(fixados_id) + " (" + btreeIdPath + "), " + std::to_string(fixados_titulo) + " (" + btreeTituloPath + ")");
+
+            auto atenderConexao = [&](int fd_cliente) {
+
+                ConexaoLinhas conexao(fd_cliente);
+                std::string pedido;
+
+                while (conexao.lerLinha(pedido)) {
+
+                    if (!pedido.empty() && pedido.back() == '\r') {
+
+                        pedido.pop_back();
+
+                    }
+
+                    if (pedido == "sair") {
+
+                        break;
+
+                    }
+
+                    std::string resposta;
+
+                    try {
+
+                        resposta = responder(btree_id, banco, pedido);
+
+                    }
+
+                    catch (const std::exception& e) {
+
+                        resposta = "ERRO " + std::string(e.what()) + "\n";
+
+                    }
+
+                    if (!conexao.enviar(resposta)) {
+
+                        break;
+
+                    }
+
+                }
+
+                std::lock_guard<std::mutex> trava(mutex_conexoes);
+
+                close(fd_cliente);
+                conexoes.erase(fd_cliente);
+                cv_conexoes.notify_all();
+
+            };
+
+            pollfd espera{fd_servidor, POLLIN, 0};
+
+            while (!encerrar_servidor) {
+
+                {
+
+                    // Com todas as threads ocupadas, as novas conexões esperam na fila do listen
+                    std::unique_lock<std::mutex> trava(mutex_conexoes);
+
+                    if (!cv_conexoes.wait_for(trava, std::chrono::milliseconds(200), [&] { return static_cast<int>(conexoes.size()) < max_conexoes; })) {
+
+                        continue;
+
+                    }
+
+                }
+
+                // Acorda periodicamente para perceber SIGINT/SIGTERM
+                if (poll(&espera, 1, 200) <= 0) {
+
+                    continue;
+
+                }
+
+                int fd_cliente = accept(fd_servidor, nullptr, nullptr);
+
+                if (fd_cliente == -1) {
+
+                    continue;
+
+                }
+
+                {
+
+                    std::lock_guard<std::mutex> trava(mutex_conexoes);
+                    conexoes.insert(fd_cliente);
+
+                }
+
+                std::thread(atenderConexao, fd_cliente).detach();
+
+            }
+
+            // Encerramento: acorda as conexões abertas e espera todas terminarem
+            std::unique_lock<std::mutex> trava(mutex_conexoes);
+
+            for (int fd : conexoes) {
+
+                shutdown(fd, SHUT_RDWR);
+
+            }
+
+            cv_conexoes.wait(trava, [&] { return conexoes.empty(); });
+
+        });
+
+        log_info("\n--- Estatísticas do Servidor ---");
+        log_info("Pedidos atendidos: " + std::to_string(banco.pedidos.load()));
+
+        if (banco.pedidos.load() > 0) {
+
+            log_info("Latência média por pedido: " + std::to_string(banco.latencia_total_us.load() / banco.pedidos.load()) + " us");
+
+        }
+
+    }
+
+    catch (const std::exception& e) {
+
+        std::cerr << "Erro Fatal no servidor: " << e.what() << std::endl;
+
+        close(fd_servidor);
+        removerSocketProprio(caminho_socket, socket_criado);
+
+        return 1;
+
+    }
+
+    close(fd_servidor);
+    removerSocketProprio(caminho_socket, socket_criado);
+
+    return 0;
+
+}
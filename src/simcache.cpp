@@ -0,0 +1,342 @@
+// Módulos C++
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <unordered_set>
+#include <algorithm>
+#include <stdexcept>
+
+// Nossos módulos
+#include "Log.hpp"
+#include "RastroBlocos.hpp"
+#include "SimuladorCache.hpp"
+
+/**
+ * @brief Converte "64,256,1024" em tamanhos de cache (em blocos); 'false' se algum for inválido.
+ */
+static bool tamanhosDeString(const std::string& lista, std::vector<size_t>& tamanhos) {
+
+    std::stringstream ss(lista);
+    std::string item;
+
+    tamanhos.clear();
+
+    while (std::getline(ss, item, ',')) {
+
+        try {
+
+            size_t lidos = 0;
+            long long valor = std::stoll(item, &lidos);
+
+            if (lidos != item.size() || valor <= 0) {
+
+                return false;
+
+            }
+
+            tamanhos.push_back(static_cast<size_t>(valor));
+
+        }
+
+        catch (const std::exception&) {
+
+            return false;
+
+        }
+
+    }
+
+    return !tamanhos.empty();
+
+}
+
+/**
+ * @brief Converte "lru,clock,arc" na seleção de políticas; 'false' se algum nome for desconhecido.
+ */
+static bool politicasDeString(const std::string& lista, bool& lru, bool& clock, bool& arc) {
+
+    std::stringstream ss(lista);
+    std::string nome;
+
+    lru = clock = arc = false;
+
+    while (std::getline(ss, nome, ',')) {
+
+        if (nome == "lru") lru = true;
+        else if (nome == "clock") clock = true;
+        else if (nome == "arc") arc = true;
+        else return false;
+
+    }
+
+    return lru || clock || arc;
+
+}
+
+int main(int argc, char* argv[]) {
+
+    log_init();
+
+    //#################################################################
+    // 1. Verificação de entrada.
+    //#################################################################
+
+    std::vector<size_t> tamanhos;
+    bool usar_lru = true, usar_clock = true, usar_arc = true;
+    bool so_leituras = false;
+    std::string filtro_arquivo;
+
+    bool argumentos_validos = (argc >= 2);
+
+    for (int i = 2; i < argc && argumentos_validos; ++i) {
+
+        std::string opcao = argv[i];
+
+        if (opcao == "--so-leituras") {
+
+            so_leituras = true;
+
+        }
+
+        else if (i + 1 >= argc) {
+
+            argumentos_validos = false;
+
+        }
+
+        else if (opcao == "--tamanhos") {
+
+            argumentos_validos = tamanhosDeString(argv[++i], tamanhos);
+
+        }
+
+        else if (opcao == "--politicas") {
+
+            argumentos_validos = politicasDeString(argv[++i], usar_lru, usar_clock, usar_arc);
+
+        }
+
+        else if (opcao == "--arquivo") {
+
+            filtro_arquivo = argv[++i];
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (!argumentos_validos) {
+
+        log_error("Uso incorreto.");
+        log_error("Uso: " + std::string(argv[0]) + " <rastro> [--tamanhos N1,N2,...] [--politicas lru,clock,arc] [--arquivo trecho_do_nome] [--so-leituras]");
+        log_error("Comando esperado: RASTRO_BLOCOS=rastro.bin docker compose run --rm seek1 123 && docker compose run --rm simcache rastro.bin");
+        return 1;
+
+    }
+
+    std::string caminho_rastro = argv[1];
+
+    if (caminho_rastro[0] != '/') {
+
+        caminho_rastro = "/data/" + caminho_rastro;
+
+    }
+
+    //#################################################################
+    // 2. Leitura do rastro.
+    //#################################################################
+
+    // Um mesmo arquivo pode ser aberto mais de uma vez (cada abertura é uma declaração):
+    // as chaves usam um índice por nome.
+    std::map<std::string, uint16_t> indice_por_nome;
+    std::vector<uint16_t> canonico;           // declaração -> índice por nome
+    std::vector<std::string> nomes;
+    std::vector<uint32_t> tamanhos_bloco;
+    std::vector<size_t> acessos_por_arquivo;
+    std::vector<std::unordered_set<uint32_t>> distintos_por_arquivo;
+
+    std::vector<uint64_t> acessos;
+    size_t leituras = 0, escritas = 0;
+    uint64_t ultimo_tempo_ns = 0;
+
+    try {
+
+        LeitorRastro leitor(caminho_rastro);
+        RegistroRastro registro;
+
+        while (leitor.proximo(registro)) {
+
+            const std::vector<ArquivoRastro>& arquivos = leitor.getArquivos();
+
+            while (canonico.size() < arquivos.size()) {
+
+                const ArquivoRastro& arquivo = arquivos[canonico.size()];
+                auto [it, novo] = indice_por_nome.emplace(arquivo.nome, static_cast<uint16_t>(nomes.size()));
+
+                if (novo) {
+
+                    nomes.push_back(arquivo.nome);
+                    tamanhos_bloco.push_back(arquivo.tamanho_bloco);
+                    acessos_por_arquivo.push_back(0);
+                    distintos_por_arquivo.emplace_back();
+
+                }
+
+                canonico.push_back(it->second);
+
+            }
+
+            ultimo_tempo_ns = registro.tempo_ns;
+
+            if (registro.arquivo >= canonico.size()) {
+
+                continue;
+
+            }
+
+            uint16_t arquivo = canonico[registro.arquivo];
+
+            if (!filtro_arquivo.empty() && nomes[arquivo].find(filtro_arquivo) == std::string::npos) {
+
+                continue;
+
+            }
+
+            if (registro.tipo == static_cast<uint8_t>(TipoAcessoBloco::ESCRITA)) {
+
+                ++escritas;
+
+                if (so_leituras) {
+
+                    continue;
+
+                }
+
+            }
+
+            else {
+
+                ++leituras;
+
+            }
+
+            acessos_por_arquivo[arquivo]++;
+            distintos_por_arquivo[arquivo].insert(registro.bloco);
+            acessos.push_back((static_cast<uint64_t>(arquivo) << 32) | registro.bloco);
+
+        }
+
+    }
+
+    catch (const std::exception& e) {
+
+        log_error(e.what());
+        return 1;
+
+    }
+
+    if (acessos.empty()) {
+
+        log_error("Nenhum acesso a simular em " + caminho_rastro + ".");
+        return 1;
+
+    }
+
+    //#################################################################
+    // 3. Resumo: conjunto de trabalho por arquivo.
+    //#################################################################
+
+    size_t distintos = 0;
+    double bytes_distintos = 0.0;
+
+    log_info("--- Rastro " + caminho_rastro + " ---");
+    log_info("Acessos: " + std::to_string(acessos.size()) + " (leituras: " + std::to_string(leituras) + ", escritas: " +
+             std::to_string(escritas) + (so_leituras ? ", ignoradas" : "") + ") em " + std::to_string(ultimo_tempo_ns / 1e9) + " s");
+
+    for (size_t a = 0; a < nomes.size(); ++a) {
+
+        if (acessos_por_arquivo[a] == 0) {
+
+            continue;
+
+        }
+
+        size_t blocos = distintos_por_arquivo[a].size();
+        double mb = blocos * static_cast<double>(tamanhos_bloco[a]) / (1024.0 * 1024.0);
+
+        distintos += blocos;
+        bytes_distintos += blocos * static_cast<double>(tamanhos_bloco[a]);
+
+        std::ostringstream linha;
+        linha << "  - " << nomes[a] << ": " << acessos_por_arquivo[a] << " acessos, " << blocos << " blocos distintos ("
+              << std::fixed << std::setprecision(1) << mb << " MB)";
+        log_info(linha.str());
+
+    }
+
+    // Tamanho médio dos blocos acessados, para converter blocos de cache em MB
+    double bytes_por_bloco = bytes_distintos / distintos;
+
+    std::ostringstream resumo;
+    resumo << "Conjunto de trabalho: " << distintos << " blocos (" << std::fixed << std::setprecision(1)
+           << bytes_distintos / (1024.0 * 1024.0) << " MB); acerto maximo (cache infinita): " << std::setprecision(2)
+           << 100.0 * (acessos.size() - distintos) / acessos.size() << "%";
+    log_info(resumo.str());
+
+    if (tamanhos.empty()) {
+
+        // Potências de 2 até cobrir o conjunto de trabalho
+        for (size_t tamanho = 16; ; tamanho *= 2) {
+
+            tamanhos.push_back(std::min(tamanho, distintos));
+
+            if (tamanho >= distintos) {
+
+                break;
+
+            }
+
+        }
+
+    }
+
+    //#################################################################
+    // 4. Curvas de acerto.
+    //#################################################################
+
+    log_flush();
+
+    std::cout << std::setw(10) << "blocos" << std::setw(10) << "MB";
+
+    if (usar_lru) std::cout << std::setw(9) << "lru%";
+    if (usar_clock) std::cout << std::setw(9) << "clock%";
+    if (usar_arc) std::cout << std::setw(9) << "arc%";
+
+    std::cout << "\n";
+
+    for (size_t tamanho : tamanhos) {
+
+        double total = static_cast<double>(acessos.size());
+
+        std::cout << std::setw(10) << tamanho << std::setw(10) << std::fixed << std::setprecision(1)
+                  << tamanho * bytes_por_bloco / (1024.0 * 1024.0) << std::setprecision(2);
+
+        if (usar_lru) std::cout << std::setw(9) << 100.0 * simularCache<CacheLRU>(acessos, tamanho) / total;
+        if (usar_clock) std::cout << std::setw(9) << 100.0 * simularCache<CacheCLOCK>(acessos, tamanho) / total;
+        if (usar_arc) std::cout << std::setw(9) << 100.0 * simularCache<CacheARC>(acessos, tamanho) / total;
+
+        std::cout << "\n";
+
+    }
+
+    return 0;
+
+}
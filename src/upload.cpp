@@ -1,10 +1,13 @@
 // Módulos C++
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <fstream>
 #include <chrono>
 #include <vector>
 #include <filesystem>
+#include <memory>
 
 // Nossos módulos
 #include "Log.hpp"
@@ -15,6 +18,11 @@
 #include "BlocoDeDados.hpp"
 #include "ArquivoHashEstatico.hpp"
 #include "ArvoreBMais.hpp"
+#include "IndiceTitulo.hpp"
+#include "MetaDados.hpp"
+#include "EstatisticasCarga.hpp"
+#include "Colunas.hpp"
+#include "IndiceAutores.hpp"
 
 int main(int argc, char* argv[]) {
 
@@ -24,10 +32,108 @@ int main(int argc, char* argv[]) {
     // 1. Verificação de entrada.
     //#################################################################
     
-    if (argc != 2) {
+    ModoIndiceTitulo modo_indice_titulo = ModoIndiceTitulo::COMPACTO;
+    bool indice_titulo_cobertura = false;
+    bool indice_ano = false;
+    bool indice_autores = false;
+    bool colunas = false;
+    bool colunas_atualizacao = false;
+    std::string arquivo_stats_json;
+    double fator_divisao = FATOR_DIVISAO_DIREITA_PADRAO;
+
+    bool argumentos_validos = (argc >= 2);
+
+    for (int i = 2; i < argc && argumentos_validos; ++i) {
+
+        std::string opcao = argv[i];
+
+        if (opcao == "--indice-titulo" && i + 1 < argc) {
+
+            argumentos_validos = modoIndiceTituloDeString(argv[++i], modo_indice_titulo);
+
+        }
+
+        else if (opcao == "--indice-titulo-cobertura") {
+
+            indice_titulo_cobertura = true;
+
+        }
+
+        else if (opcao == "--indice-ano") {
+
+            indice_ano = true;
+
+        }
+
+        else if (opcao == "--indice-autores") {
+
+            indice_autores = true;
+
+        }
+
+        else if (opcao == "--colunas") {
+
+            colunas = true;
+
+        }
+
+        else if (opcao == "--colunas-atualizacao") {
+
+            colunas = true;
+            colunas_atualizacao = true;
+
+        }
+
+        else if (opcao == "--stats-json" && i + 1 < argc) {
+
+            arquivo_stats_json = argv[++i];
+
+        }
+
+        else if (opcao == "--fator-divisao" && i + 1 < argc) {
+
+            const std::string texto = argv[++i];
+            size_t consumidos = 0;
+
+            try {
+
+                fator_divisao = std::stod(texto, &consumidos);
+
+            } catch (const std::exception&) {
+
+                consumidos = 0;
+
+            }
+
+            if (consumidos != texto.size() || fator_divisao < 0.5 || fator_divisao > 1.0) {
+
+                log_error("Fator de divisao '" + texto + "' invalido. Deve estar entre 0.5 e 1.0.");
+                argumentos_validos = false;
+
+            }
+
+        }
+
+        else {
+
+            argumentos_validos = false;
+
+        }
+
+    }
+
+    if (argumentos_validos && indice_titulo_cobertura && modo_indice_titulo != ModoIndiceTitulo::COMPACTO) {
+
+        log_error("A opcao --indice-titulo-cobertura exige o indice de titulos no modo compacto.");
+
+        return 1;
+
+    }
+
+    if (!argumentos_validos) {
     
         log_error("Uso incorreto.");
-        log_error("Uso: " + std::string(argv[0]) + " <caminho_para_o_arquivo_csv>");
+        log_error("Uso: " + std::string(argv[0]) + " <caminho_para_o_arquivo_csv> [--indice-titulo compacto|hash] [--indice-titulo-cobertura] [--indice-ano] [--indice-autores] [--colunas] [--colunas-atualizacao] [--stats-json <arquivo>] [--fator-divisao <0.5-1.0>]");
         log_error("Comando esperado: docker compose run --rm upload arquivo_entrada.csv");
         return 1;
     
@@ -45,6 +151,16 @@ int main(int argc, char* argv[]) {
     const std::string diretorio_hash = dataDir + "/artigos.dat";
     const std::string btreeIdPath = dataDir + "/btree_id.idx";
     const std::string btreeTituloPath = dataDir + "/btree_titulo.idx";
+    const std::string btreeAnoPath = dataDir + "/btree_ano.idx";
+    const std::string autoresPath = dataDir + "/autores.idx";
+    const std::string colunasDir = dataDir + "/colunas";
+
+    // Relativo como o CSV: fica em /data, visível fora do contêiner
+    if (!arquivo_stats_json.empty() && arquivo_stats_json[0] != '/') {
+
+        arquivo_stats_json = "/data/" + arquivo_stats_json;
+
+    }
 
     //#################################################################
     // 3. Iniciar medição de tempo e logs.
@@ -52,24 +168,45 @@ int main(int argc, char* argv[]) {
     
     auto startTime = std::chrono::high_resolution_clock::now();
     
-    log_info("--- Iniciando Carga de Dados (Upload) ---");
-    log_info("Arquivo CSV de entrada: " + diretorio_csv);
-    log_info("Arquivos de saída:");
-    log_info("  - Dados (Hash): " + diretorio_hash);
-    log_info("  - Índice Primário (B+Tree ID): " + btreeIdPath);
-    log_info("  - Índice Secundário (B+Tree Título): " + btreeTituloPath);
+    LOG_INFO("--- Iniciando Carga de Dados (Upload) ---");
+    LOG_INFO("Arquivo CSV de entrada: " + diretorio_csv);
+    LOG_INFO("Arquivos de saída:");
+    LOG_INFO("  - Dados (Hash): " + diretorio_hash);
+    LOG_INFO("  - Índice Primário (B+Tree ID): " + btreeIdPath + " (fator de divisão " + std::to_string(fator_divisao) + ")");
+    LOG_INFO("  - Índice Secundário (B+Tree Título): " + btreeTituloPath + " (modo " + modoIndiceTituloParaString(modo_indice_titulo) + (indice_titulo_cobertura ? ", com id/ano/citacoes" : "") + ")");
+
+    if (indice_ano) {
+
+        LOG_INFO("  - Índice por Ano (B+Tree ano, citacoes DESC, id): " + btreeAnoPath);
+
+    }
+
+    if (indice_autores) {
+
+        LOG_INFO("  - Índice de Autores (dicionário + listas de registros): " + autoresPath);
+
+    }
+
+    if (colunas) {
+
+        LOG_INFO("  - Colunas (id, ano, citacoes, bucket" + std::string(colunas_atualizacao ? ", atualizacao" : "") + "): " + colunasDir);
+
+    }
     
-    if (std::filesystem::exists(diretorio_hash) || std::filesystem::exists(btreeIdPath) || std::filesystem::exists(btreeTituloPath)) {
+    if (std::filesystem::exists(diretorio_hash) || std::filesystem::exists(btreeIdPath) || std::filesystem::exists(btreeTituloPath) || std::filesystem::exists(btreeAnoPath) || std::filesystem::exists(autoresPath) || std::filesystem::exists(colunasDir)) {
         
-        log_info("\nIniciando limpeza de arquivos de banco de dados antigos...");
+        LOG_INFO("\nIniciando limpeza de arquivos de banco de dados antigos...");
         
         try {
             
             std::filesystem::remove(diretorio_hash);
             std::filesystem::remove(btreeIdPath);
             std::filesystem::remove(btreeTituloPath);
+            std::filesystem::remove(btreeAnoPath);
+            std::filesystem::remove(autoresPath);
+            std::filesystem::remove_all(colunasDir);
             
-            log_info("Arquivos anteriores removidos com sucesso.");
+            LOG_INFO("Arquivos anteriores removidos com sucesso.");
 
         } 
         
@@ -98,11 +235,11 @@ int main(int argc, char* argv[]) {
     const size_t TAMANHO_BLOCO_BTREE = static_cast<size_t>(tamanho_bloco_os);
 
     // Logs
-    log_debug("Tamanho do bloco do S.O. em /data: " + std::to_string(tamanho_bloco_os) + " bytes.");
-    log_debug("Tamanho de cada registro (sizeof(Artigo)): " + std::to_string(sizeof(Artigo)) + " bytes.");
-    log_debug("Registros por Bloco Lógico (definido): " + std::to_string(CAPACIDADE_BUCKET));
-    log_debug("Tamanho Bruto do Bucket (sizeof(BlocoDeDados)): " + std::to_string(TAMANHO_BRUTO_BUCKET) + " bytes.");
-    log_debug("Tamanho Lógico do Bloco de Dados Hash (arredondado): " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS) + " bytes.");
+    LOG_DEBUG("Tamanho do bloco do S.O. em /data: " + std::to_string(tamanho_bloco_os) + " bytes.");
+    LOG_DEBUG("Tamanho de cada registro (sizeof(Artigo)): " + std::to_string(sizeof(Artigo)) + " bytes.");
+    LOG_DEBUG("Registros por Bloco Lógico (definido): " + std::to_string(CAPACIDADE_BUCKET));
+    LOG_DEBUG("Tamanho Bruto do Bucket (sizeof(BlocoDeDados)): " + std::to_string(TAMANHO_BRUTO_BUCKET) + " bytes.");
+    LOG_DEBUG("Tamanho Lógico do Bloco de Dados Hash (arredondado): " + std::to_string(TAMANHO_BLOCO_LOGICO_DADOS) + " bytes.");
 
     try {
     
@@ -118,39 +255,78 @@ int main(int argc, char* argv[]) {
     
     }
     
-    log_info("Salvando metadados de bloco em: " + metaDir);
+    LOG_INFO("Salvando metadados de bloco em: " + metaDir);
+
+    // Salva o tamanho do bloco de dados e de indice usado no upload e o formato do índice de títulos
+    MetaDados meta_dados;
+    meta_dados.tamanho_bloco_dados = TAMANHO_BLOCO_LOGICO_DADOS;
+    meta_dados.tamanho_bloco_btree = TAMANHO_BLOCO_BTREE;
+    meta_dados.modo_indice_titulo = modo_indice_titulo;
+    meta_dados.indice_titulo_cobertura = indice_titulo_cobertura;
+    meta_dados.indice_ano = indice_ano;
+    meta_dados.indice_autores = indice_autores;
+    meta_dados.colunas = colunas;
+    meta_dados.colunas_atualizacao = colunas_atualizacao;
 
-    std::ofstream meta_dados(metaDir, std::ios::binary | std::ios::trunc);
-    if (!meta_dados.is_open()) {
+    if (!escreverMetaDados(metaDir, meta_dados)) {
 
         log_error("Falha fatal ao criar arquivo de metadados: " + metaDir);
         
         return 1;
     
     }
-    
-    // Salva o tamanho do bloco de dados e de indice usado no upload
-    meta_dados.write(reinterpret_cast<const char*>(&TAMANHO_BLOCO_LOGICO_DADOS), sizeof(size_t));
-    meta_dados.write(reinterpret_cast<const char*>(&TAMANHO_BLOCO_BTREE), sizeof(size_t));
-    
-    meta_dados.close();
 
     //#################################################################
     // 5. Inicializar Gerenciadores de Arquivos e Estruturas de Dados.
     //#################################################################
 
+    EstatisticasCarga estatisticas;
+    long contador_erros_insercao = 0;
+
     try {
 
+        estatisticas.reiniciarMarca();
+
         GerenciadorArquivoDados gerenciador_dados_hash(diretorio_hash, TAMANHO_BLOCO_LOGICO_DADOS);
         ArquivoHashEstatico arquivo_hash(gerenciador_dados_hash, NUM_BUCKETS_PRIMARIOS);
 
         arquivo_hash.inicializar();
 
-        log_info("Inicializando Índice Primário (B+Tree ID)...");
+        LOG_INFO("Inicializando Índice Primário (B+Tree ID)...");
         BPlusTree<int> btree_id(btreeIdPath, static_cast<size_t>(TAMANHO_BLOCO_BTREE));
+        btree_id.setFatorDivisaoDireita(fator_divisao);
+
+        LOG_INFO("Inicializando Índice Secundário (B+Tree Título)...");
+        IndiceTitulo btree_titulo(btreeTituloPath, static_cast<size_t>(TAMANHO_BLOCO_BTREE), modo_indice_titulo, indice_titulo_cobertura);
+
+        std::unique_ptr<BPlusTree<ChaveAnoCitacoes>> btree_ano;
+
+        if (indice_ano) {
+
+            LOG_INFO("Inicializando Índice por Ano (B+Tree ano/citações)...");
+            btree_ano.reset(new BPlusTree<ChaveAnoCitacoes>(btreeAnoPath, static_cast<size_t>(TAMANHO_BLOCO_BTREE)));
+
+        }
 
-        log_info("Inicializando Índice Secundário (B+Tree Título)...");
-        BPlusTree<ChaveTitulo> btree_titulo(btreeTituloPath, static_cast<size_t>(TAMANHO_BLOCO_BTREE));
+        // Fica em memória até o fim da carga: as listas só são gravadas depois de ordenadas
+        std::unique_ptr<ConstrutorIndiceAutores> construtor_autores;
+
+        if (indice_autores) {
+
+            construtor_autores.reset(new ConstrutorIndiceAutores());
+
+        }
+
+        std::unique_ptr<EscritorColunas> escritor_colunas;
+
+        if (colunas) {
+
+            LOG_INFO("Inicializando Colunas...");
+            escritor_colunas.reset(new EscritorColunas(colunasDir, colunas_atualizacao));
+
+        }
+
+        estatisticas.marcar(FaseCarga::INICIALIZACAO);
 
     //#################################################################
     // 6. Abrir e processar o arquivo CSV.
@@ -171,10 +347,16 @@ int main(int argc, char* argv[]) {
         long contador_linhas_processadas = 0;
         long contador_linhas_ignoradas = 0;
         
-        log_info("Processando registros...");
+        LOG_INFO("Processando registros...");
+
+        // Cada marcar() fecha a fase que acabou de rodar (ver EstatisticasCarga)
+        estatisticas.iniciarIntervalo();
+        estatisticas.reiniciarMarca();
 
         while (std::getline(arquivo_entrada, linha)) {
 
+            estatisticas.marcar(FaseCarga::LEITURA_CSV);
+
             if (linha.empty()) { 
                 
                 continue; 
@@ -182,24 +364,53 @@ int main(int argc, char* argv[]) {
             }
             
             Artigo artigo;
+            bool linha_valida = parseCSVLinha(linha, artigo);
+
+            estatisticas.marcar(FaseCarga::PARSE);
             
-            if (parseCSVLinha(linha, artigo)) {
+            if (linha_valida) {
             
                 try {
 
-                    size_t id_bloco_inserido = arquivo_hash.inserir(artigo);
+                    size_t posicao_no_bloco = 0;
+                    size_t id_bloco_inserido = arquivo_hash.inserir(artigo, &posicao_no_bloco);
+                    estatisticas.marcar(FaseCarga::HASH);
+
                     btree_id.insert(artigo.id, id_bloco_inserido);
+                    estatisticas.marcar(FaseCarga::INDICE_ID);
 
-                    ChaveTitulo chave_titulo;
-                    strncpy(chave_titulo.titulo, artigo.titulo, 300);
-                    
-                    btree_titulo.insert(chave_titulo, id_bloco_inserido);
+                    CamposIncluidos campos_incluidos = { artigo.id, artigo.ano, artigo.citacoes };
+                    btree_titulo.insert(std::string(artigo.titulo), id_bloco_inserido, &campos_incluidos);
+                    estatisticas.marcar(FaseCarga::INDICE_TITULO);
+
+                    if (btree_ano) {
+
+                        btree_ano->insert(ChaveAnoCitacoes(artigo.ano, artigo.citacoes, artigo.id), id_bloco_inserido);
+                        estatisticas.marcar(FaseCarga::INDICE_ANO);
+
+                    }
+
+                    if (construtor_autores) {
+
+                        construtor_autores->acrescentar(std::string_view(artigo.autores, strnlen(artigo.autores, sizeof(artigo.autores))),
+                                                        localRegistro(id_bloco_inserido, posicao_no_bloco));
+                        estatisticas.marcar(FaseCarga::INDICE_AUTORES);
+
+                    }
+
+                    if (escritor_colunas) {
+
+                        escritor_colunas->acrescentar(artigo, id_bloco_inserido);
+                        estatisticas.marcar(FaseCarga::COLUNAS);
+
+                    }
 
                 }
                 
                 catch (const std::exception& e) {
                 
-                    log_warn("Erro ao inserir artigo ID " + std::to_string(artigo.id) + ": " + std::string(e.what()));
+                    LOG_WARN_LIMITADO("[Upload] Erros ao inserir artigos", "Erro ao inserir artigo ID " + std::to_string(artigo.id) + ": " + std::string(e.what()));
+                    contador_erros_insercao++;
                 
                 }
                 
@@ -207,20 +418,38 @@ int main(int argc, char* argv[]) {
 
                 if (contador_linhas_processadas % checkpoint_intervalo == 0) {
                     
-                    log_info("  ... " + std::to_string(contador_linhas_processadas) + " registros processados. Sincronizando...");
+                    LOG_INFO("  ... " + std::to_string(contador_linhas_processadas) + " registros processados. Sincronizando...");
+                    estatisticas.marcar(FaseCarga::OUTROS);
                     
                     gerenciador_dados_hash.flushCheckpoint();
+                    estatisticas.marcar(FaseCarga::CHECKPOINT_DADOS);
                     
                     btree_id.flush();
                     btree_titulo.flush();
+
+                    if (btree_ano) {
+
+                        btree_ano->flush();
+
+                    }
+
+                    if (escritor_colunas) {
+
+                        escritor_colunas->sincronizar();
+
+                    }
+
+                    estatisticas.marcar(FaseCarga::CHECKPOINT_INDICES);
+
+                    const IntervaloCarga& intervalo = estatisticas.fecharIntervalo(contador_linhas_processadas);
                     
-                    log_info("  ... Sincronização concluída.");
+                    LOG_INFO("  ... Sincronização concluída (" + std::to_string(static_cast<long>(intervalo.registros_por_s)) + " registros/s no intervalo).");
                 
                 }
                 
                 if (contador_linhas_processadas % 10000 == 0) {
                 
-                    log_info("  ... " + std::to_string(contador_linhas_processadas) + " registros processados.");
+                    LOG_INFO("  ... " + std::to_string(contador_linhas_processadas) + " registros processados.");
                 
                 }
                 
@@ -231,12 +460,48 @@ int main(int argc, char* argv[]) {
                 contador_linhas_ignoradas++;
             
             }
+
+            estatisticas.marcar(FaseCarga::OUTROS);
         
         }
         
         arquivo_entrada.close();
         
-        log_info("Leitura do CSV concluída.");
+        LOG_INFO("Leitura do CSV concluída.");
+
+        // Checkpoint final dentro da medição (antes ficava para os destrutores, fora do tempo total)
+        gerenciador_dados_hash.flushCheckpoint();
+        estatisticas.marcar(FaseCarga::CHECKPOINT_DADOS);
+
+        btree_id.flush();
+        btree_titulo.flush();
+
+        if (btree_ano) {
+
+            btree_ano->flush();
+
+        }
+
+        if (escritor_colunas) {
+
+            escritor_colunas->sincronizar();
+
+        }
+
+        estatisticas.marcar(FaseCarga::CHECKPOINT_INDICES);
+
+        if (construtor_autores) {
+
+            construtor_autores->gravar(autoresPath);
+            estatisticas.marcar(FaseCarga::INDICE_AUTORES);
+
+        }
+
+        if (contador_linhas_processadas % checkpoint_intervalo != 0 || contador_linhas_processadas == 0) {
+
+            estatisticas.fecharIntervalo(contador_linhas_processadas);
+
+        }
 
     //#################################################################
     // 9. Finalizar medição e imprimir relatório.
@@ -245,29 +510,106 @@ int main(int argc, char* argv[]) {
         auto endTime = std::chrono::high_resolution_clock::now();
         long duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime).count();
 
-        log_info("\n--- Carga de Dados Concluída ---");
-        log_info("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
-        log_info("Total de registros processados (inseridos): " + std::to_string(contador_linhas_processadas));
-        log_info("Total de linhas ignoradas (mal formatadas): " + std::to_string(contador_linhas_ignoradas));
+        LOG_INFO("\n--- Carga de Dados Concluída ---");
+        LOG_INFO("Tempo total de execução: " + std::to_string(duration_ms) + " ms");
+        LOG_INFO("Total de registros processados (inseridos): " + std::to_string(contador_linhas_processadas));
+        LOG_INFO("Total de linhas ignoradas (mal formatadas): " + std::to_string(contador_linhas_ignoradas));
+
+        if (contador_erros_insercao > 0) {
+
+            LOG_INFO("Total de erros de inserção: " + std::to_string(contador_erros_insercao));
+
+        }
+
+        estatisticas.relatar();
         
     //#################################################################
     // 10. Imprimir estatísticas de blocos.
     //#################################################################
     
-        log_info("\nEstatísticas de I/O (Hash - Dados): " + diretorio_hash);
-        log_info("  - Blocos lidos: " + std::to_string(gerenciador_dados_hash.obterBlocosLidos()));
-        log_info("  - Blocos escritos: " + std::to_string(gerenciador_dados_hash.obterBlocosEscritos()));
-        log_info("  - Total de blocos no arquivo: " + std::to_string(gerenciador_dados_hash.obterNumeroTotalBlocos()));
-
-        log_info("\nEstatísticas de I/O (B+Tree - ID): " + btreeIdPath);
-        log_info("  - Blocos lidos: " + std::to_string(btree_id.getIndexBlocosLidos()));
-        log_info("  - Blocos escritos: " + std::to_string(btree_id.getIndexBlocosEscritos()));
-        log_info("  - Total de blocos no arquivo: " + std::to_string(btree_id.getIndexTotalBlocos()));
-
-        log_info("\nEstatísticas de I/O (B+Tree - Título): " + btreeTituloPath);
-        log_info("  - Blocos lidos: " + std::to_string(btree_titulo.getIndexBlocosLidos()));
-        log_info("  - Blocos escritos: " + std::to_string(btree_titulo.getIndexBlocosEscritos()));
-        log_info("  - Total de blocos no arquivo: " + std::to_string(btree_titulo.getIndexTotalBlocos()));
+        LOG_INFO("\nEstatísticas de I/O (Hash - Dados): " + diretorio_hash);
+        LOG_INFO("  - Blocos lidos: " + std::to_string(gerenciador_dados_hash.obterBlocosLidos()));
+        LOG_INFO("  - Blocos escritos: " + std::to_string(gerenciador_dados_hash.obterBlocosEscritos()));
+        LOG_INFO("  - Total de blocos no arquivo: " + std::to_string(gerenciador_dados_hash.obterNumeroTotalBlocos()));
+        estatisticas.registrarArquivo({"dados", diretorio_hash, gerenciador_dados_hash.obterBlocosLidos(), gerenciador_dados_hash.obterBlocosEscritos(), static_cast<long>(gerenciador_dados_hash.obterNumeroTotalBlocos())});
+
+        LOG_INFO("\nEstatísticas de I/O (B+Tree - ID): " + btreeIdPath);
+        LOG_INFO("  - Blocos lidos: " + std::to_string(btree_id.getIndexBlocosLidos()));
+        LOG_INFO("  - Blocos escritos: " + std::to_string(btree_id.getIndexBlocosEscritos()));
+        LOG_INFO("  - Total de blocos no arquivo: " + std::to_string(btree_id.getIndexTotalBlocos()));
+        estatisticas.registrarArquivo({"indice_id", btreeIdPath, btree_id.getIndexBlocosLidos(), btree_id.getIndexBlocosEscritos(), btree_id.getIndexTotalBlocos()});
+
+        LOG_INFO("\nEstatísticas de I/O (B+Tree - Título): " + btreeTituloPath);
+        LOG_INFO("  - Blocos lidos: " + std::to_string(btree_titulo.getIndexBlocosLidos()));
+        LOG_INFO("  - Blocos escritos: " + std::to_string(btree_titulo.getIndexBlocosEscritos()));
+        LOG_INFO("  - Total de blocos no arquivo: " + std::to_string(btree_titulo.getIndexTotalBlocos()));
+        estatisticas.registrarArquivo({"indice_titulo", btreeTituloPath, btree_titulo.getIndexBlocosLidos(), btree_titulo.getIndexBlocosEscritos(), btree_titulo.getIndexTotalBlocos()});
+
+        if (btree_ano) {
+
+            LOG_INFO("\nEstatísticas de I/O (B+Tree - Ano/Citações): " + btreeAnoPath);
+            LOG_INFO("  - Blocos lidos: " + std::to_string(btree_ano->getIndexBlocosLidos()));
+            LOG_INFO("  - Blocos escritos: " + std::to_string(btree_ano->getIndexBlocosEscritos()));
+            LOG_INFO("  - Total de blocos no arquivo: " + std::to_string(btree_ano->getIndexTotalBlocos()));
+            estatisticas.registrarArquivo({"indice_ano", btreeAnoPath, btree_ano->getIndexBlocosLidos(), btree_ano->getIndexBlocosEscritos(), btree_ano->getIndexTotalBlocos()});
+
+        }
+
+        if (construtor_autores) {
+
+            LOG_INFO("\nÍndice de Autores: " + autoresPath);
+            LOG_INFO("  - Autores distintos: " + std::to_string(construtor_autores->getNumAutores()));
+            LOG_INFO("  - Entradas nas listas: " + std::to_string(construtor_autores->getNumLocais()));
+            LOG_INFO("  - Bytes: " + std::to_string(std::filesystem::file_size(autoresPath)));
+
+        }
+
+        if (escritor_colunas) {
+
+            LOG_INFO("\nColunas: " + colunasDir);
+            LOG_INFO("  - Linhas: " + std::to_string(escritor_colunas->getLinhas()));
+            LOG_INFO("  - Bytes: " + std::to_string(escritor_colunas->getBytes()));
+
+        }
+
+    //#################################################################
+    // 11. Estatísticas em JSON (--stats-json).
+    //#################################################################
+
+        if (!arquivo_stats_json.empty()) {
+
+            ResumoCarga resumo;
+            resumo.csv = diretorio_csv;
+            resumo.modo_indice_titulo = modoIndiceTituloParaString(modo_indice_titulo);
+            resumo.indice_titulo_cobertura = indice_titulo_cobertura;
+            resumo.indice_ano = indice_ano;
+            resumo.indice_autores = indice_autores;
+            resumo.colunas = colunas;
+            resumo.colunas_atualizacao = colunas_atualizacao;
+            resumo.tamanho_bloco_so = tamanho_bloco_os;
+            resumo.tamanho_bloco_dados = TAMANHO_BLOCO_LOGICO_DADOS;
+            resumo.tamanho_bloco_btree = TAMANHO_BLOCO_BTREE;
+            resumo.duracao_ms = duration_ms;
+            resumo.registros_inseridos = contador_linhas_processadas;
+            resumo.linhas_ignoradas = contador_linhas_ignoradas;
+            resumo.erros_insercao = contador_erros_insercao;
+
+            std::ofstream arquivo_json(arquivo_stats_json);
+
+            if (!arquivo_json.is_open()) {
+
+                log_warn("Nao foi possivel gravar as estatisticas em " + arquivo_stats_json);
+
+            }
+
+            else {
+
+                estatisticas.escreverJSON(arquivo_json, resumo);
+                LOG_INFO("\nEstatísticas gravadas em: " + arquivo_stats_json);
+
+            }
+
+        }
 
     } 
     